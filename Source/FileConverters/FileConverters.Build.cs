@@ -38,7 +38,10 @@ public class FileConverters : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
-				"GLTFExporter"
+				"GLTFExporter",
+				"Json",
+				"Projects",
+				"RHI"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -50,5 +53,17 @@ public class FileConverters : ModuleRules
 				// ... add any modules that your module loads dynamically here ...
 			}
 			);
+
+		// Directory watcher is a developer module. Without it, folder watching reports failure and caches rely on timestamps.
+		if (Target.bBuildDeveloperTools)
+		{
+			PrivateIncludePathModuleNames.Add("DirectoryWatcher");
+			DynamicallyLoadedModuleNames.Add("DirectoryWatcher");
+			PrivateDefinitions.Add("WITH_FILECONVERTERS_DIRECTORY_WATCHER=1");
+		}
+		else
+		{
+			PrivateDefinitions.Add("WITH_FILECONVERTERS_DIRECTORY_WATCHER=0");
+		}
 	}
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "FileConverters.h"
+#include "FileConvertersExportQueue.h"
+#include "FileConvertersIFC.h"
+#include "FileConvertersWatcher.h"
 
 #define LOCTEXT_NAMESPACE "FFileConvertersModule"
 
+DEFINE_LOG_CATEGORY(LogFileConverters);
+
 void FFileConvertersModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -15,6 +20,9 @@ void FFileConvertersModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	
+	FFileConvertersWatcher::Get().Shutdown();
+	FFileConvertersExportQueue::Get().Shutdown();
+	FFileConvertersIFCPool::Get().Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,517 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersAssets.h"
+#include "FileConverters.h"
+
+// UE Includes.
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <string.h>
+
+namespace FileConvertersAssets
+{
+    // Entry slots of the LRU. Real limit is the byte budget.
+    static constexpr int32 MaxCachedEntries = 4096;
+
+    static FAutoConsoleCommand AssetCacheStatsCommand(
+        TEXT("FileConverters.AssetCache.Stats"),
+        TEXT("Logs entry count, memory usage, hits, misses and evictions of additional asset cache."),
+        FConsoleCommandDelegate::CreateLambda([]()
+            {
+                const FAssetCacheStats Stats = FFileConvertersContentCache::Get().GetStats();
+                UE_LOG(LogFileConverters, Display, TEXT("Asset cache: %d entries, %lld / %lld bytes, %lld hits, %lld misses, %lld invalidations, %lld evictions."), Stats.EntryCount, Stats.UsedBytes, Stats.BudgetBytes, Stats.HitCount, Stats.MissCount, Stats.InvalidationCount, Stats.EvictionCount);
+            }
+        )
+    );
+
+    static FAutoConsoleCommand AssetCacheClearCommand(
+        TEXT("FileConverters.AssetCache.Clear"),
+        TEXT("Drops all cached additional asset contents."),
+        FConsoleCommandDelegate::CreateLambda([]()
+            {
+                FFileConvertersContentCache::Get().Clear();
+            }
+        )
+    );
+}
+
+FFileConvertersMappedFile::~FFileConvertersMappedFile()
+{
+    // Region has to go before its handle.
+    delete MappedRegion;
+    delete MappedHandle;
+}
+
+TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> FFileConvertersMappedFile::Open(const FString& FilePath, FString& ErrorCode)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    if (PlatformFile.FileExists(*FilePath) == false)
+    {
+        ErrorCode = "File doesn't exist.";
+        return nullptr;
+    }
+
+    TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = MakeShareable(new FFileConvertersMappedFile());
+
+    // Empty files can't be mapped, they are just empty views.
+    if (PlatformFile.FileSize(*FilePath) == 0)
+    {
+        ErrorCode = "Success";
+        return MappedFile;
+    }
+
+    MappedFile->MappedHandle = PlatformFile.OpenMapped(*FilePath);
+
+    if (MappedFile->MappedHandle != nullptr)
+    {
+        MappedFile->MappedRegion = MappedFile->MappedHandle->MapRegion(0, MappedFile->MappedHandle->GetFileSize());
+    }
+
+    if (MappedFile->MappedRegion != nullptr)
+    {
+        MappedFile->Data = MappedFile->MappedRegion->GetMappedPtr();
+        MappedFile->Size = MappedFile->MappedRegion->GetMappedSize();
+    }
+
+    // Platform or file system without mapping support. View is the same, only backed by memory.
+    else if (FFileHelper::LoadFileToArray(MappedFile->FallbackBuffer, *FilePath) == true)
+    {
+        MappedFile->Data = MappedFile->FallbackBuffer.GetData();
+        MappedFile->Size = MappedFile->FallbackBuffer.Num();
+    }
+
+    else
+    {
+        ErrorCode = "File couldn't be opened.";
+        return nullptr;
+    }
+
+    ErrorCode = "Success";
+    return MappedFile;
+}
+
+bool FFileConvertersMappedFile::ReadLines(int64& InOutCursor, int32 MaxLines, TArray<FString>& OutLines) const
+{
+    OutLines.Reset();
+
+    if (InOutCursor < 0 || InOutCursor >= Size)
+    {
+        return false;
+    }
+
+    // UTF-8 BOM isn't part of the first line.
+    if (InOutCursor == 0 && Size >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+    {
+        InOutCursor = 3;
+    }
+
+    while (InOutCursor < Size && OutLines.Num() < MaxLines)
+    {
+        const uint8* LineStart = Data + InOutCursor;
+        const uint8* LineFeed = static_cast<const uint8*>(memchr(LineStart, '\n', Size - InOutCursor));
+        const int64 LineLength = LineFeed ? LineFeed - LineStart : Size - InOutCursor;
+
+        int64 TextLength = LineLength;
+        if (TextLength > 0 && LineStart[TextLength - 1] == '\r')
+        {
+            TextLength--;
+        }
+
+        if (TextLength >= MAX_int32)
+        {
+            return false;
+        }
+
+        const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(LineStart), static_cast<int32>(TextLength));
+        OutLines.Emplace(Converter.Length(), Converter.Get());
+
+        InOutCursor += LineFeed ? LineLength + 1 : LineLength;
+    }
+
+    return true;
+}
+
+FFileConvertersAssets& FFileConvertersAssets::Get()
+{
+    static FFileConvertersAssets Assets;
+    return Assets;
+}
+
+FString FFileConvertersAssets::ResolvePath(const FString& AssetRelativePath, EAdditionalAssetRoot AssetRoot)
+{
+    switch (AssetRoot)
+    {
+        case EAdditionalAssetRoot::Content:
+            return FPaths::ProjectContentDir() + AssetRelativePath;
+
+        case EAdditionalAssetRoot::Saved:
+            return FPaths::ProjectSavedDir() + AssetRelativePath;
+
+        case EAdditionalAssetRoot::Project:
+            return FPaths::ProjectDir() + AssetRelativePath;
+
+        default:
+            return AssetRelativePath;
+    }
+}
+
+int32 FFileConvertersAssets::OpenMapped(const FString& FilePath, FString& ErrorCode)
+{
+    TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = FFileConvertersMappedFile::Open(FilePath, ErrorCode);
+
+    if (MappedFile.IsValid() == false)
+    {
+        return INDEX_NONE;
+    }
+
+    FScopeLock Lock(&Guard);
+
+    const int32 MappedHandle = NextHandle++;
+    MappedFiles.Add(MappedHandle, MoveTemp(MappedFile));
+
+    return MappedHandle;
+}
+
+void FFileConvertersAssets::CloseMapped(int32 MappedHandle)
+{
+    FScopeLock Lock(&Guard);
+    MappedFiles.Remove(MappedHandle);
+}
+
+TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> FFileConvertersAssets::FindMapped(int32 MappedHandle)
+{
+    FScopeLock Lock(&Guard);
+
+    const TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe>* MappedFile = MappedFiles.Find(MappedHandle);
+    return MappedFile ? *MappedFile : nullptr;
+}
+
+FFileConvertersAssetLoader& FFileConvertersAssetLoader::Get()
+{
+    static FFileConvertersAssetLoader AssetLoader;
+    return AssetLoader;
+}
+
+bool FFileConvertersAssetLoader::IsBefore(const FReadPtr& A, const FReadPtr& B)
+{
+    return A->Priority != B->Priority ? A->Priority > B->Priority : A->Sequence < B->Sequence;
+}
+
+void FFileConvertersAssetLoader::SetMaxConcurrentReads(int32 InMaxConcurrentReads)
+{
+    FScopeLock Lock(&Guard);
+
+    MaxConcurrentReads = FMath::Max(InMaxConcurrentReads, 1);
+    StartReads();
+}
+
+int32 FFileConvertersAssetLoader::LoadBatch(const TArray<FString>& AssetRelativePaths, EAdditionalAssetRoot AssetRoot, int32 Priority, FDelegateAssetLoaded DelegateFile, FDelegateAssetBatch DelegateBatch)
+{
+    check(IsInGameThread());
+
+    TSharedPtr<FBatch, ESPMode::ThreadSafe> Batch = MakeShared<FBatch, ESPMode::ThreadSafe>();
+    Batch->DelegateFile = DelegateFile;
+    Batch->DelegateBatch = DelegateBatch;
+    Batch->RemainingCount = AssetRelativePaths.Num();
+    Batch->StartTime = FPlatformTime::Seconds();
+
+    FScopeLock Lock(&Guard);
+
+    Batch->BatchHandle = NextBatchHandle++;
+
+    if (AssetRelativePaths.IsEmpty() == true)
+    {
+        // Still asynchronous, callers don't have to care about the empty case.
+        AsyncTask(ENamedThreads::GameThread, [Batch]()
+            {
+                Batch->DelegateBatch.ExecuteIfBound(true, 0, 0, 0.0f);
+            }
+        );
+
+        return Batch->BatchHandle;
+    }
+
+    for (const FString& EachRelativePath : AssetRelativePaths)
+    {
+        const FString FilePath = FPaths::ConvertRelativePathToFull(FFileConvertersAssets::ResolvePath(EachRelativePath, AssetRoot));
+
+        if (FReadPtr* ExistingRead = Reads.Find(FilePath))
+        {
+            (*ExistingRead)->Waiters.Add({ Batch, EachRelativePath });
+
+            // A queued read inherits the highest priority of its requesters.
+            if ((*ExistingRead)->bIsStarted == false && (*ExistingRead)->Priority < Priority)
+            {
+                (*ExistingRead)->Priority = Priority;
+                Queue.Heapify(&FFileConvertersAssetLoader::IsBefore);
+            }
+
+            continue;
+        }
+
+        FReadPtr Read = MakeShared<FRead, ESPMode::ThreadSafe>();
+        Read->FilePath = FilePath;
+        Read->Priority = Priority;
+        Read->Sequence = NextSequence++;
+        Read->Waiters.Add({ Batch, EachRelativePath });
+
+        Reads.Add(FilePath, Read);
+        Queue.HeapPush(Read, &FFileConvertersAssetLoader::IsBefore);
+    }
+
+    StartReads();
+
+    return Batch->BatchHandle;
+}
+
+void FFileConvertersAssetLoader::StartReads()
+{
+    while (RunningReads < MaxConcurrentReads && Queue.IsEmpty() == false)
+    {
+        FReadPtr Read;
+        Queue.HeapPop(Read, &FFileConvertersAssetLoader::IsBefore, false);
+
+        Read->bIsStarted = true;
+        RunningReads++;
+
+        // Reads mostly wait for the disk, background threads keep them away from game work.
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Read]()
+            {
+                FinishRead(Read, FFileConvertersContentCache::Get().LoadBytes(Read->FilePath));
+            }
+        );
+    }
+}
+
+void FFileConvertersAssetLoader::FinishRead(const FReadPtr& Read, FFileConvertersContentCache::FBytesPtr Bytes)
+{
+    TArray<FWaiter> Array_Waiters;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        // Requests added after this point start a new read.
+        Reads.Remove(Read->FilePath);
+        Array_Waiters = MoveTemp(Read->Waiters);
+        RunningReads--;
+
+        StartReads();
+    }
+
+    AsyncTask(ENamedThreads::GameThread, [Array_Waiters = MoveTemp(Array_Waiters), Bytes]()
+        {
+            const bool bIsLoaded = Bytes.IsValid();
+            const TArray<uint8> EmptyBytes;
+
+            for (const FWaiter& EachWaiter : Array_Waiters)
+            {
+                FBatch& Batch = *EachWaiter.Batch;
+
+                if (bIsLoaded == true)
+                {
+                    Batch.LoadedCount++;
+                }
+
+                else
+                {
+                    Batch.FailedCount++;
+                }
+
+                Batch.DelegateFile.ExecuteIfBound(bIsLoaded, EachWaiter.AssetRelativePath, bIsLoaded ? *Bytes : EmptyBytes);
+
+                if (--Batch.RemainingCount == 0)
+                {
+                    Batch.DelegateBatch.ExecuteIfBound(Batch.FailedCount == 0, Batch.LoadedCount, Batch.FailedCount, float(FPlatformTime::Seconds() - Batch.StartTime));
+                }
+            }
+        }
+    );
+}
+
+int64 FFileConvertersContentCache::FEntry::GetCachedBytes() const
+{
+    return sizeof(FEntry) + (Bytes.IsValid() ? Bytes->GetAllocatedSize() : 0) + (Text.IsValid() ? Text->GetAllocatedSize() : 0);
+}
+
+FFileConvertersContentCache& FFileConvertersContentCache::Get()
+{
+    static FFileConvertersContentCache ContentCache;
+    return ContentCache;
+}
+
+FFileConvertersContentCache::FFileConvertersContentCache()
+    : Entries(FileConvertersAssets::MaxCachedEntries)
+{
+
+}
+
+FFileConvertersContentCache::FEntryPtr FFileConvertersContentCache::FindOrLoad(const FString& FilePath)
+{
+    const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*FilePath);
+
+    if (StatData.bIsValid == false || StatData.bIsDirectory == true)
+    {
+        return nullptr;
+    }
+
+    {
+        FScopeLock Lock(&Guard);
+
+        if (const FEntryPtr* FoundEntry = Entries.FindAndTouch(FilePath))
+        {
+            if ((*FoundEntry)->FileSize == StatData.FileSize && (*FoundEntry)->ModificationTicks == StatData.ModificationTime.GetTicks())
+            {
+                HitCount++;
+                return *FoundEntry;
+            }
+
+            RemoveEntry(FilePath);
+            InvalidationCount++;
+        }
+
+        MissCount++;
+    }
+
+    // Read happens outside the lock. Two threads missing the same file both read it, last one wins the slot.
+    TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe> Bytes = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+
+    if (FFileHelper::LoadFileToArray(*Bytes, *FilePath, FILEREAD_Silent) == false)
+    {
+        return nullptr;
+    }
+
+    FEntryPtr Entry = MakeShared<FEntry, ESPMode::ThreadSafe>();
+    Entry->FileSize = StatData.FileSize;
+    Entry->ModificationTicks = StatData.ModificationTime.GetTicks();
+    Entry->Bytes = MoveTemp(Bytes);
+
+    const int64 EntryBytes = Entry->GetCachedBytes();
+
+    FScopeLock Lock(&Guard);
+
+    if (EntryBytes > BudgetBytes)
+    {
+        return Entry;
+    }
+
+    RemoveEntry(FilePath);
+
+    // LRU would drop its oldest entry silently when slots are full. Do it here so used bytes stay right.
+    if (Entries.Num() >= Entries.Max())
+    {
+        UsedBytes -= Entries.RemoveLeastRecent()->GetCachedBytes();
+        EvictionCount++;
+    }
+
+    UsedBytes += EntryBytes;
+    Entries.Add(FilePath, Entry);
+
+    EvictToBudget();
+
+    return Entry;
+}
+
+FFileConvertersContentCache::FBytesPtr FFileConvertersContentCache::LoadBytes(const FString& FilePath)
+{
+    const FEntryPtr Entry = FindOrLoad(FilePath);
+    return Entry.IsValid() ? Entry->Bytes : nullptr;
+}
+
+FFileConvertersContentCache::FTextPtr FFileConvertersContentCache::LoadText(const FString& FilePath)
+{
+    const FEntryPtr Entry = FindOrLoad(FilePath);
+
+    if (Entry.IsValid() == false)
+    {
+        return nullptr;
+    }
+
+    {
+        FScopeLock Lock(&Guard);
+
+        if (Entry->Text.IsValid() == true)
+        {
+            return Entry->Text;
+        }
+    }
+
+    // Same conversion as FFileHelper::LoadFileToString, BOM detection included.
+    TSharedPtr<FString, ESPMode::ThreadSafe> Text = MakeShared<FString, ESPMode::ThreadSafe>();
+    FFileHelper::BufferToString(*Text, Entry->Bytes->GetData(), Entry->Bytes->Num());
+
+    FScopeLock Lock(&Guard);
+
+    if (Entry->Text.IsValid() == false)
+    {
+        Entry->Text = Text;
+
+        // Only a cached entry counts against the budget. Entries above the budget are handed out uncached.
+        if (const FEntryPtr* CachedEntry = Entries.Find(FilePath))
+        {
+            if (*CachedEntry == Entry)
+            {
+                UsedBytes += Text->GetAllocatedSize();
+                EvictToBudget();
+            }
+        }
+    }
+
+    return Entry->Text;
+}
+
+void FFileConvertersContentCache::RemoveEntry(const FString& Key)
+{
+    if (const FEntryPtr* FoundEntry = Entries.Find(Key))
+    {
+        UsedBytes -= (*FoundEntry)->GetCachedBytes();
+        Entries.Remove(Key);
+    }
+}
+
+void FFileConvertersContentCache::EvictToBudget()
+{
+    while (Entries.Num() > 0 && UsedBytes > BudgetBytes)
+    {
+        UsedBytes -= Entries.RemoveLeastRecent()->GetCachedBytes();
+        EvictionCount++;
+    }
+}
+
+void FFileConvertersContentCache::SetBudget(int64 InBudgetBytes)
+{
+    FScopeLock Lock(&Guard);
+
+    BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+    EvictToBudget();
+}
+
+void FFileConvertersContentCache::Clear()
+{
+    FScopeLock Lock(&Guard);
+
+    Entries.Empty(FileConvertersAssets::MaxCachedEntries);
+    UsedBytes = 0;
+}
+
+FAssetCacheStats FFileConvertersContentCache::GetStats()
+{
+    FScopeLock Lock(&Guard);
+
+    FAssetCacheStats Stats;
+    Stats.EntryCount = Entries.Num();
+    Stats.UsedBytes = UsedBytes;
+    Stats.BudgetBytes = BudgetBytes;
+    Stats.HitCount = HitCount;
+    Stats.MissCount = MissCount;
+    Stats.InvalidationCount = InvalidationCount;
+    Stats.EvictionCount = EvictionCount;
+
+    return Stats;
+}
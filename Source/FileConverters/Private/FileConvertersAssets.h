@@ -0,0 +1,195 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "Containers/LruCache.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/*
+*	Read only view of a whole file.
+*	File is memory mapped where platform supports it, otherwise it is read once into a buffer. Either way, view stays valid as long as this object lives.
+*/
+class FFileConvertersMappedFile
+{
+public:
+
+	~FFileConvertersMappedFile();
+
+	static TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> Open(const FString& FilePath, FString& ErrorCode);
+
+	const uint8* GetData() const { return Data; }
+	int64 GetSize() const { return Size; }
+	bool IsMapped() const { return MappedRegion != nullptr; }
+
+	/*
+	*	Reads up to MaxLines UTF-8 lines starting from InOutCursor and moves cursor after them. Only those lines are converted to TCHAR.
+	*	Line ends (LF or CRLF) aren't included. Returns false when cursor is already at the end.
+	*/
+	bool ReadLines(int64& InOutCursor, int32 MaxLines, TArray<FString>& OutLines) const;
+
+private:
+
+	FFileConvertersMappedFile() = default;
+
+	IMappedFileHandle* MappedHandle = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+	TArray64<uint8> FallbackBuffer;
+
+	const uint8* Data = nullptr;
+	int64 Size = 0;
+};
+
+/* Additional asset paths and handles of mapped assets. */
+class FFileConvertersAssets
+{
+public:
+
+	static FFileConvertersAssets& Get();
+
+	static FString ResolvePath(const FString& AssetRelativePath, EAdditionalAssetRoot AssetRoot);
+
+	/* Returns INDEX_NONE if file couldn't be opened. Thread safe. */
+	int32 OpenMapped(const FString& FilePath, FString& ErrorCode);
+	void CloseMapped(int32 MappedHandle);
+
+	/* Shared ownership keeps the view alive even if handle is closed meanwhile. */
+	TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> FindMapped(int32 MappedHandle);
+
+private:
+
+	FCriticalSection Guard;
+	TMap<int32, TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe>> MappedFiles;
+	int32 NextHandle = 1;
+};
+
+/*
+*	Process wide cache of additional asset contents, keyed by resolved path. Entries are valid while file size and modification time are unchanged.
+*	Buffers are shared and immutable, native callers keep a reference instead of a copy. Least recently used entries are dropped when the byte budget is exceeded.
+*/
+class FFileConvertersContentCache
+{
+public:
+
+	using FBytesPtr = TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe>;
+	using FTextPtr = TSharedPtr<const FString, ESPMode::ThreadSafe>;
+
+	static FFileConvertersContentCache& Get();
+
+	/* Thread safe. Null if file can't be read. */
+	FBytesPtr LoadBytes(const FString& FilePath);
+
+	/* Thread safe. Decoded text is cached next to the bytes, repeated loads don't convert again. */
+	FTextPtr LoadText(const FString& FilePath);
+
+	/* Zero disables caching, loads still work. */
+	void SetBudget(int64 InBudgetBytes);
+	void Clear();
+	FAssetCacheStats GetStats();
+
+private:
+
+	struct FEntry
+	{
+		int64 FileSize = 0;
+		int64 ModificationTicks = 0;
+		FBytesPtr Bytes;
+		FTextPtr Text;
+
+		int64 GetCachedBytes() const;
+	};
+
+	using FEntryPtr = TSharedPtr<FEntry, ESPMode::ThreadSafe>;
+
+	FFileConvertersContentCache();
+
+	/* Returns valid entry, or reads the file and caches it. Null if file can't be read. */
+	FEntryPtr FindOrLoad(const FString& FilePath);
+
+	/* Needs Guard. */
+	void RemoveEntry(const FString& Key);
+	void EvictToBudget();
+
+	FCriticalSection Guard;
+	TLruCache<FString, FEntryPtr> Entries;
+
+	int64 BudgetBytes = 64LL * 1024LL * 1024LL;
+	int64 UsedBytes = 0;
+
+	int64 HitCount = 0;
+	int64 MissCount = 0;
+	int64 InvalidationCount = 0;
+	int64 EvictionCount = 0;
+};
+
+/*
+*	Batched additional asset loader.
+*	Reads go through one priority queue with a bounded number of reads in flight. Same file requested by several batches, or twice in one batch, is read once.
+*	Delegates run on game thread: one per file, one per batch after its last file.
+*/
+class FFileConvertersAssetLoader
+{
+public:
+
+	static FFileConvertersAssetLoader& Get();
+
+	/* Game thread. Higher priority is read first. Returns batch handle. */
+	int32 LoadBatch(const TArray<FString>& AssetRelativePaths, EAdditionalAssetRoot AssetRoot, int32 Priority, FDelegateAssetLoaded DelegateFile, FDelegateAssetBatch DelegateBatch);
+
+	void SetMaxConcurrentReads(int32 InMaxConcurrentReads);
+
+private:
+
+	struct FBatch
+	{
+		int32 BatchHandle = INDEX_NONE;
+		FDelegateAssetLoaded DelegateFile;
+		FDelegateAssetBatch DelegateBatch;
+		int32 RemainingCount = 0;
+		int32 LoadedCount = 0;
+		int32 FailedCount = 0;
+		double StartTime = 0;
+	};
+
+	struct FWaiter
+	{
+		TSharedPtr<FBatch, ESPMode::ThreadSafe> Batch;
+		FString AssetRelativePath;
+	};
+
+	struct FRead
+	{
+		FString FilePath;
+		int32 Priority = 0;
+		uint64 Sequence = 0;
+		bool bIsStarted = false;
+		TArray<FWaiter> Waiters;
+	};
+
+	using FReadPtr = TSharedPtr<FRead, ESPMode::ThreadSafe>;
+
+	/* Queue order: higher priority, then older request. */
+	static bool IsBefore(const FReadPtr& A, const FReadPtr& B);
+
+	/* Needs Guard. Starts queued reads while there are free slots. */
+	void StartReads();
+
+	/* Worker thread. */
+	void FinishRead(const FReadPtr& Read, FFileConvertersContentCache::FBytesPtr Bytes);
+
+	FCriticalSection Guard;
+
+	/* Heap, highest priority and then oldest request on top. */
+	TArray<FReadPtr> Queue;
+
+	/* Queued and running reads by resolved path, for coalescing. */
+	TMap<FString, FReadPtr> Reads;
+
+	int32 MaxConcurrentReads = 8;
+	int32 RunningReads = 0;
+	uint64 NextSequence = 0;
+	int32 NextBatchHandle = 1;
+};
@@ -2,19 +2,35 @@
 
 #include "FileConvertersBPLibrary.h"
 #include "FileConverters.h"
+#include "FileConvertersAssets.h"
+#include "FileConvertersExportQueue.h"
+#include "FileConvertersGLTF.h"
+#include "FileConvertersIFC.h"
+#include "FileConvertersListing.h"
+#include "FileConvertersMatcher.h"
+#include "FileConvertersPDF.h"
+#include "FileConvertersSearch.h"
+#include "FileConvertersSearchIndex.h"
+#include "FileConvertersStats.h"
+#include "FileConvertersWatcher.h"
 
 // UE Includes.
+#include "Async/ParallelFor.h"
 #include "Builders/GLTFBuilder.h"
 #include "UserData/GLTFMaterialUserData.h"
 #include "GenericPlatform/GenericPlatformMisc.h"
 #include "HAL/FileManager.h"
 #include "HAL/FileManagerGeneric.h"
+#include "HAL/PlatformFileManager.h"
+#include "Options/GLTFExportOptions.h"
 
 // Windows Includes.
+#if PLATFORM_WINDOWS
 THIRD_PARTY_INCLUDES_START
 #define WIN32_LEAN_AND_MEAN
 #include "shobjidl_core.h"
 THIRD_PARTY_INCLUDES_END
+#endif
 
 UFileConvertersBPLibrary::UFileConvertersBPLibrary(const FObjectInitializer& ObjectInitializer)
 : Super(ObjectInitializer)
@@ -22,16 +38,113 @@ UFileConvertersBPLibrary::UFileConvertersBPLibrary(const FObjectInitializer& Obj
 
 }
 
-void UFileConvertersBPLibrary::LoadAdditionalAssetString(const FString AssetRelativePath, FString& OutAssetString)
+void UFileConvertersBPLibrary::LoadAdditionalAssetString(const FString AssetRelativePath, FString& OutAssetString, EAdditionalAssetRoot AssetRoot)
 {
-    const FString AssetPathCoocked = FPaths::ProjectContentDir() + AssetRelativePath;
-    FFileHelper::LoadFileToString(OutAssetString, *AssetPathCoocked);
+    const FString AssetPathCoocked = FPaths::ConvertRelativePathToFull(FFileConvertersAssets::ResolvePath(AssetRelativePath, AssetRoot));
+
+    if (FFileConvertersContentCache::FTextPtr AssetText = FFileConvertersContentCache::Get().LoadText(AssetPathCoocked))
+    {
+        OutAssetString = *AssetText;
+    }
+}
+
+void UFileConvertersBPLibrary::LoadAdditionalAssetBytes(const FString AssetRelativePath, TArray<uint8>& OutAssetBytes, EAdditionalAssetRoot AssetRoot)
+{
+    const FString AssetPathCoocked = FPaths::ConvertRelativePathToFull(FFileConvertersAssets::ResolvePath(AssetRelativePath, AssetRoot));
+
+    if (FFileConvertersContentCache::FBytesPtr AssetBytes = FFileConvertersContentCache::Get().LoadBytes(AssetPathCoocked))
+    {
+        OutAssetBytes = *AssetBytes;
+    }
+}
+
+int32 UFileConvertersBPLibrary::LoadAdditionalAssetsBatch(FDelegateAssetLoaded DelegateFile, FDelegateAssetBatch DelegateBatch, TArray<FString> AssetRelativePaths, EAdditionalAssetRoot AssetRoot, int32 Priority)
+{
+    return FFileConvertersAssetLoader::Get().LoadBatch(AssetRelativePaths, AssetRoot, Priority, DelegateFile, DelegateBatch);
+}
+
+void UFileConvertersBPLibrary::SetAssetLoadConcurrency(int32 MaxConcurrentReads)
+{
+    FFileConvertersAssetLoader::Get().SetMaxConcurrentReads(MaxConcurrentReads);
+}
+
+void UFileConvertersBPLibrary::SetAssetCacheBudget(int64 MaxBytes)
+{
+    FFileConvertersContentCache::Get().SetBudget(MaxBytes);
+}
+
+void UFileConvertersBPLibrary::ClearAssetCache()
+{
+    FFileConvertersContentCache::Get().Clear();
+}
+
+FAssetCacheStats UFileConvertersBPLibrary::GetAssetCacheStats()
+{
+    return FFileConvertersContentCache::Get().GetStats();
+}
+
+bool UFileConvertersBPLibrary::OpenMappedAsset(const FString AssetRelativePath, EAdditionalAssetRoot AssetRoot, int32& OutMappedHandle, int64& OutSize, FString& ErrorCode)
+{
+    OutSize = 0;
+    OutMappedHandle = FFileConvertersAssets::Get().OpenMapped(FFileConvertersAssets::ResolvePath(AssetRelativePath, AssetRoot), ErrorCode);
+
+    if (OutMappedHandle == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Handle may be closed by another thread right away.
+    const TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = FFileConvertersAssets::Get().FindMapped(OutMappedHandle);
+
+    if (MappedFile.IsValid() == false)
+    {
+        OutMappedHandle = INDEX_NONE;
+        ErrorCode = "Mapped asset is closed.";
+        return false;
+    }
+
+    OutSize = MappedFile->GetSize();
+    return true;
+}
+
+bool UFileConvertersBPLibrary::ReadMappedAssetBytes(int32 MappedHandle, int64 Offset, int32 Count, TArray<uint8>& OutBytes)
+{
+    OutBytes.Reset();
+
+    TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = FFileConvertersAssets::Get().FindMapped(MappedHandle);
+
+    if (MappedFile.IsValid() == false || Offset < 0 || Count < 0)
+    {
+        return false;
+    }
+
+    if (Offset >= MappedFile->GetSize())
+    {
+        return true;
+    }
+
+    const int64 ReadCount = FMath::Min<int64>(Count, MappedFile->GetSize() - Offset);
+    OutBytes.Append(MappedFile->GetData() + Offset, static_cast<int32>(ReadCount));
+
+    return true;
+}
+
+bool UFileConvertersBPLibrary::ReadMappedAssetLines(int32 MappedHandle, int64& Cursor, int32 MaxLines, TArray<FString>& OutLines)
+{
+    TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = FFileConvertersAssets::Get().FindMapped(MappedHandle);
+
+    if (MappedFile.IsValid() == false)
+    {
+        OutLines.Reset();
+        return false;
+    }
+
+    return MappedFile->ReadLines(Cursor, FMath::Max(MaxLines, 1), OutLines);
 }
 
-void UFileConvertersBPLibrary::LoadAdditionalAssetBytes(const FString AssetRelativePath, TArray<uint8>& OutAssetBytes)
+void UFileConvertersBPLibrary::CloseMappedAsset(int32 MappedHandle)
 {
-    const FString AssetPathCoocked = FPaths::ProjectSavedDir() + AssetRelativePath;
-    FFileHelper::LoadFileToArray(OutAssetBytes, *AssetPathCoocked);
+    FFileConvertersAssets::Get().CloseMapped(MappedHandle);
 }
 
 FString UFileConvertersBPLibrary::HelperIFCConverter(const FString IFC_Converter_Path, const FString IFC_EXE_Name, const FString IFC_Path)
@@ -40,97 +153,451 @@ FString UFileConvertersBPLibrary::HelperIFCConverter(const FString IFC_Converter
     return TEXT("cd /d ") + IFC_Converter_Path + TEXT(" & ") + IFC_EXE_Name + TEXT(" --use-element-hierarchy --generate-uvs --center-model --center-model-geometry ") + IFC_Path + TEXT(" ") + Clean_IFC_Path + TEXT(".dae");
 }
 
-FString UFileConvertersBPLibrary::CreatePDFViewer(const FString In_HTML_Content, const FString In_PDF_Path, TArray<uint8> In_PDF_Bytes, const FString DummyText, bool bUseBytes)
+int32 UFileConvertersBPLibrary::QueueIFCConversion(FIFCConversionJob Job, FDelegateIFCConversion DelegateConversion, FDelegateIFCProgress DelegateProgress)
+{
+    return FFileConvertersIFCPool::Get().QueueJob(Job, DelegateConversion, DelegateProgress);
+}
+
+bool UFileConvertersBPLibrary::CancelIFCConversion(int32 JobHandle)
+{
+    return FFileConvertersIFCPool::Get().CancelJob(JobHandle);
+}
+
+EIFCConversionState UFileConvertersBPLibrary::GetIFCConversionProgress(int32 JobHandle, float& OutProgress)
+{
+    return FFileConvertersIFCPool::Get().GetProgress(JobHandle, OutProgress);
+}
+
+void UFileConvertersBPLibrary::SetIFCConversionConcurrency(int32 MaxProcesses, int32 MemoryPerProcessMB)
+{
+    FFileConvertersIFCPool::Get().SetConcurrency(MaxProcesses, MemoryPerProcessMB);
+}
+
+FIFCConversionStats UFileConvertersBPLibrary::GetIFCConversionStats()
 {
-    FString PDF_Base64;
+    return FFileConvertersIFCPool::Get().GetStats();
+}
+
+void UFileConvertersBPLibrary::SetIFCCacheBudget(int64 MaxBytes)
+{
+    FFileConvertersIFCCache::Get().SetBudget(MaxBytes);
+}
+
+void UFileConvertersBPLibrary::ClearIFCCache()
+{
+    FFileConvertersIFCCache::Get().Clear();
+}
+
+FIFCCacheStats UFileConvertersBPLibrary::GetIFCCacheStats()
+{
+    return FFileConvertersIFCCache::Get().GetStats();
+}
+
+void UFileConvertersBPLibrary::ScanIFCFile(FDelegateIFCScan DelegateScan, const FString IFC_Path)
+{
+    if (IFC_Path.IsEmpty() == true)
+    {
+        DelegateScan.ExecuteIfBound(false, "Path is empty.", FIFCScanResult());
+        return;
+    }
+
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [DelegateScan, IFC_Path]()
+        {
+            FIFCScanResult ScanResult;
+            FString ErrorCode;
+            const bool bIsSuccessful = FFileConvertersIFCScanner::Scan(IFC_Path, ScanResult, ErrorCode);
+
+            AsyncTask(ENamedThreads::GameThread, [DelegateScan, bIsSuccessful, ErrorCode, ScanResult = MoveTemp(ScanResult)]()
+                {
+                    DelegateScan.ExecuteIfBound(bIsSuccessful, ErrorCode, ScanResult);
+                }
+            );
+        }
+    );
+}
+
+FString UFileConvertersBPLibrary::CreatePDFViewer(const FString& In_HTML_Content, const FString In_PDF_Path, const TArray<uint8>& In_PDF_Bytes, const FString DummyText, bool bUseBytes)
+{
+    FString HTML_Content;
     
     if (bUseBytes == false)
     {
-        // Load PFD and Convert it to Base64.
-        TArray<uint8> PDF_Bytes;
-        FFileHelper::LoadFileToArray(PDF_Bytes, *In_PDF_Path);
-        PDF_Base64 = FBase64::Encode(PDF_Bytes);
+        // Stream PDF from disk and encode it directly into HTML content.
+        FFileConvertersPDF::EmbedFile(HTML_Content, In_HTML_Content, DummyText, In_PDF_Path);
     }
 
     else
     {
-        PDF_Base64 = FBase64::Encode(In_PDF_Bytes);
+        FFileConvertersPDF::EmbedBytes(HTML_Content, In_HTML_Content, DummyText, In_PDF_Bytes);
     }
 
-    // Replace dummy text in HTML content to Base64 PDF.
-    FString HTML_Content = In_HTML_Content;
-    HTML_Content.ReplaceInline(*DummyText, *PDF_Base64, ESearchCase::CaseSensitive);
-
     return HTML_Content;
 }
 
-void UFileConvertersBPLibrary::ExportLevelGLTF(bool bEnableQuantization, bool bResetLocation, bool bResetRotation, bool bResetScale, const FString ExportPath, TSet<AActor*> TargetActors, FDelegateGLTFExport DelegateGLTFExport)
+void UFileConvertersBPLibrary::CreatePDFViewerAsync(FDelegatePDFViewer DelegatePDFViewer, const FString& In_HTML_Content, const FString In_PDF_Path, const FString DummyText, bool bUseCache)
 {
-    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateGLTFExport, bEnableQuantization, bResetLocation, bResetRotation, bResetScale, ExportPath, TargetActors]()
+    if (In_PDF_Path.IsEmpty() == true)
+    {
+        DelegatePDFViewer.ExecuteIfBound(false, "Path is empty.", FString());
+        return;
+    }
+
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegatePDFViewer, In_HTML_Content, In_PDF_Path, DummyText, bUseCache]()
         {
-            TArray<FVector> Array_Locations;
-            TArray<FRotator> Array_Rotations;
-            TArray<FVector> Array_Scales;
+            FString HTML_Content;
+            FString ErrorCode;
+            bool bIsSuccessful = false;
 
-            for (int32 ActorIndex = 0; ActorIndex < TargetActors.Num(); ActorIndex++)
+            if (bUseCache == true)
             {
-                if (bResetLocation == true)
-                {
-                    Array_Locations.Add(TargetActors.Array()[ActorIndex]->GetRootComponent()->GetComponentLocation());
-                    TargetActors.Array()[ActorIndex]->GetRootComponent()->SetWorldLocation(FVector(0.0f), false, nullptr, ETeleportType::None);
-                }
+                bIsSuccessful = FFileConvertersPDFCache::Get().Embed(HTML_Content, ErrorCode, In_HTML_Content, DummyText, In_PDF_Path);
+            }
 
-                if (bResetRotation == true)
-                {
-                    Array_Rotations.Add(TargetActors.Array()[ActorIndex]->GetRootComponent()->GetComponentRotation());
-                    TargetActors.Array()[ActorIndex]->GetRootComponent()->SetWorldRotation(FQuat(0.0f), false, nullptr, ETeleportType::None);
-                }
+            else if (FPaths::FileExists(In_PDF_Path) == false)
+            {
+                ErrorCode = "PDF doesn't exist.";
+            }
+
+            else
+            {
+                bIsSuccessful = FFileConvertersPDF::EmbedFile(HTML_Content, In_HTML_Content, DummyText, In_PDF_Path);
+                ErrorCode = bIsSuccessful ? "Success" : "PDF couldn't be encoded.";
+            }
 
-                if (bResetScale == true)
+            AsyncTask(ENamedThreads::GameThread, [DelegatePDFViewer, bIsSuccessful, ErrorCode, HTML_Content = MoveTemp(HTML_Content)]()
                 {
-                    Array_Scales.Add(TargetActors.Array()[ActorIndex]->GetRootComponent()->GetComponentScale());
-                    TargetActors.Array()[ActorIndex]->GetRootComponent()->SetWorldScale3D(FVector(1.0f));
+                    DelegatePDFViewer.ExecuteIfBound(bIsSuccessful, ErrorCode, HTML_Content);
                 }
+            );
+        }
+    );
+}
+
+void UFileConvertersBPLibrary::SetPDFCacheBudget(int64 MaxBytes)
+{
+    FFileConvertersPDFCache::Get().SetBudget(MaxBytes);
+}
+
+void UFileConvertersBPLibrary::ClearPDFCache()
+{
+    FFileConvertersPDFCache::Get().Clear();
+}
+
+int64 UFileConvertersBPLibrary::GetPDFCacheSize()
+{
+    return FFileConvertersPDFCache::Get().GetUsedBytes();
+}
+
+void UFileConvertersBPLibrary::ExportLevelGLTF(bool bEnableQuantization, bool bResetLocation, bool bResetRotation, bool bResetScale, const FString ExportPath, TSet<AActor*> TargetActors, FDelegateGLTFExport DelegateGLTFExport, bool bKeepActorsUntouched)
+{
+    // Exporter and actor transforms are game thread only. Export runs here, delegate still fires on a later game thread task like before.
+    UGLTFExportOptions* ExportOptions = FFileConvertersGLTF::MakeExportOptions(bEnableQuantization);
+
+    FGLTFExportMessages ExportMessages;
+    bool bIsExportSuccessful = false;
+
+    if (bKeepActorsUntouched == true)
+    {
+        {
+            FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+            bIsExportSuccessful = UGLTFExporter::ExportToGLTF(GEngine->GetCurrentPlayWorld(), ExportPath, ExportOptions, TargetActors, ExportMessages);
+        }
+
+        FString ErrorCode;
+        if (bIsExportSuccessful == true && FFileConvertersGLTF::OverrideRootTransforms(ExportPath, bResetLocation, bResetRotation, bResetScale, ErrorCode) == false)
+        {
+            ExportMessages.Errors.Add(ErrorCode);
+            bIsExportSuccessful = false;
+        }
+    }
+
+    else
+    {
+        FFileConvertersTransformSnapshot TransformSnapshot;
+        TransformSnapshot.Capture(TargetActors);
+        TransformSnapshot.Reset(bResetLocation, bResetRotation, bResetScale);
+
+        {
+            FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+            bIsExportSuccessful = UGLTFExporter::ExportToGLTF(GEngine->GetCurrentPlayWorld(), ExportPath, ExportOptions, TargetActors, ExportMessages);
+        }
+
+        TransformSnapshot.Restore();
+    }
+
+    AsyncTask(ENamedThreads::GameThread, [DelegateGLTFExport, bIsExportSuccessful, ExportMessages = MoveTemp(ExportMessages)]()
+        {
+            DelegateGLTFExport.ExecuteIfBound(bIsExportSuccessful, ExportMessages);
+        }
+    );
+}
+
+void UFileConvertersBPLibrary::ExportLevelGLBStreamed(bool bEnableQuantization, bool bResetLocation, bool bResetRotation, bool bResetScale, const FString ExportPath, TSet<AActor*> TargetActors, FDelegateGLBExport DelegateGLBExport, int32 ActorsPerPart, bool bKeepActorsUntouched, bool bUseExportCache, bool bInstanceAndDedupe, bool bOptimizeVertexCache, bool bMeshoptCompression)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FGLTFExportMessages ExportMessages;
+    FGLBExportStats ExportStats;
+    bool bIsExportSuccessful = true;
+
+    if (FPaths::GetExtension(ExportPath).Equals(TEXT("glb"), ESearchCase::IgnoreCase) == false)
+    {
+        ExportMessages.Errors.Add(TEXT("Streamed export only writes .glb files."));
+        bIsExportSuccessful = false;
+    }
+
+    else
+    {
+        UGLTFExportOptions* ExportOptions = FFileConvertersGLTF::MakeExportOptions(bEnableQuantization);
+
+        TArray<TSet<AActor*>> Array_Parts;
+        FFileConvertersGLTF::SplitByAttachRoot(TargetActors, ActorsPerPart, Array_Parts);
+
+        FFileConvertersTransformSnapshot TransformSnapshot;
+        FFileConvertersGLBWriter GLBWriter(ExportPath);
+        GLBWriter.SetOptimize(bInstanceAndDedupe);
+        GLBWriter.SetMeshOptimization(bOptimizeVertexCache, bMeshoptCompression);
+
+        if (bKeepActorsUntouched == true)
+        {
+            GLBWriter.SetRootReset(bResetLocation, bResetRotation, bResetScale);
+        }
+
+        else
+        {
+            TransformSnapshot.Capture(TargetActors);
+            TransformSnapshot.Reset(bResetLocation, bResetRotation, bResetScale);
+        }
+
+        const FString PartPrefix = FPaths::ProjectSavedDir() / TEXT("FileConverters/ExportParts") / FGuid::NewGuid().ToString();
+        IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+        FFileConvertersExportCache& ExportCache = FFileConvertersExportCache::Get();
+        int32 CachedPartCount = 0;
+
+        // Only one part is in memory at a time. Its binary is streamed to the writer's spool and the part file is deleted or kept in export cache.
+        for (int32 PartIndex = 0; PartIndex < Array_Parts.Num() && bIsExportSuccessful == true; PartIndex++)
+        {
+            uint64 PartKey = 0;
+            const bool bIsCacheable = bUseExportCache == true && FFileConvertersExportCache::MakePartKey(Array_Parts[PartIndex], bEnableQuantization, PartKey) == true;
+
+            FString SourcePath = bIsCacheable ? ExportCache.Find(PartKey) : FString();
+            FString ErrorCode;
+
+            if (SourcePath.IsEmpty() == false && GLBWriter.AppendPart(SourcePath, ErrorCode) == true)
+            {
+                CachedPartCount++;
+                continue;
             }
 
-            AsyncTask(ENamedThreads::GameThread, [DelegateGLTFExport, bEnableQuantization, bResetLocation, bResetRotation, bResetScale, Array_Locations, Array_Rotations, Array_Scales, ExportPath, TargetActors]()
-                {
-                    UGLTFExportOptions* ExportOptions = NewObject<UGLTFExportOptions>();
-                    ExportOptions->ResetToDefault();
-                    ExportOptions->bExportProxyMaterials = true;
-                    ExportOptions->bExportVertexColors = true;
-                    ExportOptions->bUseMeshQuantization = bEnableQuantization;
+            const FString PartPath = FString::Printf(TEXT("%s_%d.glb"), *PartPrefix, PartIndex);
 
-                    FGLTFExportMessages ExportMessages;
-                    bool bIsExportSuccessful = UGLTFExporter::ExportToGLTF(GEngine->GetCurrentPlayWorld(), ExportPath, ExportOptions, TargetActors, ExportMessages);
+            FGLTFExportMessages PartMessages;
+            {
+                FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+                bIsExportSuccessful = UGLTFExporter::ExportToGLTF(GEngine->GetCurrentPlayWorld(), PartPath, ExportOptions, Array_Parts[PartIndex], PartMessages);
+            }
 
-                    for (int32 ActorIndex = 0; ActorIndex < TargetActors.Num(); ActorIndex++)
-                    {
-                        if (bResetLocation == true)
-                        {
-                            TargetActors.Array()[ActorIndex]->GetRootComponent()->SetWorldLocation(Array_Locations[ActorIndex], false, nullptr, ETeleportType::None);
-                        }
+            ExportMessages.Suggestions.Append(PartMessages.Suggestions);
+            ExportMessages.Warnings.Append(PartMessages.Warnings);
+            ExportMessages.Errors.Append(PartMessages.Errors);
 
-                        if (bResetRotation == true)
-                        {
-                            TargetActors.Array()[ActorIndex]->GetRootComponent()->SetWorldRotation(Array_Rotations[ActorIndex], false, nullptr, ETeleportType::None);
-                        }
+            SourcePath = bIsExportSuccessful && bIsCacheable ? ExportCache.Store(PartKey, PartPath) : FString();
 
-                        if (bResetScale == true)
-                        {
-                            TargetActors.Array()[ActorIndex]->GetRootComponent()->SetWorldScale3D(Array_Scales[ActorIndex]);
-                        }
+            if (SourcePath.IsEmpty() == true)
+            {
+                SourcePath = PartPath;
+            }
+
+            if (bIsExportSuccessful == true && GLBWriter.AppendPart(SourcePath, ErrorCode) == false)
+            {
+                ExportMessages.Errors.Add(ErrorCode);
+                bIsExportSuccessful = false;
+            }
+
+            PlatformFile.DeleteFile(*PartPath);
+        }
+
+        if (bKeepActorsUntouched == false)
+        {
+            TransformSnapshot.Restore();
+        }
+
+        FString ErrorCode;
+        if (bIsExportSuccessful == true && GLBWriter.Finish(ErrorCode) == false)
+        {
+            ExportMessages.Errors.Add(ErrorCode);
+            bIsExportSuccessful = false;
+        }
+
+        ExportStats = GLBWriter.GetStats();
+        ExportStats.PartCount = Array_Parts.Num();
+        ExportStats.CachedPartCount = CachedPartCount;
+    }
+
+    ExportStats.Seconds = float(FPlatformTime::Seconds() - StartTime);
+
+    AsyncTask(ENamedThreads::GameThread, [DelegateGLBExport, bIsExportSuccessful, ExportMessages = MoveTemp(ExportMessages), ExportStats]()
+        {
+            DelegateGLBExport.ExecuteIfBound(bIsExportSuccessful, ExportMessages, ExportStats);
+        }
+    );
+}
+
+void UFileConvertersBPLibrary::ExportLevelGLBTiled(bool bEnableQuantization, const FString ExportFolder, TSet<AActor*> TargetActors, FDelegateGLBExport DelegateGLBExport, int64 MaxTrianglesPerTile, bool bInstanceAndDedupe, bool bOptimizeVertexCache, bool bMeshoptCompression)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    FGLTFExportMessages ExportMessages;
+    FGLBExportStats ExportStats;
+    bool bIsExportSuccessful = true;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    if (ExportFolder.IsEmpty() == true || PlatformFile.CreateDirectoryTree(*ExportFolder) == false)
+    {
+        ExportMessages.Errors.Add(TEXT("Export folder can't be created."));
+        bIsExportSuccessful = false;
+    }
+
+    else
+    {
+        UGLTFExportOptions* ExportOptions = FFileConvertersGLTF::MakeExportOptions(bEnableQuantization);
+
+        TArray<FFileConvertersTile> Array_Tiles;
+        FFileConvertersGLTF::SplitBySpace(TargetActors, FMath::Max<int64>(MaxTrianglesPerTile, 1), Array_Tiles);
+
+        const FString PartPrefix = FPaths::ProjectSavedDir() / TEXT("FileConverters/ExportParts") / FGuid::NewGuid().ToString();
+
+        TArray<FString> Array_TileUris;
+        TArray<FString> Array_PartPaths;
+
+        // Exporter is game thread only, so tiles are exported one after another.
+        for (int32 TileIndex = 0; TileIndex < Array_Tiles.Num() && bIsExportSuccessful == true; TileIndex++)
+        {
+            const FString PartPath = FString::Printf(TEXT("%s_%d.glb"), *PartPrefix, TileIndex);
+
+            FGLTFExportMessages PartMessages;
+            {
+                FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+                bIsExportSuccessful = UGLTFExporter::ExportToGLTF(GEngine->GetCurrentPlayWorld(), PartPath, ExportOptions, Array_Tiles[TileIndex].Actors, PartMessages);
+            }
+
+            ExportMessages.Suggestions.Append(PartMessages.Suggestions);
+            ExportMessages.Warnings.Append(PartMessages.Warnings);
+            ExportMessages.Errors.Append(PartMessages.Errors);
+
+            Array_TileUris.Add(FString::Printf(TEXT("tile_%d.glb"), TileIndex));
+            Array_PartPaths.Add(PartPath);
+        }
+
+        // Tiles don't share anything, so each one is optimized and written by its own writer in parallel.
+        TArray<FString> Array_ErrorCodes;
+        TArray<FGLBExportStats> Array_TileStats;
+        Array_ErrorCodes.SetNum(Array_PartPaths.Num());
+        Array_TileStats.SetNum(Array_PartPaths.Num());
+
+        if (bIsExportSuccessful == true)
+        {
+            ParallelFor(Array_PartPaths.Num(), [&](int32 TileIndex)
+                {
+                    FFileConvertersGLBWriter GLBWriter(ExportFolder / Array_TileUris[TileIndex]);
+                    GLBWriter.SetOptimize(bInstanceAndDedupe);
+                    GLBWriter.SetMeshOptimization(bOptimizeVertexCache, bMeshoptCompression);
+
+                    if (GLBWriter.AppendPart(Array_PartPaths[TileIndex], Array_ErrorCodes[TileIndex]) == true)
+                    {
+                        GLBWriter.Finish(Array_ErrorCodes[TileIndex]);
                     }
 
-                    DelegateGLTFExport.ExecuteIfBound(bIsExportSuccessful, ExportMessages);
+                    Array_TileStats[TileIndex] = GLBWriter.GetStats();
+                    Array_TileStats[TileIndex].PartCount = 1;
                 }
             );
         }
+
+        for (int32 TileIndex = 0; TileIndex < Array_PartPaths.Num(); TileIndex++)
+        {
+            PlatformFile.DeleteFile(*Array_PartPaths[TileIndex]);
+            FFileConvertersGLTF::AccumulateStats(ExportStats, Array_TileStats[TileIndex]);
+
+            if (Array_ErrorCodes[TileIndex].IsEmpty() == false && Array_ErrorCodes[TileIndex] != TEXT("Success"))
+            {
+                ExportMessages.Errors.Add(Array_ErrorCodes[TileIndex]);
+                bIsExportSuccessful = false;
+            }
+        }
+
+        FString ErrorCode;
+        if (bIsExportSuccessful == true && FFileConvertersGLTF::WriteTileset(ExportFolder / TEXT("tileset.json"), Array_Tiles, Array_TileUris, ExportOptions->ExportUniformScale, ErrorCode) == false)
+        {
+            ExportMessages.Errors.Add(ErrorCode);
+            bIsExportSuccessful = false;
+        }
+    }
+
+    ExportStats.Seconds = float(FPlatformTime::Seconds() - StartTime);
+
+    AsyncTask(ENamedThreads::GameThread, [DelegateGLBExport, bIsExportSuccessful, ExportMessages = MoveTemp(ExportMessages), ExportStats]()
+        {
+            DelegateGLBExport.ExecuteIfBound(bIsExportSuccessful, ExportMessages, ExportStats);
+        }
     );
 }
 
+int32 UFileConvertersBPLibrary::QueueLevelGLBExport(FGLBExportJob Job, FDelegateGLBExport DelegateGLBExport)
+{
+    return FFileConvertersExportQueue::Get().QueueJob(Job, DelegateGLBExport);
+}
+
+bool UFileConvertersBPLibrary::CancelExportJob(int32 JobHandle)
+{
+    return FFileConvertersExportQueue::Get().CancelJob(JobHandle);
+}
+
+EGLBExportJobState UFileConvertersBPLibrary::GetExportJobProgress(int32 JobHandle, float& OutProgress)
+{
+    return FFileConvertersExportQueue::Get().GetProgress(JobHandle, OutProgress);
+}
+
+void UFileConvertersBPLibrary::SetExportQueueConcurrency(int32 MaxRunningJobs, float GameThreadBudgetMs)
+{
+    FFileConvertersExportQueue::Get().SetConcurrency(MaxRunningJobs, GameThreadBudgetMs);
+}
+
+FExportQueueStats UFileConvertersBPLibrary::GetExportQueueStats()
+{
+    return FFileConvertersExportQueue::Get().GetStats();
+}
+
+void UFileConvertersBPLibrary::SetExportCacheBudget(int64 MaxBytes)
+{
+    FFileConvertersExportCache::Get().SetBudget(MaxBytes);
+}
+
+void UFileConvertersBPLibrary::ClearExportCache()
+{
+    FFileConvertersExportCache::Get().Clear();
+}
+
+void UFileConvertersBPLibrary::GetPluginMetrics(TArray<FPluginPhaseMetrics>& OutMetrics)
+{
+    FFileConvertersMetrics::Get().GetMetrics(OutMetrics);
+}
+
+void UFileConvertersBPLibrary::ResetPluginMetrics()
+{
+    FFileConvertersMetrics::Get().Reset();
+}
+
+bool UFileConvertersBPLibrary::DumpPluginMetricsToCSV(const FString FilePath, FString& ErrorCode)
+{
+    return FFileConvertersMetrics::Get().AppendCSV(FilePath, ErrorCode);
+}
+
 void UFileConvertersBPLibrary::SelectFileFromDialog(FDelegateOpenFile DelegateFileNames, const FString InDialogName, const FString InOkLabel, const FString InDefaultPath, TMap<FString, FString> InExtensions, int32 DefaultExtensionIndex, bool bIsNormalizeOutputs, bool bAllowFolderSelection)
 {
+#if PLATFORM_WINDOWS
     AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateFileNames, InDialogName, InOkLabel, InDefaultPath, InExtensions, DefaultExtensionIndex, bIsNormalizeOutputs, bAllowFolderSelection]()
         {
             IFileOpenDialog* FileOpenDialog;
@@ -323,10 +790,19 @@ void UFileConvertersBPLibrary::SelectFileFromDialog(FDelegateOpenFile DelegateFi
             }
         }
     );
+#else
+    // Native dialogs are Windows only, headless and Linux builds report a cancelled selection.
+    FSelectedFiles SelectedFiles;
+    SelectedFiles.IsSuccessfull = false;
+    SelectedFiles.IsFolder = bAllowFolderSelection;
+
+    DelegateFileNames.ExecuteIfBound(SelectedFiles);
+#endif
 }
 
 void UFileConvertersBPLibrary::SaveFileDialog(FDelegateSaveFile DelegateSaveFile, const FString InDialogName, const FString InOkLabel, const FString InDefaultPath, TMap<FString, FString> InExtensions, int32 DefaultExtensionIndex, bool bIsNormalizeOutputs)
 {
+#if PLATFORM_WINDOWS
     AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateSaveFile, InDialogName, InOkLabel, InDefaultPath, InExtensions, DefaultExtensionIndex, bIsNormalizeOutputs]()
         {
             IFileSaveDialog* SaveFileDialog;
@@ -446,6 +922,10 @@ void UFileConvertersBPLibrary::SaveFileDialog(FDelegateSaveFile DelegateSaveFile
             }
         }
     );
+#else
+    // Native dialogs are Windows only, headless and Linux builds report a cancelled save.
+    DelegateSaveFile.ExecuteIfBound(false, TEXT(""));
+#endif
 }
 
 bool UFileConvertersBPLibrary::GetFolderContents(TArray<FFolderContent>& OutContents, FString& ErrorCode, FString InPath)
@@ -462,53 +942,83 @@ bool UFileConvertersBPLibrary::GetFolderContents(TArray<FFolderContent>& OutCont
         return false;
     }
     
-    class FFindDirectories : public IPlatformFile::FDirectoryVisitor
+    FFileConvertersListing::ListFolder(InPath, OutContents);
+
+    return true;
+}
+
+void UFileConvertersBPLibrary::OpenFolderListing(FDelegateFolderListing DelegateListing, FString InPath, EFolderSortMode SortMode, bool bDescending)
+{
+    if (InPath.IsEmpty() == true)
     {
-    public:
-        
-        TArray<FFolderContent> Array_Contents;
-        
-        FFindDirectories() {}
-        virtual bool Visit(const TCHAR* CharPath, bool bIsDirectory) override
-        {
-            if (bIsDirectory == true)
-            {
-                FFolderContent EachContent;
-                
-                FString Path = FString(CharPath) + "/";
-                FPaths::NormalizeDirectoryName(Path);
-                
-                EachContent.Path = Path;
-                EachContent.Name = FPaths::GetBaseFilename(Path);
-                EachContent.bIsFile = false;
-                
-                Array_Contents.Add(EachContent);
-            }
+        DelegateListing.ExecuteIfBound(false, "Path is empty.", INDEX_NONE, 0);
+        return;
+    }
 
-            else if (bIsDirectory == false)
-            {
-                FFolderContent EachContent;
-                
-                EachContent.Path = CharPath;
-                EachContent.Name = FPaths::GetCleanFilename(CharPath);
-                EachContent.bIsFile = true;
+    if (FPaths::DirectoryExists(InPath) == false)
+    {
+        DelegateListing.ExecuteIfBound(false, "Directory doesn't exist.", INDEX_NONE, 0);
+        return;
+    }
 
-                Array_Contents.Add(EachContent);
-            }
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateListing, InPath, SortMode, bDescending]()
+        {
+            TArray<FFolderContent> Array_Contents;
+            FFileConvertersListing::ListFolder(InPath, Array_Contents);
+            FFileConvertersListing::Sort(Array_Contents, SortMode, bDescending);
+
+            AsyncTask(ENamedThreads::GameThread, [DelegateListing, Array_Contents = MoveTemp(Array_Contents)]() mutable
+                {
+                    const int32 EntryCount = Array_Contents.Num();
+                    const int32 ListingHandle = FFileConvertersListing::Get().AddListing(MoveTemp(Array_Contents));
 
-            return true;
+                    DelegateListing.ExecuteIfBound(true, "Success", ListingHandle, EntryCount);
+                }
+            );
         }
-    };
+    );
+}
 
-    FFindDirectories GetFoldersVisitor;
-    FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*InPath, GetFoldersVisitor);
-    
-    OutContents = GetFoldersVisitor.Array_Contents;
+bool UFileConvertersBPLibrary::GetFolderListingPage(int32 ListingHandle, int32 Offset, int32 Count, TArray<FFolderContent>& OutContents)
+{
+    return FFileConvertersListing::Get().GetPage(ListingHandle, Offset, Count, OutContents);
+}
 
-    return true;
+void UFileConvertersBPLibrary::CloseFolderListing(int32 ListingHandle)
+{
+    FFileConvertersListing::Get().RemoveListing(ListingHandle);
+}
+
+void UFileConvertersBPLibrary::SetListingCacheBudget(int32 MaxEntries, int64 MaxBytes)
+{
+    FFileConvertersListingCache::Get().SetBudget(MaxEntries, MaxBytes);
+}
+
+void UFileConvertersBPLibrary::SetListingCacheRevalidation(bool bRevalidateUnwatched)
+{
+    FFileConvertersListingCache::Get().SetRevalidateUnwatched(bRevalidateUnwatched);
+}
+
+void UFileConvertersBPLibrary::ClearListingCache()
+{
+    FFileConvertersListingCache::Get().Clear();
+}
+
+FListingCacheStats UFileConvertersBPLibrary::GetListingCacheStats()
+{
+    return FFileConvertersListingCache::Get().GetStats();
 }
 
 void UFileConvertersBPLibrary::SearchInFolder(FDelegateSearch DelegateSearch, FString InPath, FString InSearch, bool bSearchExact)
+{
+    FFileSearchQuery Query;
+    Query.Pattern = InSearch;
+    Query.Mode = bSearchExact ? EFileSearchMode::Exact : EFileSearchMode::Substring;
+
+    SearchInFolderWithQuery(DelegateSearch, InPath, Query);
+}
+
+void UFileConvertersBPLibrary::SearchInFolderWithQuery(FDelegateSearch DelegateSearch, FString InPath, FFileSearchQuery Query)
 {
     if (InPath.IsEmpty() == true)
     {
@@ -518,7 +1028,7 @@ void UFileConvertersBPLibrary::SearchInFolder(FDelegateSearch DelegateSearch, FS
         return;
     }
 
-    if (InSearch.IsEmpty() == true)
+    if (Query.Pattern.IsEmpty() == true && Query.Extensions.IsEmpty() == true)
     {
         FContentArrayContainer EmptyContainer;
         DelegateSearch.Execute(false, "Search is empty.", EmptyContainer);
@@ -534,52 +1044,277 @@ void UFileConvertersBPLibrary::SearchInFolder(FDelegateSearch DelegateSearch, FS
         return;
     }
 
-    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateSearch, InPath, InSearch, bSearchExact]()
+    // Matcher is immutable, all workers share it.
+    TSharedRef<const FFileConvertersMatcher, ESPMode::ThreadSafe> Matcher = MakeShared<const FFileConvertersMatcher, ESPMode::ThreadSafe>(Query);
+
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateSearch, InPath, Matcher]()
         {
-            IFileManager& FileManager = FFileManagerGeneric::Get();
+            // Indexed roots skip the walk. Query of a big root still takes a while, so it runs here instead of game thread.
+            TArray<FFolderContent> Array_IndexFounds;
+            if (FFileConvertersSearchIndex::Get().Query(InPath, *Matcher, Array_IndexFounds) == true)
+            {
+                AsyncTask(ENamedThreads::GameThread, [DelegateSearch, Array_IndexFounds = MoveTemp(Array_IndexFounds)]() mutable
+                    {
+                        FContentArrayContainer ArrayContainer;
+                        ArrayContainer.OutContents = MoveTemp(Array_IndexFounds);
 
-            TArray<FString> Array_Contents;
-            TArray<FFolderContent> Array_Founds;
-            
-            FileManager.FindFilesRecursive(Array_Contents, *InPath, TEXT("*"), true, true, false);
+                        DelegateSearch.ExecuteIfBound(true, "Success", ArrayContainer);
+                    }
+                );
+
+                return;
+            }
+
+            const int32 WorkerCount = FFileConvertersWalker::GetDefaultWorkerCount();
 
-            for (int32 ContentIndex = 0; ContentIndex < Array_Contents.Num(); ContentIndex++)
+            TArray<TArray<FFolderContent>> Array_WorkerFounds;
+            Array_WorkerFounds.SetNum(WorkerCount);
+
+            // Match time and count are summed per worker and recorded once, a metrics sample per name would cost more than the match.
+            TArray<FFileConvertersWorkerCycles> Array_MatchCycles;
+            Array_MatchCycles.SetNum(WorkerCount);
+
+            FFileConvertersWalker::Walk(InPath, WorkerCount, [&Array_WorkerFounds, &Array_MatchCycles, &Matcher](int32 WorkerIndex, const TCHAR* CharPath, const FFileStatData& StatData)
+                {
+                    const FStringView PathView(CharPath);
+                    const FStringView CleanName = FFileConvertersSearch::GetCleanName(PathView);
+                    TArray<FFolderContent>& WorkerFounds = Array_WorkerFounds[WorkerIndex];
+
+                    const uint64 MatchStart = FPlatformTime::Cycles64();
+                    int32 Score = 0;
+                    const bool bIsMatched = Matcher->Matches(CleanName, StatData.bIsDirectory, Score);
+                    FFileConvertersWorkerCycles& MatchCycles = Array_MatchCycles[WorkerIndex];
+                    MatchCycles.Cycles += FPlatformTime::Cycles64() - MatchStart;
+                    MatchCycles.Items++;
+
+                    // Strings are only built for entries which match and fit into the result limit.
+                    if (bIsMatched == false || Matcher->ShouldCollect(WorkerFounds, PathView, Score) == false)
+                    {
+                        return;
+                    }
+
+                    FFolderContent EachContent;
+                    EachContent.Name = FString(CleanName.Len(), CleanName.GetData());
+                    EachContent.Path = FString(PathView.Len(), PathView.GetData());
+                    EachContent.Score = Score;
+                    FFileConvertersSearch::SetStat(EachContent, StatData);
+
+                    Matcher->Collect(WorkerFounds, MoveTemp(EachContent));
+                }
+            );
+
+            FFileConvertersMetrics::Get().RecordCycles(EFileConvertersPhase::Match, Array_MatchCycles);
+
+            TArray<FFolderContent> Array_Founds;
+            for (TArray<FFolderContent>& EachWorkerFounds : Array_WorkerFounds)
             {
-                FFolderContent EachContent;
+                Array_Founds.Append(MoveTemp(EachWorkerFounds));
+            }
 
-                if (bSearchExact == true)
+            // Workers finish in any order, keep results stable between calls.
+            Matcher->Finish(Array_Founds);
+
+            AsyncTask(ENamedThreads::GameThread, [DelegateSearch, Array_Founds = MoveTemp(Array_Founds)]() mutable
                 {
-                    if (FPaths::GetBaseFilename(Array_Contents[ContentIndex]) == InSearch)
+                    FContentArrayContainer ArrayContainer;
+                    ArrayContainer.OutContents = MoveTemp(Array_Founds);
+
+                    DelegateSearch.ExecuteIfBound(true, "Success", ArrayContainer);
+                }
+            );
+        }
+    );
+}
+
+void UFileConvertersBPLibrary::SearchInFolderStreamed(FDelegateSearch DelegateSearch, FDelegateSearchProgress DelegateProgress, FString InPath, FString InSearch, bool bSearchExact)
+{
+    if (InPath.IsEmpty() == true)
+    {
+        DelegateSearch.ExecuteIfBound(false, "Path is empty.", FContentArrayContainer());
+        return;
+    }
+
+    if (InSearch.IsEmpty() == true)
+    {
+        DelegateSearch.ExecuteIfBound(false, "Search is empty.", FContentArrayContainer());
+        return;
+    }
+
+    if (FPaths::DirectoryExists(InPath) == false)
+    {
+        DelegateSearch.ExecuteIfBound(false, "Directory doesn't exist.", FContentArrayContainer());
+        return;
+    }
+
+    FFileSearchQuery Query;
+    Query.Pattern = InSearch;
+    Query.Mode = bSearchExact ? EFileSearchMode::Exact : EFileSearchMode::Substring;
+
+    TSharedRef<const FFileConvertersMatcher, ESPMode::ThreadSafe> Matcher = MakeShared<const FFileConvertersMatcher, ESPMode::ThreadSafe>(Query);
+
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateSearch, DelegateProgress, InPath, Matcher]()
+        {
+            // Index answers in one batch.
+            TArray<FFolderContent> Array_IndexFounds;
+            if (FFileConvertersSearchIndex::Get().Query(InPath, *Matcher, Array_IndexFounds) == true)
+            {
+                AsyncTask(ENamedThreads::GameThread, [DelegateSearch, DelegateProgress, Array_IndexFounds = MoveTemp(Array_IndexFounds)]() mutable
                     {
-                        EachContent.Name = FPaths::GetCleanFilename(Array_Contents[ContentIndex]);
-                        EachContent.Path = Array_Contents[ContentIndex];
-                        EachContent.bIsFile = FPaths::FileExists(Array_Contents[ContentIndex]);
+                        FContentArrayContainer ArrayContainer;
+                        ArrayContainer.OutContents = MoveTemp(Array_IndexFounds);
 
-                        Array_Founds.Add(EachContent);
+                        DelegateProgress.ExecuteIfBound(ArrayContainer);
+                        DelegateSearch.ExecuteIfBound(true, "Success", FContentArrayContainer());
                     }
-                }
+                );
 
-                else
+                return;
+            }
+
+            // A batch is sent when it is full or when it waited long enough, so first results show up quickly.
+            constexpr int32 BatchSize = 256;
+            constexpr double BatchInterval = 0.1;
+
+            struct FWorkerBatch
+            {
+                TArray<FFolderContent> Founds;
+                double LastSendTime = 0;
+            };
+
+            const int32 WorkerCount = FFileConvertersWalker::GetDefaultWorkerCount();
+
+            TArray<FWorkerBatch> Array_Batches;
+            Array_Batches.SetNum(WorkerCount);
+
+            TArray<FFileConvertersWorkerCycles> Array_MatchCycles;
+            Array_MatchCycles.SetNum(WorkerCount);
+
+            auto SendBatch = [&DelegateProgress](FWorkerBatch& Batch)
                 {
-                    if (FPaths::GetBaseFilename(Array_Contents[ContentIndex]).Contains(InSearch) == true)
+                    Batch.LastSendTime = FPlatformTime::Seconds();
+
+                    if (Batch.Founds.IsEmpty() == true)
                     {
-                        EachContent.Name = FPaths::GetCleanFilename(Array_Contents[ContentIndex]);
-                        EachContent.Path = Array_Contents[ContentIndex];
-                        EachContent.bIsFile = FPaths::FileExists(Array_Contents[ContentIndex]);
+                        return;
+                    }
 
-                        Array_Founds.Add(EachContent);
+                    AsyncTask(ENamedThreads::GameThread, [DelegateProgress, Array_Founds = MoveTemp(Batch.Founds)]() mutable
+                        {
+                            FContentArrayContainer ArrayContainer;
+                            ArrayContainer.OutContents = MoveTemp(Array_Founds);
+
+                            DelegateProgress.ExecuteIfBound(ArrayContainer);
+                        }
+                    );
+
+                    Batch.Founds.Reset();
+                };
+
+            FFileConvertersWalker::Walk(InPath, WorkerCount, [&Array_Batches, &Array_MatchCycles, &SendBatch, &Matcher](int32 WorkerIndex, const TCHAR* CharPath, const FFileStatData& StatData)
+                {
+                    FWorkerBatch& Batch = Array_Batches[WorkerIndex];
+                    const FStringView PathView(CharPath);
+                    const FStringView CleanName = FFileConvertersSearch::GetCleanName(PathView);
+
+                    const uint64 MatchStart = FPlatformTime::Cycles64();
+                    int32 Score = 0;
+                    const bool bIsMatched = Matcher->Matches(CleanName, StatData.bIsDirectory, Score);
+                    FFileConvertersWorkerCycles& MatchCycles = Array_MatchCycles[WorkerIndex];
+                    MatchCycles.Cycles += FPlatformTime::Cycles64() - MatchStart;
+                    MatchCycles.Items++;
+
+                    if (bIsMatched == true)
+                    {
+                        FFolderContent& EachContent = Batch.Founds.AddDefaulted_GetRef();
+                        EachContent.Name = FString(CleanName.Len(), CleanName.GetData());
+                        EachContent.Path = FString(PathView.Len(), PathView.GetData());
+                        FFileConvertersSearch::SetStat(EachContent, StatData);
+
+                        if (Batch.Founds.Num() >= BatchSize || FPlatformTime::Seconds() - Batch.LastSendTime >= BatchInterval)
+                        {
+                            SendBatch(Batch);
+                        }
                     }
                 }
+            );
+
+            for (FWorkerBatch& EachBatch : Array_Batches)
+            {
+                SendBatch(EachBatch);
             }
 
-            AsyncTask(ENamedThreads::GameThread, [DelegateSearch, Array_Founds]()
+            FFileConvertersMetrics::Get().RecordCycles(EFileConvertersPhase::Match, Array_MatchCycles);
+
+            // Game thread runs tasks in order, so this comes after all batches.
+            AsyncTask(ENamedThreads::GameThread, [DelegateSearch]()
                 {
-                    FContentArrayContainer ArrayContainer;
-                    ArrayContainer.OutContents = Array_Founds;
+                    DelegateSearch.ExecuteIfBound(true, "Success", FContentArrayContainer());
+                }
+            );
+        }
+    );
+}
 
-                    DelegateSearch.ExecuteIfBound(true, "Success", ArrayContainer);
+void UFileConvertersBPLibrary::RegisterSearchIndexRoot(FDelegateSearchIndex DelegateIndex, FString InRootPath, bool bRebuild)
+{
+    if (InRootPath.IsEmpty() == true)
+    {
+        DelegateIndex.ExecuteIfBound(false, "Path is empty.", FSearchIndexStats());
+        return;
+    }
+
+    if (FPaths::DirectoryExists(InRootPath) == false)
+    {
+        DelegateIndex.ExecuteIfBound(false, "Directory doesn't exist.", FSearchIndexStats());
+        return;
+    }
+
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [DelegateIndex, InRootPath, bRebuild]()
+        {
+            FSearchIndexStats Stats;
+            FString ErrorCode;
+            const bool bIsRegistered = FFileConvertersSearchIndex::Get().RegisterRoot(InRootPath, bRebuild, Stats, ErrorCode);
+
+            AsyncTask(ENamedThreads::GameThread, [DelegateIndex, bIsRegistered, ErrorCode, Stats]()
+                {
+                    DelegateIndex.ExecuteIfBound(bIsRegistered, ErrorCode, Stats);
                 }
             );
         }
     );
-}
\ No newline at end of file
+}
+
+void UFileConvertersBPLibrary::UnregisterSearchIndexRoot(FString InRootPath, bool bDeletePersisted)
+{
+    FFileConvertersSearchIndex::Get().UnregisterRoot(InRootPath, bDeletePersisted);
+}
+
+void UFileConvertersBPLibrary::GetSearchIndexStats(TArray<FSearchIndexStats>& OutStats)
+{
+    FFileConvertersSearchIndex::Get().GetStats(OutStats);
+}
+
+bool UFileConvertersBPLibrary::WatchFolder(FDelegateFolderChanges DelegateChanges, FString InPath, int32& OutWatchHandle, FString& ErrorCode)
+{
+    OutWatchHandle = INDEX_NONE;
+
+    if (InPath.IsEmpty() == true)
+    {
+        ErrorCode = "Path is empty.";
+        return false;
+    }
+
+    if (FPaths::DirectoryExists(InPath) == false)
+    {
+        ErrorCode = "Directory doesn't exist.";
+        return false;
+    }
+
+    OutWatchHandle = FFileConvertersWatcher::Get().Subscribe(DelegateChanges, InPath, ErrorCode);
+    return OutWatchHandle != INDEX_NONE;
+}
+
+void UFileConvertersBPLibrary::UnwatchFolder(int32 WatchHandle)
+{
+    FFileConvertersWatcher::Get().Unsubscribe(WatchHandle);
+}
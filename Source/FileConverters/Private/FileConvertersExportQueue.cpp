@@ -0,0 +1,588 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersExportQueue.h"
+#include "FileConvertersGLTF.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "Engine/Engine.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "Options/GLTFExportOptions.h"
+
+FFileConvertersExportQueue& FFileConvertersExportQueue::Get()
+{
+    static FFileConvertersExportQueue Queue;
+    return Queue;
+}
+
+int32 FFileConvertersExportQueue::QueueJob(const FGLBExportJob& Job, FDelegateGLBExport DelegateGLBExport)
+{
+    const FJobPtr NewJob = MakeShared<FJob, ESPMode::ThreadSafe>();
+    NewJob->JobHandle = NextJobHandle++;
+    NewJob->Descriptor = Job;
+    NewJob->Delegate = DelegateGLBExport;
+    NewJob->QueueTime = FPlatformTime::Seconds();
+
+    for (AActor* EachActor : Job.TargetActors)
+    {
+        NewJob->TargetActors.Add(EachActor);
+    }
+
+    NewJob->Descriptor.TargetActors.Empty();
+
+    {
+        FScopeLock Lock(&Guard);
+        Jobs.Add(NewJob->JobHandle, NewJob);
+        QueuedJobs.Add(NewJob);
+    }
+
+    if (TickerHandle.IsValid() == false)
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFileConvertersExportQueue::Tick));
+    }
+
+    return NewJob->JobHandle;
+}
+
+bool FFileConvertersExportQueue::CancelJob(int32 JobHandle)
+{
+    FJobPtr Job;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        const FJobPtr* FoundJob = Jobs.Find(JobHandle);
+
+        if (FoundJob == nullptr || ((*FoundJob)->State != EGLBExportJobState::Queued && (*FoundJob)->State != EGLBExportJobState::Running) || (*FoundJob)->bIsCancelRequested == true)
+        {
+            return false;
+        }
+
+        // File is already complete, ticker reports it as succeeded.
+        if ((*FoundJob)->bIsWorkerDone == true)
+        {
+            return false;
+        }
+
+        Job = *FoundJob;
+        Job->bIsCancelRequested = true;
+    }
+
+    // Queued jobs have no files yet. Running ones are finished by ticker after their worker stops.
+    if (Job->State == EGLBExportJobState::Queued)
+    {
+        QueuedJobs.Remove(Job);
+        FinishJob(Job, EGLBExportJobState::Cancelled);
+    }
+
+    return true;
+}
+
+EGLBExportJobState FFileConvertersExportQueue::GetProgress(int32 JobHandle, float& OutProgress) const
+{
+    OutProgress = 0;
+
+    FScopeLock Lock(&Guard);
+
+    const FJobPtr* FoundJob = Jobs.Find(JobHandle);
+
+    if (FoundJob == nullptr)
+    {
+        return EGLBExportJobState::Unknown;
+    }
+
+    const FJob& Job = **FoundJob;
+
+    // Finish step counts as one more part.
+    const int32 StepCount = Job.Parts.Num() + 1;
+    const int32 DoneCount = Job.AppendedPartCount + (Job.bIsWorkerDone ? 1 : 0);
+
+    OutProgress = Job.State == EGLBExportJobState::Succeeded ? 1.0f : Job.State == EGLBExportJobState::Queued ? 0.0f : FMath::Clamp(float(DoneCount) / float(StepCount), 0.0f, 1.0f);
+    return Job.State;
+}
+
+void FFileConvertersExportQueue::SetConcurrency(int32 InMaxRunningJobs, float InGameThreadBudgetMs)
+{
+    MaxRunningJobs = FMath::Max(InMaxRunningJobs, 1);
+    GameThreadBudgetMs = FMath::Max(InGameThreadBudgetMs, 0.0f);
+}
+
+FExportQueueStats FFileConvertersExportQueue::GetStats() const
+{
+    FExportQueueStats Stats;
+    Stats.QueuedJobCount = QueuedJobs.Num();
+    Stats.RunningJobCount = RunningJobs.Num();
+    Stats.SucceededJobCount = SucceededJobCount;
+    Stats.FailedJobCount = FailedJobCount;
+    Stats.CancelledJobCount = CancelledJobCount;
+    Stats.MaxRunningJobs = MaxRunningJobs;
+
+    return Stats;
+}
+
+void FFileConvertersExportQueue::Shutdown()
+{
+    if (TickerHandle.IsValid() == true)
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    // Workers hold their job, they stop at their next step and the job goes away with them.
+    FScopeLock Lock(&Guard);
+
+    for (const FJobPtr& EachJob : RunningJobs)
+    {
+        EachJob->bIsCancelRequested = true;
+    }
+
+    QueuedJobs.Empty();
+    RunningJobs.Empty();
+    FinishedHandles.Empty();
+    Jobs.Empty();
+}
+
+bool FFileConvertersExportQueue::Tick(float DeltaTime)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    while (RunningJobs.Num() < MaxRunningJobs && QueuedJobs.Num() > 0)
+    {
+        const FJobPtr Job = QueuedJobs[0];
+        QueuedJobs.RemoveAt(0);
+        RunningJobs.Add(Job);
+
+        StartJob(Job);
+    }
+
+    TArray<TPair<FJobPtr, EGLBExportJobState>> Array_Finished;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        for (const FJobPtr& EachJob : RunningJobs)
+        {
+            if (EachJob->bIsWorking == true)
+            {
+                continue;
+            }
+
+            // A finished file wins over a cancel which came after it, so a written file is never reported as cancelled.
+            if (EachJob->bIsWorkerDone == true)
+            {
+                Array_Finished.Emplace(EachJob, EGLBExportJobState::Succeeded);
+            }
+
+            else if (EachJob->bIsCancelRequested == true)
+            {
+                Array_Finished.Emplace(EachJob, EGLBExportJobState::Cancelled);
+            }
+
+            else if (EachJob->bIsExportFailed == true || EachJob->bIsWorkerFailed == true)
+            {
+                Array_Finished.Emplace(EachJob, EGLBExportJobState::Failed);
+            }
+        }
+    }
+
+    for (const TPair<FJobPtr, EGLBExportJobState>& EachFinished : Array_Finished)
+    {
+        RunningJobs.Remove(EachFinished.Key);
+        FinishJob(EachFinished.Key, EachFinished.Value);
+    }
+
+    // Round robin over running jobs, one part each, until frame budget is used. At least one part is exported per tick.
+    const double Deadline = StartTime + GameThreadBudgetMs / 1000.0;
+
+    while (RunningJobs.Num() > 0)
+    {
+        FJobPtr NextJob;
+
+        {
+            FScopeLock Lock(&Guard);
+
+            for (int32 Offset = 0; Offset < RunningJobs.Num(); Offset++)
+            {
+                const int32 JobIndex = (NextRoundRobin + Offset) % RunningJobs.Num();
+
+                if (CanExport(*RunningJobs[JobIndex]) == true)
+                {
+                    NextJob = RunningJobs[JobIndex];
+                    NextRoundRobin = JobIndex + 1;
+                    break;
+                }
+            }
+        }
+
+        if (NextJob.IsValid() == false)
+        {
+            break;
+        }
+
+        ExportNextPart(NextJob);
+
+        if (FPlatformTime::Seconds() >= Deadline)
+        {
+            break;
+        }
+    }
+
+    if (RunningJobs.Num() == 0 && QueuedJobs.Num() == 0)
+    {
+        TickerHandle.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+void FFileConvertersExportQueue::StartJob(const FJobPtr& Job)
+{
+    const FGLBExportJob& Descriptor = Job->Descriptor;
+
+    Job->State = EGLBExportJobState::Running;
+    Job->StartTime = FPlatformTime::Seconds();
+
+    if (FPaths::GetExtension(Descriptor.ExportPath).Equals(TEXT("glb"), ESearchCase::IgnoreCase) == false)
+    {
+        Job->Messages.Errors.Add(TEXT("Streamed export only writes .glb files."));
+        Job->bIsExportFailed = true;
+        return;
+    }
+
+    TSet<AActor*> TargetActors;
+
+    for (const TWeakObjectPtr<AActor>& EachActor : Job->TargetActors)
+    {
+        if (EachActor.IsValid() == true)
+        {
+            TargetActors.Add(EachActor.Get());
+        }
+    }
+
+    TArray<TSet<AActor*>> Array_Parts;
+    FFileConvertersGLTF::SplitByAttachRoot(TargetActors, Descriptor.ActorsPerPart, Array_Parts);
+
+    for (const TSet<AActor*>& EachPart : Array_Parts)
+    {
+        TArray<TWeakObjectPtr<AActor>>& Part = Job->Parts.AddDefaulted_GetRef();
+
+        for (AActor* EachActor : EachPart)
+        {
+            Part.Add(EachActor);
+        }
+    }
+
+    Job->TargetActors.Empty();
+    Job->ExportOptions.Reset(FFileConvertersGLTF::MakeExportOptions(Descriptor.bEnableQuantization));
+    Job->PartPrefix = FPaths::ProjectSavedDir() / TEXT("FileConverters/ExportParts") / FGuid::NewGuid().ToString();
+
+    Job->Writer = MakeUnique<FFileConvertersGLBWriter>(Descriptor.ExportPath);
+    Job->Writer->SetRootReset(Descriptor.bResetLocation, Descriptor.bResetRotation, Descriptor.bResetScale);
+    Job->Writer->SetOptimize(Descriptor.bInstanceAndDedupe);
+    Job->Writer->SetMeshOptimization(Descriptor.bOptimizeVertexCache, Descriptor.bMeshoptCompression);
+
+    // A job without parts still writes an empty scene.
+    if (Job->Parts.Num() == 0)
+    {
+        FScopeLock Lock(&Guard);
+        Job->bIsExportDone = true;
+        StartWorker(Job);
+    }
+}
+
+bool FFileConvertersExportQueue::CanExport(const FJob& Job)
+{
+    return Job.bIsCancelRequested == false && Job.bIsExportFailed == false && Job.bIsWorkerFailed == false && Job.PendingParts.Num() < MaxPendingParts && (Job.RetryParts.Num() > 0 || Job.NextPart < Job.Parts.Num());
+}
+
+void FFileConvertersExportQueue::ExportNextPart(const FJobPtr& Job)
+{
+    const double PartStartTime = FPlatformTime::Seconds();
+    const FGLBExportJob& Descriptor = Job->Descriptor;
+
+    int32 PartIndex = INDEX_NONE;
+    bool bCanUseCache = false;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        if (Job->RetryParts.Num() > 0)
+        {
+            PartIndex = Job->RetryParts.Pop(false);
+        }
+
+        else
+        {
+            PartIndex = Job->NextPart++;
+            bCanUseCache = Descriptor.bUseExportCache;
+        }
+    }
+
+    // Actors destroyed while job waited are skipped.
+    TSet<AActor*> PartActors;
+
+    for (const TWeakObjectPtr<AActor>& EachActor : Job->Parts[PartIndex])
+    {
+        if (EachActor.IsValid() == true)
+        {
+            PartActors.Add(EachActor.Get());
+        }
+    }
+
+    FPendingPart Pending;
+    Pending.PartIndex = PartIndex;
+
+    bool bIsExported = true;
+
+    if (PartActors.Num() > 0)
+    {
+        FFileConvertersExportCache& ExportCache = FFileConvertersExportCache::Get();
+
+        uint64 PartKey = 0;
+        const bool bIsCacheable = bCanUseCache == true && FFileConvertersExportCache::MakePartKey(PartActors, Descriptor.bEnableQuantization, PartKey) == true;
+
+        Pending.SourcePath = bIsCacheable ? ExportCache.Find(PartKey) : FString();
+        Pending.bIsCached = Pending.SourcePath.IsEmpty() == false;
+
+        if (Pending.bIsCached == true)
+        {
+            Job->CachedPartCount++;
+        }
+
+        else
+        {
+            Pending.PartPath = FString::Printf(TEXT("%s_%d.glb"), *Job->PartPrefix, PartIndex);
+
+            FGLTFExportMessages PartMessages;
+
+            {
+                FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+                bIsExported = UGLTFExporter::ExportToGLTF(GEngine->GetCurrentPlayWorld(), Pending.PartPath, Job->ExportOptions.Get(), PartActors, PartMessages);
+            }
+
+            Job->Messages.Suggestions.Append(PartMessages.Suggestions);
+            Job->Messages.Warnings.Append(PartMessages.Warnings);
+            Job->Messages.Errors.Append(PartMessages.Errors);
+
+            Pending.SourcePath = bIsExported && bIsCacheable ? ExportCache.Store(PartKey, Pending.PartPath) : FString();
+
+            if (Pending.SourcePath.IsEmpty() == true)
+            {
+                Pending.SourcePath = Pending.PartPath;
+            }
+        }
+    }
+
+    Job->GameThreadSeconds += FPlatformTime::Seconds() - PartStartTime;
+
+    if (bIsExported == false)
+    {
+        FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Pending.PartPath);
+    }
+
+    FScopeLock Lock(&Guard);
+
+    if (bIsExported == false)
+    {
+        Job->bIsExportFailed = true;
+        return;
+    }
+
+    if (Pending.SourcePath.IsEmpty() == false)
+    {
+        Job->PendingParts.Add(Pending);
+    }
+
+    Job->bIsExportDone = Job->NextPart >= Job->Parts.Num() && Job->RetryParts.Num() == 0;
+
+    StartWorker(Job);
+}
+
+void FFileConvertersExportQueue::StartWorker(const FJobPtr& Job)
+{
+    if (Job->bIsWorking == true || Job->bIsCancelRequested == true || Job->bIsWorkerFailed == true || Job->bIsWorkerDone == true)
+    {
+        return;
+    }
+
+    if (Job->PendingParts.Num() == 0 && Job->bIsExportDone == false)
+    {
+        return;
+    }
+
+    Job->bIsWorking = true;
+
+    // Merging is mostly file copies and mesh optimization, background threads keep it away from game work.
+    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Job]()
+        {
+            RunWorker(Job);
+        }
+    );
+}
+
+void FFileConvertersExportQueue::RunWorker(const FJobPtr& Job)
+{
+    while (true)
+    {
+        FPendingPart Part;
+        bool bIsFinishing = false;
+
+        {
+            FScopeLock Lock(&Guard);
+
+            if (Job->bIsCancelRequested == true || Job->bIsWorkerFailed == true)
+            {
+                Job->bIsWorking = false;
+                return;
+            }
+
+            if (Job->PendingParts.Num() > 0)
+            {
+                Part = Job->PendingParts[0];
+                Job->PendingParts.RemoveAt(0);
+            }
+
+            else if (Job->bIsExportDone == true)
+            {
+                bIsFinishing = true;
+            }
+
+            else
+            {
+                Job->bIsWorking = false;
+                return;
+            }
+        }
+
+        const double StepStartTime = FPlatformTime::Seconds();
+
+        FString ErrorCode;
+        bool bIsStepDone = false;
+
+        if (bIsFinishing == true)
+        {
+            bIsStepDone = Job->Writer->Finish(ErrorCode);
+        }
+
+        else
+        {
+            bIsStepDone = Job->Writer->AppendPart(Part.SourcePath, ErrorCode);
+
+            if (Part.PartPath.IsEmpty() == false)
+            {
+                FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Part.PartPath);
+            }
+        }
+
+        FScopeLock Lock(&Guard);
+
+        Job->WorkerSeconds += FPlatformTime::Seconds() - StepStartTime;
+
+        if (bIsFinishing == true)
+        {
+            Job->bIsWorkerDone = bIsStepDone;
+            Job->bIsWorkerFailed = bIsStepDone == false;
+            Job->WorkerError = ErrorCode;
+            Job->bIsWorking = false;
+            return;
+        }
+
+        if (bIsStepDone == true)
+        {
+            Job->AppendedPartCount++;
+        }
+
+        // Writer is unchanged when a part can't be read, so a broken cache entry is exported again.
+        else if (Part.bIsCached == true)
+        {
+            Job->RetryParts.Add(Part.PartIndex);
+            Job->bIsExportDone = false;
+        }
+
+        else
+        {
+            Job->bIsWorkerFailed = true;
+            Job->WorkerError = ErrorCode;
+        }
+    }
+}
+
+void FFileConvertersExportQueue::FinishJob(const FJobPtr& Job, EGLBExportJobState FinalState)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    FGLBExportStats ExportStats;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        for (const FPendingPart& EachPart : Job->PendingParts)
+        {
+            if (EachPart.PartPath.IsEmpty() == false)
+            {
+                PlatformFile.DeleteFile(*EachPart.PartPath);
+            }
+        }
+
+        Job->PendingParts.Empty();
+        Job->State = FinalState;
+
+        if (Job->WorkerError.IsEmpty() == false && Job->bIsWorkerFailed == true)
+        {
+            Job->Messages.Errors.Add(Job->WorkerError);
+        }
+
+        if (Job->Writer.IsValid() == true)
+        {
+            ExportStats = Job->Writer->GetStats();
+        }
+
+        ExportStats.WorkerSeconds = float(Job->WorkerSeconds);
+    }
+
+    if (FinalState == EGLBExportJobState::Cancelled)
+    {
+        Job->Messages.Errors.Add(TEXT("Export job was cancelled."));
+    }
+
+    // Writer removes its spool file.
+    Job->Writer.Reset();
+    Job->ExportOptions.Reset();
+    Job->Parts.Empty();
+
+    const double FinishTime = FPlatformTime::Seconds();
+    const double StartTime = Job->StartTime > 0 ? Job->StartTime : FinishTime;
+
+    ExportStats.PartCount = Job->NextPart;
+    ExportStats.CachedPartCount = Job->CachedPartCount;
+    ExportStats.QueueSeconds = float(StartTime - Job->QueueTime);
+    ExportStats.GameThreadSeconds = float(Job->GameThreadSeconds);
+    ExportStats.Seconds = float(FinishTime - StartTime);
+
+    SucceededJobCount += FinalState == EGLBExportJobState::Succeeded ? 1 : 0;
+    FailedJobCount += FinalState == EGLBExportJobState::Failed ? 1 : 0;
+    CancelledJobCount += FinalState == EGLBExportJobState::Cancelled ? 1 : 0;
+
+    FinishedHandles.Add(Job->JobHandle);
+    DropFinishedJobs();
+
+    AsyncTask(ENamedThreads::GameThread, [Delegate = Job->Delegate, bIsExportSuccessful = FinalState == EGLBExportJobState::Succeeded, ExportMessages = Job->Messages, ExportStats]()
+        {
+            Delegate.ExecuteIfBound(bIsExportSuccessful, ExportMessages, ExportStats);
+        }
+    );
+}
+
+void FFileConvertersExportQueue::DropFinishedJobs()
+{
+    FScopeLock Lock(&Guard);
+
+    while (FinishedHandles.Num() > MaxFinishedJobs)
+    {
+        Jobs.Remove(FinishedHandles[0]);
+        FinishedHandles.RemoveAt(0);
+    }
+}
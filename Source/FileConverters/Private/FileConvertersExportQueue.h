@@ -0,0 +1,137 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "Containers/Ticker.h"
+#include "UObject/StrongObjectPtr.h"
+
+class FFileConvertersGLBWriter;
+class UGLTFExportOptions;
+
+/*
+*	Queue of streamed GLB exports.
+*	A ticker exports parts on game thread, one part at a time while the frame budget lasts, round robin over running jobs.
+*	Exported parts are handed to the job's writer on a background task. Each job has at most one task, so running jobs bound worker use.
+*	Actors are never moved, reset options go to root nodes of each part like Keep Actors Untouched.
+*	Queue and job records are game thread only, the part hand-off between ticker and worker is guarded.
+*/
+class FFileConvertersExportQueue
+{
+public:
+
+	/* Parts a job may export ahead of its writer. Bounds temporary disk use. */
+	static constexpr int32 MaxPendingParts = 2;
+
+	/* Finished jobs kept for progress queries. */
+	static constexpr int32 MaxFinishedJobs = 64;
+
+	static FFileConvertersExportQueue& Get();
+
+	/* Returns job handle. */
+	int32 QueueJob(const FGLBExportJob& Job, FDelegateGLBExport DelegateGLBExport);
+
+	/* Returns false if job is unknown, already finished or its file is already written. */
+	bool CancelJob(int32 JobHandle);
+
+	EGLBExportJobState GetProgress(int32 JobHandle, float& OutProgress) const;
+
+	void SetConcurrency(int32 InMaxRunningJobs, float InGameThreadBudgetMs);
+	FExportQueueStats GetStats() const;
+
+	/* Called by module shutdown. Running jobs are cancelled without waiting for workers. */
+	void Shutdown();
+
+private:
+
+	struct FPendingPart
+	{
+		/* Exported part or export cache entry. */
+		FString SourcePath;
+
+		/* Temporary file to remove after merge, empty for cache entries. */
+		FString PartPath;
+
+		int32 PartIndex = INDEX_NONE;
+		bool bIsCached = false;
+	};
+
+	struct FJob
+	{
+		int32 JobHandle = INDEX_NONE;
+		FGLBExportJob Descriptor;
+		FDelegateGLBExport Delegate;
+		EGLBExportJobState State = EGLBExportJobState::Queued;
+
+		/* Game thread. Queued jobs don't keep actors alive. */
+		TArray<TWeakObjectPtr<AActor>> TargetActors;
+		TArray<TArray<TWeakObjectPtr<AActor>>> Parts;
+		int32 NextPart = 0;
+		int32 CachedPartCount = 0;
+		FString PartPrefix;
+		TStrongObjectPtr<UGLTFExportOptions> ExportOptions;
+		FGLTFExportMessages Messages;
+		bool bIsExportFailed = false;
+		double QueueTime = 0;
+		double StartTime = 0;
+		double GameThreadSeconds = 0;
+
+		/* Guarded by queue, worker owns writer while bIsWorking is set. */
+		TArray<FPendingPart> PendingParts;
+
+		/* Cached parts which couldn't be merged, exported again without cache. */
+		TArray<int32> RetryParts;
+
+		TUniquePtr<FFileConvertersGLBWriter> Writer;
+		bool bIsCancelRequested = false;
+		bool bIsExportDone = false;
+		bool bIsWorking = false;
+		bool bIsWorkerDone = false;
+		bool bIsWorkerFailed = false;
+		int32 AppendedPartCount = 0;
+		double WorkerSeconds = 0;
+		FString WorkerError;
+	};
+
+	using FJobPtr = TSharedPtr<FJob, ESPMode::ThreadSafe>;
+
+	bool Tick(float DeltaTime);
+
+	/* Game thread. Splits actors and prepares writer. */
+	void StartJob(const FJobPtr& Job);
+
+	/* Needs Guard. Job has a part to export and room for it. */
+	static bool CanExport(const FJob& Job);
+
+	/* Game thread. Exports next part and hands it to worker. */
+	void ExportNextPart(const FJobPtr& Job);
+
+	/* Needs Guard. Starts worker if job has pending parts or is ready to finish. */
+	void StartWorker(const FJobPtr& Job);
+
+	/* Worker thread. */
+	void RunWorker(const FJobPtr& Job);
+
+	/* Game thread. Removes temporary files, queues delegate and moves job to finished records. */
+	void FinishJob(const FJobPtr& Job, EGLBExportJobState FinalState);
+
+	void DropFinishedJobs();
+
+	mutable FCriticalSection Guard;
+	TMap<int32, FJobPtr> Jobs;
+	TArray<FJobPtr> QueuedJobs;
+	TArray<FJobPtr> RunningJobs;
+	TArray<int32> FinishedHandles;
+
+	int32 MaxRunningJobs = 2;
+	float GameThreadBudgetMs = 8.0f;
+	int32 NextJobHandle = 1;
+	int32 NextRoundRobin = 0;
+
+	int32 SucceededJobCount = 0;
+	int32 FailedJobCount = 0;
+	int32 CancelledJobCount = 0;
+
+	FTSTicker::FDelegateHandle TickerHandle;
+};
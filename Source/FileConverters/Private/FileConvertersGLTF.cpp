@@ -0,0 +1,2619 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersGLTF.h"
+#include "FileConvertersMeshopt.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "Async/ParallelFor.h"
+#include "Algo/AnyOf.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SceneComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Materials/MaterialInstance.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Options/GLTFExportOptions.h"
+#include "RHI.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "UObject/Package.h"
+#include "UObject/UnrealType.h"
+
+namespace FileConvertersGLTF
+{
+    static constexpr uint32 GLBMagic = 0x46546C67;           // "glTF"
+    static constexpr uint32 GLBVersion = 2;
+    static constexpr uint32 ChunkTypeJson = 0x4E4F534A;      // "JSON"
+    static constexpr uint32 ChunkTypeBinary = 0x004E4942;    // "BIN\0"
+    static constexpr int32 HeaderSize = 12;
+    static constexpr int32 ChunkHeaderSize = 8;
+
+    // Bump when anything changes in exported parts, old cache entries are never matched again.
+    static constexpr int32 ExportCacheVersion = 1;
+
+    // Sibling nodes sharing a mesh become one instanced node from this count on.
+    static constexpr int32 MinInstanceCount = 2;
+
+    static constexpr int32 ComponentTypeFloat = 5126;
+    static constexpr int32 ComponentTypeUnsignedShort = 5123;
+    static constexpr int32 ComponentTypeUnsignedInt = 5125;
+    static constexpr int32 ModeTriangles = 4;
+
+    /* Octree depth limit of tiled export. 8 levels are up to 16M cells. */
+    static constexpr int32 MaxTileDepth = 8;
+
+    static const TCHAR* MeshoptExtension = TEXT("EXT_meshopt_compression");
+
+    static const TCHAR* MergedArrayNames[] = { TEXT("accessors"), TEXT("animations"), TEXT("bufferViews"), TEXT("cameras"), TEXT("images"), TEXT("materials"), TEXT("meshes"), TEXT("nodes"), TEXT("samplers"), TEXT("skins"), TEXT("textures") };
+
+    static uint32 ReadUInt32(const uint8* Data)
+    {
+        return uint32(Data[0]) | (uint32(Data[1]) << 8) | (uint32(Data[2]) << 16) | (uint32(Data[3]) << 24);
+    }
+
+    static void WriteUInt32(TArray<uint8>& Out, uint32 Value)
+    {
+        Out.Add(uint8(Value));
+        Out.Add(uint8(Value >> 8));
+        Out.Add(uint8(Value >> 16));
+        Out.Add(uint8(Value >> 24));
+    }
+
+    static bool IsGLB(const FString& FilePath)
+    {
+        return FPaths::GetExtension(FilePath).Equals(TEXT("glb"), ESearchCase::IgnoreCase);
+    }
+
+    static bool ParseJson(const uint8* Data, int64 Length, TSharedPtr<FJsonObject>& OutJson)
+    {
+        const FUTF8ToTCHAR JsonText(reinterpret_cast<const ANSICHAR*>(Data), int32(Length));
+        const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::CreateFromView(FStringView(JsonText.Get(), JsonText.Length()));
+
+        return FJsonSerializer::Deserialize(JsonReader, OutJson) == true && OutJson.IsValid() == true;
+    }
+
+    static void SerializeJson(const TSharedRef<FJsonObject>& Json, TArray<uint8>& OutBytes)
+    {
+        FString JsonText;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&JsonText);
+        FJsonSerializer::Serialize(Json, JsonWriter);
+
+        const FTCHARToUTF8 JsonUTF8(*JsonText);
+        OutBytes.Append(reinterpret_cast<const uint8*>(JsonUTF8.Get()), JsonUTF8.Length());
+    }
+
+    static void RemapIndex(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, const TArray<int32>& Remap)
+    {
+        double Index = 0;
+
+        if (Object.IsValid() == true && Object->TryGetNumberField(Field, Index) == true && Remap.IsValidIndex(int32(Index)) == true)
+        {
+            Object->SetNumberField(Field, Remap[int32(Index)]);
+        }
+    }
+
+    static void RemapIndexArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, const TArray<int32>& Remap)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_Indices = nullptr;
+
+        if (Object.IsValid() == false || Object->TryGetArrayField(Field, Array_Indices) == false)
+        {
+            return;
+        }
+
+        // Indices without a mapping are dropped. Only node lists lose entries, when nodes are merged into instances.
+        TArray<TSharedPtr<FJsonValue>> Array_Remapped;
+        Array_Remapped.Reserve(Array_Indices->Num());
+
+        for (const TSharedPtr<FJsonValue>& EachIndex : *Array_Indices)
+        {
+            const int32 Index = int32(EachIndex->AsNumber());
+
+            if (Remap.IsValidIndex(Index) == true && Remap[Index] != INDEX_NONE)
+            {
+                Array_Remapped.Add(MakeShared<FJsonValueNumber>(Remap[Index]));
+            }
+        }
+
+        // Empty lists aren't valid glTF.
+        if (Array_Remapped.Num() == 0)
+        {
+            Object->RemoveField(Field);
+            return;
+        }
+
+        Object->SetArrayField(Field, Array_Remapped);
+    }
+
+    /* Every number field is an index. Used for primitive attributes and morph targets. */
+    static void RemapAllIndices(const TSharedPtr<FJsonObject>& Object, const TArray<int32>& Remap)
+    {
+        if (Object.IsValid() == false)
+        {
+            return;
+        }
+
+        for (TPair<FString, TSharedPtr<FJsonValue>>& EachField : Object->Values)
+        {
+            if (EachField.Value.IsValid() == true && EachField.Value->Type == EJson::Number && Remap.IsValidIndex(int32(EachField.Value->AsNumber())) == true)
+            {
+                EachField.Value = MakeShared<FJsonValueNumber>(Remap[int32(EachField.Value->AsNumber())]);
+            }
+        }
+    }
+
+    /* Texture infos are objects named "...Texture" with an index, in core material and in material extensions. */
+    static void RemapTextureInfos(const TSharedPtr<FJsonObject>& Object, const TArray<int32>& TextureRemap)
+    {
+        if (Object.IsValid() == false)
+        {
+            return;
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& EachField : Object->Values)
+        {
+            if (EachField.Value.IsValid() == false)
+            {
+                continue;
+            }
+
+            if (EachField.Value->Type == EJson::Object)
+            {
+                const TSharedPtr<FJsonObject> Child = EachField.Value->AsObject();
+
+                if (EachField.Key.EndsWith(TEXT("Texture"), ESearchCase::CaseSensitive) == true)
+                {
+                    RemapIndex(Child, TEXT("index"), TextureRemap);
+                }
+
+                RemapTextureInfos(Child, TextureRemap);
+            }
+
+            else if (EachField.Value->Type == EJson::Array)
+            {
+                for (const TSharedPtr<FJsonValue>& EachElement : EachField.Value->AsArray())
+                {
+                    if (EachElement.IsValid() == true && EachElement->Type == EJson::Object)
+                    {
+                        RemapTextureInfos(EachElement->AsObject(), TextureRemap);
+                    }
+                }
+            }
+        }
+    }
+
+    /* Condensed JSON of an object. Exporter writes fields in a fixed order, so equal objects give equal keys. */
+    static FString MakeObjectKey(const TSharedPtr<FJsonObject>& Object)
+    {
+        FString Key;
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Key);
+        FJsonSerializer::Serialize(Object.ToSharedRef(), JsonWriter);
+
+        return Key;
+    }
+
+    static int32 GetArrayNum(const TSharedRef<FJsonObject>& Object, const TCHAR* Field)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_Values = nullptr;
+        return Object->TryGetArrayField(Field, Array_Values) == true ? Array_Values->Num() : 0;
+    }
+
+    /* Bytes of one accessor element, 0 for unknown or matrix types. */
+    static int32 GetElementSize(int32 ComponentType, const FString& Type)
+    {
+        const int32 ComponentSize = ComponentType == 5120 || ComponentType == 5121 ? 1 : ComponentType == 5122 || ComponentType == 5123 ? 2 : ComponentType == 5125 || ComponentType == 5126 ? 4 : 0;
+        const int32 ComponentCount = Type == TEXT("SCALAR") ? 1 : Type == TEXT("VEC2") ? 2 : Type == TEXT("VEC3") ? 3 : Type == TEXT("VEC4") ? 4 : 0;
+
+        return ComponentSize * ComponentCount;
+    }
+
+    /* Reads a number array field into floats, or keeps defaults if field is missing. */
+    static void ReadFloats(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, TArray<float>& OutValues, std::initializer_list<float> Defaults)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_Values = nullptr;
+
+        if (Object->TryGetArrayField(Field, Array_Values) == true && Array_Values->Num() == int32(Defaults.size()))
+        {
+            for (const TSharedPtr<FJsonValue>& EachValue : *Array_Values)
+            {
+                OutValues.Add(float(EachValue->AsNumber()));
+            }
+        }
+
+        else
+        {
+            OutValues.Append(Defaults.begin(), int32(Defaults.size()));
+        }
+    }
+
+    static void ForEachObject(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, TFunctionRef<void(const TSharedPtr<FJsonObject>&)> Visitor)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_Values = nullptr;
+
+        if (Object.IsValid() == false || Object->TryGetArrayField(Field, Array_Values) == false)
+        {
+            return;
+        }
+
+        for (const TSharedPtr<FJsonValue>& EachValue : *Array_Values)
+        {
+            if (EachValue.IsValid() == true && EachValue->Type == EJson::Object)
+            {
+                Visitor(EachValue->AsObject());
+            }
+        }
+    }
+
+    static TSharedPtr<FJsonObject> GetObject(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+    {
+        const TSharedPtr<FJsonObject>* Child = nullptr;
+        return Object.IsValid() == true && Object->TryGetObjectField(Field, Child) == true ? *Child : nullptr;
+    }
+
+    static void AppendStrings(const TSharedRef<FJsonObject>& Object, const TCHAR* Field, TSet<FString>& OutStrings)
+    {
+        TArray<FString> Array_Strings;
+
+        if (Object->TryGetStringArrayField(Field, Array_Strings) == true)
+        {
+            OutStrings.Append(Array_Strings);
+        }
+    }
+
+    static void WriteStrings(const TSharedRef<FJsonObject>& Object, const TCHAR* Field, const TSet<FString>& Strings)
+    {
+        if (Strings.Num() == 0)
+        {
+            return;
+        }
+
+        TArray<TSharedPtr<FJsonValue>> Array_Values;
+
+        for (const FString& EachString : Strings)
+        {
+            Array_Values.Add(MakeShared<FJsonValueString>(EachString));
+        }
+
+        Object->SetArrayField(Field, Array_Values);
+    }
+
+    static bool CopyFileRange(IFileHandle& Source, IFileHandle& Dest, int64 Length, TArray<uint8>& CopyBuffer)
+    {
+        const int32 BufferSize = int32(FMath::Min<int64>(Length, FFileConvertersGLBWriter::CopyChunkSize));
+
+        if (CopyBuffer.Num() < BufferSize)
+        {
+            CopyBuffer.SetNumUninitialized(BufferSize);
+        }
+
+        while (Length > 0)
+        {
+            const int64 ChunkLength = FMath::Min<int64>(Length, CopyBuffer.Num());
+
+            if (Source.Read(CopyBuffer.GetData(), ChunkLength) == false || Dest.Write(CopyBuffer.GetData(), ChunkLength) == false)
+            {
+                return false;
+            }
+
+            Length -= ChunkLength;
+        }
+
+        return true;
+    }
+
+    /* Exported actors grouped by topmost ancestor which is also exported, in first seen order. */
+    static void GroupByAttachRoot(const TSet<AActor*>& Actors, TArray<TArray<AActor*>>& OutGroups)
+    {
+        TMap<AActor*, int32> GroupIndices;
+        OutGroups.Reset();
+
+        for (AActor* EachActor : Actors)
+        {
+            if (IsValid(EachActor) == false)
+            {
+                continue;
+            }
+
+            AActor* GroupRoot = EachActor;
+            for (AActor* EachParent = EachActor->GetAttachParentActor(); EachParent != nullptr; EachParent = EachParent->GetAttachParentActor())
+            {
+                if (Actors.Contains(EachParent) == true)
+                {
+                    GroupRoot = EachParent;
+                }
+            }
+
+            const int32* GroupIndex = GroupIndices.Find(GroupRoot);
+
+            if (GroupIndex == nullptr)
+            {
+                GroupIndex = &GroupIndices.Add(GroupRoot, OutGroups.Num());
+                OutGroups.AddDefaulted();
+            }
+
+            OutGroups[*GroupIndex].Add(EachActor);
+        }
+    }
+
+    /* LOD 0 triangles of static meshes, each instance counted. Other primitives count as one, so they still spread over tiles. */
+    static int64 CountTriangles(const AActor* Actor)
+    {
+        int64 TriangleCount = 0;
+
+        TInlineComponentArray<UPrimitiveComponent*> Array_Primitives(Actor);
+
+        for (const UPrimitiveComponent* EachPrimitive : Array_Primitives)
+        {
+            const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(EachPrimitive);
+            const UStaticMesh* StaticMesh = StaticMeshComponent ? StaticMeshComponent->GetStaticMesh() : nullptr;
+
+            if (StaticMesh == nullptr || StaticMesh->GetRenderData() == nullptr)
+            {
+                TriangleCount++;
+                continue;
+            }
+
+            const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(StaticMeshComponent);
+            const int64 InstanceCount = InstancedComponent ? InstancedComponent->GetInstanceCount() : 1;
+
+            TriangleCount += int64(StaticMesh->GetNumTriangles(0)) * InstanceCount;
+        }
+
+        return TriangleCount;
+    }
+
+    static bool WriteZeros(IFileHandle& Dest, int64 Count)
+    {
+        static const uint8 Zeros[4] = { 0, 0, 0, 0 };
+        return Count <= 0 || Dest.Write(Zeros, Count);
+    }
+}
+
+UGLTFExportOptions* FFileConvertersGLTF::MakeExportOptions(bool bEnableQuantization)
+{
+    UGLTFExportOptions* ExportOptions = NewObject<UGLTFExportOptions>();
+    ExportOptions->ResetToDefault();
+    ExportOptions->bExportProxyMaterials = true;
+    ExportOptions->bExportVertexColors = true;
+    ExportOptions->bUseMeshQuantization = bEnableQuantization;
+
+    return ExportOptions;
+}
+
+void FFileConvertersGLTF::SplitByAttachRoot(const TSet<AActor*>& Actors, int32 ActorsPerPart, TArray<TSet<AActor*>>& OutParts)
+{
+    ActorsPerPart = FMath::Max(ActorsPerPart, 1);
+
+    TArray<TArray<AActor*>> Array_Groups;
+    FileConvertersGLTF::GroupByAttachRoot(Actors, Array_Groups);
+
+    OutParts.Reset();
+
+    for (const TArray<AActor*>& EachGroup : Array_Groups)
+    {
+        if (OutParts.Num() == 0 || OutParts.Last().Num() >= ActorsPerPart)
+        {
+            OutParts.AddDefaulted();
+        }
+
+        OutParts.Last().Append(EachGroup);
+    }
+}
+
+void FFileConvertersGLTF::SplitBySpace(const TSet<AActor*>& Actors, int64 MaxTrianglesPerTile, TArray<FFileConvertersTile>& OutTiles)
+{
+    using namespace FileConvertersGLTF;
+
+    OutTiles.Reset();
+
+    TArray<TArray<AActor*>> Array_Groups;
+    GroupByAttachRoot(Actors, Array_Groups);
+
+    TArray<FBox> Array_GroupBounds;
+    TArray<int64> Array_GroupTriangles;
+
+    for (const TArray<AActor*>& EachGroup : Array_Groups)
+    {
+        FBox GroupBounds(ForceInit);
+        int64 GroupTriangles = 0;
+
+        for (AActor* EachActor : EachGroup)
+        {
+            const FBox ActorBounds = EachActor->GetComponentsBoundingBox(true);
+            GroupBounds += ActorBounds.IsValid ? ActorBounds : FBox(EachActor->GetActorLocation(), EachActor->GetActorLocation());
+            GroupTriangles += CountTriangles(EachActor);
+        }
+
+        Array_GroupBounds.Add(GroupBounds);
+        Array_GroupTriangles.Add(GroupTriangles);
+    }
+
+    // Cells waiting to be split, as group indices and depth.
+    TArray<TPair<TArray<int32>, int32>> Array_Cells;
+    Array_Cells.AddDefaulted_GetRef().Key.Reserve(Array_Groups.Num());
+
+    for (int32 GroupIndex = 0; GroupIndex < Array_Groups.Num(); GroupIndex++)
+    {
+        Array_Cells[0].Key.Add(GroupIndex);
+    }
+
+    while (Array_Cells.Num() > 0)
+    {
+        const TPair<TArray<int32>, int32> Cell = Array_Cells.Pop(false);
+
+        if (Cell.Key.Num() == 0)
+        {
+            continue;
+        }
+
+        int64 CellTriangles = 0;
+        FBox CenterBounds(ForceInit);
+
+        for (const int32 EachGroupIndex : Cell.Key)
+        {
+            CellTriangles += Array_GroupTriangles[EachGroupIndex];
+            CenterBounds += Array_GroupBounds[EachGroupIndex].GetCenter();
+        }
+
+        TArray<int32> Array_Children[8];
+
+        if (CellTriangles > MaxTrianglesPerTile && Cell.Key.Num() > 1 && Cell.Value < MaxTileDepth)
+        {
+            const FVector Pivot = CenterBounds.GetCenter();
+
+            for (const int32 EachGroupIndex : Cell.Key)
+            {
+                const FVector Center = Array_GroupBounds[EachGroupIndex].GetCenter();
+                const int32 Octant = (Center.X > Pivot.X ? 1 : 0) | (Center.Y > Pivot.Y ? 2 : 0) | (Center.Z > Pivot.Z ? 4 : 0);
+                Array_Children[Octant].Add(EachGroupIndex);
+            }
+        }
+
+        // Groups with same center can't be split, they stay as one tile over budget.
+        const bool bIsSplit = Array_Children[0].Num() < Cell.Key.Num() && Algo::AnyOf(Array_Children, [](const TArray<int32>& Child) { return Child.Num() > 0; });
+
+        if (bIsSplit == true)
+        {
+            for (int32 Octant = 7; Octant >= 0; Octant--)
+            {
+                Array_Cells.Emplace(MoveTemp(Array_Children[Octant]), Cell.Value + 1);
+            }
+
+            continue;
+        }
+
+        FFileConvertersTile& Tile = OutTiles.AddDefaulted_GetRef();
+        Tile.TriangleCount = CellTriangles;
+
+        for (const int32 EachGroupIndex : Cell.Key)
+        {
+            Tile.Actors.Append(Array_Groups[EachGroupIndex]);
+            Tile.Bounds += Array_GroupBounds[EachGroupIndex];
+        }
+    }
+}
+
+bool FFileConvertersGLTF::WriteTileset(const FString& FilePath, const TArray<FFileConvertersTile>& Tiles, const TArray<FString>& TileUris, float ExportScale, FString& ErrorCode)
+{
+    FILECONVERTERS_PHASE_SCOPE(FileWrite);
+
+    using namespace FileConvertersGLTF;
+
+    // Exporter turns UE (X, Y, Z) into glTF (X, Z, Y), tileset Z up turns glTF (X, Y, Z) into (X, -Z, Y).
+    auto MakeBoundingVolume = [ExportScale](const FBox& Bounds)
+        {
+            const FVector Center = Bounds.GetCenter() * ExportScale;
+            const FVector Extent = Bounds.GetExtent() * ExportScale;
+
+            const TArray<double> Array_Box = { Center.X, -Center.Y, Center.Z, Extent.X, 0, 0, 0, Extent.Y, 0, 0, 0, Extent.Z };
+            TArray<TSharedPtr<FJsonValue>> Array_BoxValues;
+
+            for (const double EachValue : Array_Box)
+            {
+                Array_BoxValues.Add(MakeShared<FJsonValueNumber>(EachValue));
+            }
+
+            const TSharedRef<FJsonObject> BoundingVolume = MakeShared<FJsonObject>();
+            BoundingVolume->SetArrayField(TEXT("box"), Array_BoxValues);
+            return BoundingVolume;
+        };
+
+    FBox RootBounds(ForceInit);
+    TArray<TSharedPtr<FJsonValue>> Array_Children;
+
+    for (int32 TileIndex = 0; TileIndex < Tiles.Num(); TileIndex++)
+    {
+        RootBounds += Tiles[TileIndex].Bounds;
+
+        const TSharedRef<FJsonObject> Content = MakeShared<FJsonObject>();
+        Content->SetStringField(TEXT("uri"), TileUris[TileIndex]);
+
+        const TSharedRef<FJsonObject> Extras = MakeShared<FJsonObject>();
+        Extras->SetNumberField(TEXT("triangleCount"), double(Tiles[TileIndex].TriangleCount));
+        Extras->SetNumberField(TEXT("actorCount"), Tiles[TileIndex].Actors.Num());
+
+        const TSharedRef<FJsonObject> Child = MakeShared<FJsonObject>();
+        Child->SetObjectField(TEXT("boundingVolume"), MakeBoundingVolume(Tiles[TileIndex].Bounds));
+        Child->SetNumberField(TEXT("geometricError"), 0);
+        Child->SetObjectField(TEXT("content"), Content);
+        Child->SetObjectField(TEXT("extras"), Extras);
+
+        Array_Children.Add(MakeShared<FJsonValueObject>(Child));
+    }
+
+    if (RootBounds.IsValid == false)
+    {
+        RootBounds = FBox(FVector::ZeroVector, FVector::ZeroVector);
+    }
+
+    // Root has no content of its own. Its error is its size, so clients refine into tiles once root is on screen.
+    const double RootError = RootBounds.GetSize().Size() * ExportScale;
+
+    const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetObjectField(TEXT("boundingVolume"), MakeBoundingVolume(RootBounds));
+    Root->SetNumberField(TEXT("geometricError"), RootError);
+    Root->SetStringField(TEXT("refine"), TEXT("ADD"));
+    Root->SetArrayField(TEXT("children"), Array_Children);
+
+    const TSharedRef<FJsonObject> Asset = MakeShared<FJsonObject>();
+    Asset->SetStringField(TEXT("version"), TEXT("1.1"));
+    Asset->SetStringField(TEXT("generator"), TEXT("FileConverters"));
+
+    const TSharedRef<FJsonObject> Tileset = MakeShared<FJsonObject>();
+    Tileset->SetObjectField(TEXT("asset"), Asset);
+    Tileset->SetNumberField(TEXT("geometricError"), RootError);
+    Tileset->SetObjectField(TEXT("root"), Root);
+
+    TArray<uint8> JsonBytes;
+    SerializeJson(Tileset, JsonBytes);
+
+    PhaseScope_FileWrite.AddBytes(JsonBytes.Num());
+    PhaseScope_FileWrite.AddItems(1);
+
+    if (FFileHelper::SaveArrayToFile(JsonBytes, *FilePath) == false)
+    {
+        ErrorCode = "Tileset file can't be written.";
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+void FFileConvertersGLTF::AccumulateStats(FGLBExportStats& Total, const FGLBExportStats& Stats)
+{
+    Total.PartCount += Stats.PartCount;
+    Total.CachedPartCount += Stats.CachedPartCount;
+    Total.SourceBytes += Stats.SourceBytes;
+    Total.OutputBytes += Stats.OutputBytes;
+    Total.SourceNodeCount += Stats.SourceNodeCount;
+    Total.OutputNodeCount += Stats.OutputNodeCount;
+    Total.InstancedNodeCount += Stats.InstancedNodeCount;
+    Total.InstanceGroupCount += Stats.InstanceGroupCount;
+    Total.SourceMeshCount += Stats.SourceMeshCount;
+    Total.OutputMeshCount += Stats.OutputMeshCount;
+    Total.SourceMaterialCount += Stats.SourceMaterialCount;
+    Total.OutputMaterialCount += Stats.OutputMaterialCount;
+    Total.SourceImageCount += Stats.SourceImageCount;
+    Total.OutputImageCount += Stats.OutputImageCount;
+    Total.OptimizedPrimitiveCount += Stats.OptimizedPrimitiveCount;
+    Total.CompressedViewCount += Stats.CompressedViewCount;
+    Total.QueueSeconds += Stats.QueueSeconds;
+    Total.GameThreadSeconds += Stats.GameThreadSeconds;
+    Total.WorkerSeconds += Stats.WorkerSeconds;
+    Total.Seconds += Stats.Seconds;
+}
+
+void FFileConvertersTransformSnapshot::Capture(const TSet<AActor*>& Actors)
+{
+    FILECONVERTERS_PHASE_SCOPE(TransformSnapshot);
+
+    Components.Reset(Actors.Num());
+    AttachDepths.Reset(Actors.Num());
+    RelativeLocations.Reset(Actors.Num());
+    RelativeRotations.Reset(Actors.Num());
+    RelativeScales.Reset(Actors.Num());
+    MaxAttachDepth = 0;
+
+    for (AActor* EachActor : Actors)
+    {
+        USceneComponent* RootComponent = IsValid(EachActor) ? EachActor->GetRootComponent() : nullptr;
+
+        if (RootComponent == nullptr)
+        {
+            continue;
+        }
+
+        int32 AttachDepth = 0;
+        for (const USceneComponent* EachParent = RootComponent->GetAttachParent(); EachParent != nullptr; EachParent = EachParent->GetAttachParent())
+        {
+            AttachDepth++;
+        }
+
+        Components.Add(RootComponent);
+        AttachDepths.Add(AttachDepth);
+        RelativeLocations.Add(RootComponent->GetRelativeLocation());
+        RelativeRotations.Add(RootComponent->GetRelativeRotation());
+        RelativeScales.Add(RootComponent->GetRelativeScale3D());
+        MaxAttachDepth = FMath::Max(MaxAttachDepth, AttachDepth);
+    }
+}
+
+void FFileConvertersTransformSnapshot::Reset(bool bResetLocation, bool bResetRotation, bool bResetScale) const
+{
+    FILECONVERTERS_PHASE_SCOPE(TransformSnapshot);
+
+    if (bResetLocation == false && bResetRotation == false && bResetScale == false)
+    {
+        return;
+    }
+
+    // Moving a parent moves its attached children, so each depth is reset after the one above it.
+    for (int32 Depth = 0; Depth <= MaxAttachDepth; Depth++)
+    {
+        for (int32 Index = 0; Index < Components.Num(); Index++)
+        {
+            if (AttachDepths[Index] != Depth)
+            {
+                continue;
+            }
+
+            // One world transform update for each component instead of one per reset channel.
+            FTransform WorldTransform = Components[Index]->GetComponentTransform();
+
+            if (bResetLocation == true)
+            {
+                WorldTransform.SetLocation(FVector::ZeroVector);
+            }
+
+            if (bResetRotation == true)
+            {
+                WorldTransform.SetRotation(FQuat::Identity);
+            }
+
+            if (bResetScale == true)
+            {
+                WorldTransform.SetScale3D(FVector::OneVector);
+            }
+
+            Components[Index]->SetWorldTransform(WorldTransform, false, nullptr, ETeleportType::TeleportPhysics);
+        }
+    }
+}
+
+void FFileConvertersTransformSnapshot::Restore() const
+{
+    FILECONVERTERS_PHASE_SCOPE(TransformSnapshot);
+
+    for (int32 Index = 0; Index < Components.Num(); Index++)
+    {
+        Components[Index]->SetRelativeTransform(FTransform(RelativeRotations[Index], RelativeLocations[Index], RelativeScales[Index]), false, nullptr, ETeleportType::TeleportPhysics);
+    }
+}
+
+bool FFileConvertersGLTF::ParseGLB(const TArray<uint8>& FileBytes, TSharedPtr<FJsonObject>& OutJson, TArray<uint8>& OutBinary, FString& ErrorCode)
+{
+    using namespace FileConvertersGLTF;
+
+    OutBinary.Reset();
+
+    if (FileBytes.Num() < HeaderSize + ChunkHeaderSize || ReadUInt32(FileBytes.GetData()) != GLBMagic || ReadUInt32(FileBytes.GetData() + 4) != GLBVersion)
+    {
+        ErrorCode = "File is not a GLB 2.0 file.";
+        return false;
+    }
+
+    const int64 FileLength = FMath::Min<int64>(ReadUInt32(FileBytes.GetData() + 8), FileBytes.Num());
+    int64 Cursor = HeaderSize;
+
+    while (Cursor + ChunkHeaderSize <= FileLength)
+    {
+        const int64 ChunkLength = ReadUInt32(FileBytes.GetData() + Cursor);
+        const uint32 ChunkType = ReadUInt32(FileBytes.GetData() + Cursor + 4);
+        const int64 ChunkStart = Cursor + ChunkHeaderSize;
+
+        if (ChunkStart + ChunkLength > FileLength)
+        {
+            ErrorCode = "GLB chunk exceeds file length.";
+            return false;
+        }
+
+        if (ChunkType == ChunkTypeJson && OutJson.IsValid() == false)
+        {
+            if (ParseJson(FileBytes.GetData() + ChunkStart, ChunkLength, OutJson) == false)
+            {
+                ErrorCode = "GLB JSON chunk can't be parsed.";
+                return false;
+            }
+        }
+
+        else if (ChunkType == ChunkTypeBinary && OutBinary.Num() == 0)
+        {
+            OutBinary.Append(FileBytes.GetData() + ChunkStart, int32(ChunkLength));
+        }
+
+        // Chunks are 4 byte aligned. Unknown chunk types are skipped.
+        Cursor = ChunkStart + Align(ChunkLength, 4);
+    }
+
+    if (OutJson.IsValid() == false)
+    {
+        ErrorCode = "GLB doesn't have a JSON chunk.";
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+void FFileConvertersGLTF::WriteGLB(const TSharedRef<FJsonObject>& Json, const TArray<uint8>& Binary, TArray<uint8>& OutFileBytes)
+{
+    using namespace FileConvertersGLTF;
+
+    TArray<uint8> JsonBytes;
+    SerializeJson(Json, JsonBytes);
+
+    // JSON is padded with spaces, binary with zeros.
+    const int32 JsonLength = Align(JsonBytes.Num(), 4);
+    const int32 BinaryLength = Align(Binary.Num(), 4);
+    const int32 TotalLength = HeaderSize + ChunkHeaderSize + JsonLength + (Binary.Num() > 0 ? ChunkHeaderSize + BinaryLength : 0);
+
+    OutFileBytes.Reset(TotalLength);
+    WriteUInt32(OutFileBytes, GLBMagic);
+    WriteUInt32(OutFileBytes, GLBVersion);
+    WriteUInt32(OutFileBytes, TotalLength);
+
+    WriteUInt32(OutFileBytes, JsonLength);
+    WriteUInt32(OutFileBytes, ChunkTypeJson);
+    OutFileBytes.Append(JsonBytes);
+
+    for (int32 PaddingIndex = JsonBytes.Num(); PaddingIndex < JsonLength; PaddingIndex++)
+    {
+        OutFileBytes.Add(' ');
+    }
+
+    if (Binary.Num() > 0)
+    {
+        WriteUInt32(OutFileBytes, BinaryLength);
+        WriteUInt32(OutFileBytes, ChunkTypeBinary);
+        OutFileBytes.Append(Binary);
+        OutFileBytes.AddZeroed(BinaryLength - Binary.Num());
+    }
+}
+
+bool FFileConvertersGLTF::LoadFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutJson, TArray<uint8>& OutBinary, FString& ErrorCode)
+{
+    TArray<uint8> FileBytes;
+
+    if (FFileHelper::LoadFileToArray(FileBytes, *FilePath, FILEREAD_Silent) == false)
+    {
+        ErrorCode = "Exported file can't be read.";
+        return false;
+    }
+
+    if (FileConvertersGLTF::IsGLB(FilePath) == true)
+    {
+        return ParseGLB(FileBytes, OutJson, OutBinary, ErrorCode);
+    }
+
+    // Plain glTF keeps buffers in separate files, only JSON is loaded.
+    OutBinary.Reset();
+
+    if (FileConvertersGLTF::ParseJson(FileBytes.GetData(), FileBytes.Num(), OutJson) == false)
+    {
+        ErrorCode = "glTF JSON can't be parsed.";
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+bool FFileConvertersGLTF::SaveFile(const FString& FilePath, const TSharedRef<FJsonObject>& Json, const TArray<uint8>& Binary, FString& ErrorCode)
+{
+    FILECONVERTERS_PHASE_SCOPE(FileWrite);
+
+    TArray<uint8> FileBytes;
+
+    if (FileConvertersGLTF::IsGLB(FilePath) == true)
+    {
+        WriteGLB(Json, Binary, FileBytes);
+    }
+
+    else
+    {
+        FileConvertersGLTF::SerializeJson(Json, FileBytes);
+    }
+
+    PhaseScope_FileWrite.AddBytes(FileBytes.Num());
+    PhaseScope_FileWrite.AddItems(1);
+
+    if (FFileHelper::SaveArrayToFile(FileBytes, *FilePath) == false)
+    {
+        ErrorCode = "Exported file can't be written.";
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+void FFileConvertersGLTF::ResetRootNodes(const TSharedRef<FJsonObject>& Json, bool bResetLocation, bool bResetRotation, bool bResetScale)
+{
+    const TArray<TSharedPtr<FJsonValue>>* Array_Nodes = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* Array_Scenes = nullptr;
+
+    // Nothing was exported, there is nothing to reset.
+    if (Json->TryGetArrayField(TEXT("nodes"), Array_Nodes) == false || Json->TryGetArrayField(TEXT("scenes"), Array_Scenes) == false)
+    {
+        return;
+    }
+
+    for (const TSharedPtr<FJsonValue>& EachScene : *Array_Scenes)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_RootIndices = nullptr;
+
+        if (EachScene.IsValid() == false || EachScene->AsObject().IsValid() == false || EachScene->AsObject()->TryGetArrayField(TEXT("nodes"), Array_RootIndices) == false)
+        {
+            continue;
+        }
+
+        for (const TSharedPtr<FJsonValue>& EachRootIndex : *Array_RootIndices)
+        {
+            const int32 NodeIndex = int32(EachRootIndex->AsNumber());
+
+            if (Array_Nodes->IsValidIndex(NodeIndex) == false)
+            {
+                continue;
+            }
+
+            const TSharedPtr<FJsonObject> Node = (*Array_Nodes)[NodeIndex]->AsObject();
+
+            if (Node.IsValid() == false)
+            {
+                continue;
+            }
+
+            // Missing TRS properties mean identity in glTF.
+            if (bResetLocation == true)
+            {
+                Node->RemoveField(TEXT("translation"));
+            }
+
+            if (bResetRotation == true)
+            {
+                Node->RemoveField(TEXT("rotation"));
+            }
+
+            if (bResetScale == true)
+            {
+                Node->RemoveField(TEXT("scale"));
+            }
+        }
+    }
+}
+
+bool FFileConvertersGLTF::OverrideRootTransforms(const FString& FilePath, bool bResetLocation, bool bResetRotation, bool bResetScale, FString& ErrorCode)
+{
+    if (bResetLocation == false && bResetRotation == false && bResetScale == false)
+    {
+        ErrorCode = "Success";
+        return true;
+    }
+
+    TSharedPtr<FJsonObject> Json;
+    TArray<uint8> Binary;
+
+    if (LoadFile(FilePath, Json, Binary, ErrorCode) == false)
+    {
+        return false;
+    }
+
+    ResetRootNodes(Json.ToSharedRef(), bResetLocation, bResetRotation, bResetScale);
+
+    return SaveFile(FilePath, Json.ToSharedRef(), Binary, ErrorCode);
+}
+
+FFileConvertersGLBWriter::FFileConvertersGLBWriter(const FString& InOutputPath)
+    : OutputPath(InOutputPath)
+    , SpoolPath(InOutputPath + TEXT(".bin.tmp"))
+{
+    // All arrays exist up front, so references returned by GetArray stay valid.
+    for (const TCHAR* EachName : FileConvertersGLTF::MergedArrayNames)
+    {
+        MergedArrays.Add(EachName);
+    }
+}
+
+FFileConvertersGLBWriter::~FFileConvertersGLBWriter()
+{
+    Spool.Reset();
+    FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*SpoolPath);
+}
+
+void FFileConvertersGLBWriter::SetRootReset(bool bInResetLocation, bool bInResetRotation, bool bInResetScale)
+{
+    bResetLocation = bInResetLocation;
+    bResetRotation = bInResetRotation;
+    bResetScale = bInResetScale;
+}
+
+void FFileConvertersGLBWriter::SetOptimize(bool bInOptimize)
+{
+    bOptimize = bInOptimize;
+}
+
+void FFileConvertersGLBWriter::SetMeshOptimization(bool bInReorderVertices, bool bInCompressMeshes)
+{
+    bReorderVertices = bInReorderVertices;
+    bCompressMeshes = bInCompressMeshes;
+}
+
+TArray<TSharedPtr<FJsonValue>>& FFileConvertersGLBWriter::GetArray(const TCHAR* Name)
+{
+    return MergedArrays.FindChecked(Name);
+}
+
+bool FFileConvertersGLBWriter::ReadPartHeader(IFileHandle& PartHandle, TSharedPtr<FJsonObject>& OutJson, int64& OutBinaryLength, FString& ErrorCode)
+{
+    using namespace FileConvertersGLTF;
+
+    OutBinaryLength = 0;
+
+    uint8 Header[HeaderSize + ChunkHeaderSize];
+
+    if (PartHandle.Read(Header, sizeof(Header)) == false || ReadUInt32(Header) != GLBMagic || ReadUInt32(Header + 4) != GLBVersion || ReadUInt32(Header + 16) != ChunkTypeJson)
+    {
+        ErrorCode = "Export part is not a GLB 2.0 file.";
+        return false;
+    }
+
+    const int64 FileLength = ReadUInt32(Header + 8);
+    const int64 JsonLength = ReadUInt32(Header + 12);
+
+    TArray<uint8> JsonBytes;
+    JsonBytes.SetNumUninitialized(int32(JsonLength));
+
+    if (PartHandle.Read(JsonBytes.GetData(), JsonLength) == false || ParseJson(JsonBytes.GetData(), JsonLength, OutJson) == false)
+    {
+        ErrorCode = "JSON chunk of export part can't be parsed.";
+        return false;
+    }
+
+    // Binary chunk is optional and always second.
+    if (HeaderSize + ChunkHeaderSize + JsonLength + ChunkHeaderSize <= FileLength)
+    {
+        uint8 ChunkHeader[ChunkHeaderSize];
+
+        if (PartHandle.Read(ChunkHeader, ChunkHeaderSize) == true && ReadUInt32(ChunkHeader + 4) == ChunkTypeBinary)
+        {
+            OutBinaryLength = ReadUInt32(ChunkHeader);
+        }
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+bool FFileConvertersGLBWriter::OpenSpool(FString& ErrorCode)
+{
+    if (Spool.IsValid() == false)
+    {
+        Spool.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*SpoolPath));
+
+        if (Spool.IsValid() == false)
+        {
+            ErrorCode = "Spool file can't be created.";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool FFileConvertersGLBWriter::AppendPart(const FString& PartPath, FString& ErrorCode)
+{
+    FILECONVERTERS_PHASE_SCOPE(FileWrite);
+
+    if (bIsFailed == true)
+    {
+        ErrorCode = "Writer failed on an earlier part.";
+        return false;
+    }
+
+    TUniquePtr<IFileHandle> PartHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*PartPath));
+
+    if (PartHandle.IsValid() == false)
+    {
+        ErrorCode = "Export part can't be opened.";
+        return false;
+    }
+
+    PhaseScope_FileWrite.AddBytes(PartHandle->Size());
+    PhaseScope_FileWrite.AddItems(1);
+
+    TSharedPtr<FJsonObject> PartJson;
+    int64 PartBinaryLength = 0;
+
+    if (ReadPartHeader(*PartHandle, PartJson, PartBinaryLength, ErrorCode) == false)
+    {
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* Array_Buffers = nullptr;
+    if (PartJson->TryGetArrayField(TEXT("buffers"), Array_Buffers) == true)
+    {
+        if (Array_Buffers->Num() > 1 || (Array_Buffers->Num() == 1 && (*Array_Buffers)[0]->AsObject()->HasField(TEXT("uri")) == true))
+        {
+            ErrorCode = "Export part has external buffers.";
+            return false;
+        }
+    }
+
+    if (OpenSpool(ErrorCode) == false)
+    {
+        return false;
+    }
+
+    // Failures above leave writer untouched, so caller can retry the part from another source. From here on a failure spoils merged output.
+    const TSharedRef<FJsonObject> PartJsonRef = PartJson.ToSharedRef();
+    FFileConvertersGLTF::ResetRootNodes(PartJsonRef, bResetLocation, bResetRotation, bResetScale);
+
+    if (MergePart(PartJsonRef, *PartHandle, PartHandle->Tell(), PartBinaryLength, ErrorCode) == false)
+    {
+        bIsFailed = true;
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+int32 FFileConvertersGLBWriter::AppendBufferView(const uint8* Data, int64 Length, int32 ByteStride, int32 Target, const FPreparedView* Prepared, FString& ErrorCode)
+{
+    const bool bIsEncoded = Prepared != nullptr && Prepared->Encoded.Num() > 0;
+    const uint8* SpoolData = bIsEncoded ? Prepared->Encoded.GetData() : Data;
+    const int64 SpoolLength = bIsEncoded ? Prepared->Encoded.Num() : Length;
+
+    // Views start 4 byte aligned, like accessors need.
+    const int64 ByteOffset = Align(BinaryLength, 4);
+
+    if (FileConvertersGLTF::WriteZeros(*Spool, ByteOffset - BinaryLength) == false || Spool->Write(SpoolData, SpoolLength) == false)
+    {
+        ErrorCode = "Buffer view can't be written to spool file.";
+        return INDEX_NONE;
+    }
+
+    BinaryLength = ByteOffset + SpoolLength;
+
+    const TSharedRef<FJsonObject> BufferView = MakeShared<FJsonObject>();
+
+    if (bIsEncoded == true)
+    {
+        // View points into fallback buffer, its extension points to encoded data in binary chunk.
+        const int64 FallbackOffset = Align(FallbackLength, 4);
+        FallbackLength = FallbackOffset + Length;
+
+        const TSharedRef<FJsonObject> Compression = MakeShared<FJsonObject>();
+        Compression->SetNumberField(TEXT("buffer"), 0);
+        Compression->SetNumberField(TEXT("byteOffset"), double(ByteOffset));
+        Compression->SetNumberField(TEXT("byteLength"), double(SpoolLength));
+        Compression->SetNumberField(TEXT("byteStride"), Prepared->ElementSize);
+        Compression->SetNumberField(TEXT("count"), Prepared->Count);
+        Compression->SetStringField(TEXT("mode"), Prepared->bIsIndices ? TEXT("INDICES") : TEXT("ATTRIBUTES"));
+
+        const TSharedRef<FJsonObject> Extensions = MakeShared<FJsonObject>();
+        Extensions->SetObjectField(FileConvertersGLTF::MeshoptExtension, Compression);
+
+        BufferView->SetNumberField(TEXT("buffer"), 1);
+        BufferView->SetNumberField(TEXT("byteOffset"), double(FallbackOffset));
+        BufferView->SetObjectField(TEXT("extensions"), Extensions);
+
+        ExtensionsUsed.Add(FileConvertersGLTF::MeshoptExtension);
+        ExtensionsRequired.Add(FileConvertersGLTF::MeshoptExtension);
+        Stats.CompressedViewCount++;
+    }
+
+    else
+    {
+        BufferView->SetNumberField(TEXT("buffer"), 0);
+        BufferView->SetNumberField(TEXT("byteOffset"), double(ByteOffset));
+    }
+
+    BufferView->SetNumberField(TEXT("byteLength"), double(Length));
+
+    if (ByteStride > 0)
+    {
+        BufferView->SetNumberField(TEXT("byteStride"), ByteStride);
+    }
+
+    if (Target > 0)
+    {
+        BufferView->SetNumberField(TEXT("target"), Target);
+    }
+
+    TArray<TSharedPtr<FJsonValue>>& Array_BufferViews = GetArray(TEXT("bufferViews"));
+    Array_BufferViews.Add(MakeShared<FJsonValueObject>(BufferView));
+
+    return Array_BufferViews.Num() - 1;
+}
+
+int32 FFileConvertersGLBWriter::AppendFloatAccessor(const TArray<float>& Values, int32 ComponentCount, FString& ErrorCode)
+{
+    const int32 BufferView = AppendBufferView(reinterpret_cast<const uint8*>(Values.GetData()), Values.Num() * sizeof(float), 0, 0, nullptr, ErrorCode);
+
+    if (BufferView == INDEX_NONE)
+    {
+        return INDEX_NONE;
+    }
+
+    const TSharedRef<FJsonObject> Accessor = MakeShared<FJsonObject>();
+    Accessor->SetNumberField(TEXT("bufferView"), BufferView);
+    Accessor->SetNumberField(TEXT("componentType"), FileConvertersGLTF::ComponentTypeFloat);
+    Accessor->SetNumberField(TEXT("count"), Values.Num() / ComponentCount);
+    Accessor->SetStringField(TEXT("type"), ComponentCount == 4 ? TEXT("VEC4") : TEXT("VEC3"));
+
+    TArray<TSharedPtr<FJsonValue>>& Array_Accessors = GetArray(TEXT("accessors"));
+    Array_Accessors.Add(MakeShared<FJsonValueObject>(Accessor));
+
+    return Array_Accessors.Num() - 1;
+}
+
+bool FFileConvertersGLBWriter::PrepareBufferViews(const TSharedRef<FJsonObject>& PartJson, IFileHandle& PartHandle, int64 PartBinaryStart, int64 PartBinaryLength, TMap<int32, FPreparedView>& OutViews, FString& ErrorCode)
+{
+    FILECONVERTERS_PHASE_SCOPE(MeshOptimize);
+
+    using namespace FileConvertersGLTF;
+
+    OutViews.Reset();
+
+    const TArray<TSharedPtr<FJsonValue>>* Array_BufferViews = nullptr;
+    const TArray<TSharedPtr<FJsonValue>>* Array_Accessors = nullptr;
+
+    if ((bReorderVertices == false && bCompressMeshes == false) || PartJson->TryGetArrayField(TEXT("bufferViews"), Array_BufferViews) == false || PartJson->TryGetArrayField(TEXT("accessors"), Array_Accessors) == false)
+    {
+        return true;
+    }
+
+    const TSharedPtr<FJsonObject> PartObject = PartJson;
+    const int32 ViewCount = Array_BufferViews->Num();
+    const int32 AccessorCount = Array_Accessors->Num();
+
+    // Accessor is tight if it is the only one in its view, starts at view start and fills the view without gaps.
+    TArray<int32> Array_ViewUsers;
+    Array_ViewUsers.Init(0, ViewCount);
+
+    TArray<int32> Array_AccessorViews;
+    TArray<int32> Array_AccessorSizes;
+    TArray<int32> Array_AccessorCounts;
+    TArray<int32> Array_AccessorComponents;
+    Array_AccessorViews.Init(INDEX_NONE, AccessorCount);
+    Array_AccessorSizes.Init(0, AccessorCount);
+    Array_AccessorCounts.Init(0, AccessorCount);
+    Array_AccessorComponents.Init(0, AccessorCount);
+
+    for (int32 AccessorIndex = 0; AccessorIndex < AccessorCount; AccessorIndex++)
+    {
+        const TSharedPtr<FJsonObject> Accessor = (*Array_Accessors)[AccessorIndex]->AsObject();
+
+        double ViewIndex = INDEX_NONE;
+
+        if (Accessor.IsValid() == false || Accessor->TryGetNumberField(TEXT("bufferView"), ViewIndex) == false || Array_ViewUsers.IsValidIndex(int32(ViewIndex)) == false)
+        {
+            continue;
+        }
+
+        double ByteOffset = 0;
+        double Count = 0;
+        double ComponentType = 0;
+        FString Type;
+
+        Accessor->TryGetNumberField(TEXT("byteOffset"), ByteOffset);
+        Accessor->TryGetNumberField(TEXT("count"), Count);
+        Accessor->TryGetNumberField(TEXT("componentType"), ComponentType);
+        Accessor->TryGetStringField(TEXT("type"), Type);
+
+        // Offset or sparse data shares the view with something else.
+        Array_ViewUsers[int32(ViewIndex)] += ByteOffset == 0 && Accessor->HasField(TEXT("sparse")) == false ? 1 : 2;
+
+        Array_AccessorViews[AccessorIndex] = int32(ViewIndex);
+        Array_AccessorSizes[AccessorIndex] = GetElementSize(int32(ComponentType), Type);
+        Array_AccessorCounts[AccessorIndex] = int32(Count);
+        Array_AccessorComponents[AccessorIndex] = int32(ComponentType);
+    }
+
+    auto IsTight = [&](int32 AccessorIndex)
+        {
+            if (Array_AccessorViews.IsValidIndex(AccessorIndex) == false || Array_AccessorViews[AccessorIndex] == INDEX_NONE || Array_AccessorSizes[AccessorIndex] == 0)
+            {
+                return false;
+            }
+
+            const int32 ViewIndex = Array_AccessorViews[AccessorIndex];
+            const TSharedPtr<FJsonObject> BufferView = (*Array_BufferViews)[ViewIndex]->AsObject();
+
+            double ByteLength = 0;
+            double ByteStride = 0;
+
+            BufferView->TryGetNumberField(TEXT("byteLength"), ByteLength);
+            BufferView->TryGetNumberField(TEXT("byteStride"), ByteStride);
+
+            return Array_ViewUsers[ViewIndex] == 1 && Array_AccessorCounts[AccessorIndex] > 0 && int64(ByteLength) == int64(Array_AccessorCounts[AccessorIndex]) * Array_AccessorSizes[AccessorIndex] && (ByteStride == 0 || int32(ByteStride) == Array_AccessorSizes[AccessorIndex]);
+        };
+
+    // Accessors used outside of one primitive can't be reordered. Skins and animations pin theirs.
+    TArray<int32> Array_AccessorUses;
+    TArray<uint8> Array_AccessorRoles;
+    Array_AccessorUses.Init(0, AccessorCount);
+    Array_AccessorRoles.Init(0, AccessorCount);
+
+    static constexpr uint8 RoleIndices = 1;
+    static constexpr uint8 RoleVertices = 2;
+    static constexpr uint8 RoleOther = 4;
+
+    auto UseAccessor = [&](int32 AccessorIndex, uint8 Role)
+        {
+            if (Array_AccessorUses.IsValidIndex(AccessorIndex) == true)
+            {
+                Array_AccessorUses[AccessorIndex]++;
+                Array_AccessorRoles[AccessorIndex] |= Role;
+            }
+        };
+
+    ForEachObject(PartObject, TEXT("skins"), [&UseAccessor](const TSharedPtr<FJsonObject>& Skin)
+        {
+            double AccessorIndex = INDEX_NONE;
+            if (Skin->TryGetNumberField(TEXT("inverseBindMatrices"), AccessorIndex) == true)
+            {
+                UseAccessor(int32(AccessorIndex), RoleOther);
+            }
+        }
+    );
+
+    ForEachObject(PartObject, TEXT("animations"), [&UseAccessor](const TSharedPtr<FJsonObject>& Animation)
+        {
+            ForEachObject(Animation, TEXT("samplers"), [&UseAccessor](const TSharedPtr<FJsonObject>& Sampler)
+                {
+                    double AccessorIndex = INDEX_NONE;
+                    if (Sampler->TryGetNumberField(TEXT("input"), AccessorIndex) == true)
+                    {
+                        UseAccessor(int32(AccessorIndex), RoleOther);
+                    }
+
+                    if (Sampler->TryGetNumberField(TEXT("output"), AccessorIndex) == true)
+                    {
+                        UseAccessor(int32(AccessorIndex), RoleOther);
+                    }
+                }
+            );
+        }
+    );
+
+    struct FPrimitiveStreams
+    {
+        int32 Indices = INDEX_NONE;
+        TArray<int32> Vertices;
+        bool bIsTriangleList = false;
+    };
+
+    TArray<FPrimitiveStreams> Array_Primitives;
+
+    ForEachObject(PartObject, TEXT("meshes"), [&](const TSharedPtr<FJsonObject>& Mesh)
+        {
+            ForEachObject(Mesh, TEXT("primitives"), [&](const TSharedPtr<FJsonObject>& Primitive)
+                {
+                    FPrimitiveStreams& Streams = Array_Primitives.AddDefaulted_GetRef();
+
+                    double Mode = ModeTriangles;
+                    Primitive->TryGetNumberField(TEXT("mode"), Mode);
+                    Streams.bIsTriangleList = int32(Mode) == ModeTriangles;
+
+                    double IndicesAccessor = INDEX_NONE;
+                    if (Primitive->TryGetNumberField(TEXT("indices"), IndicesAccessor) == true)
+                    {
+                        Streams.Indices = int32(IndicesAccessor);
+                        UseAccessor(Streams.Indices, RoleIndices);
+                    }
+
+                    auto AddVertexStreams = [&](const TSharedPtr<FJsonObject>& Attributes)
+                        {
+                            if (Attributes.IsValid() == false)
+                            {
+                                return;
+                            }
+
+                            for (const TPair<FString, TSharedPtr<FJsonValue>>& EachAttribute : Attributes->Values)
+                            {
+                                double AccessorIndex = INDEX_NONE;
+                                if (EachAttribute.Value.IsValid() == true && EachAttribute.Value->TryGetNumber(AccessorIndex) == true)
+                                {
+                                    Streams.Vertices.AddUnique(int32(AccessorIndex));
+                                    UseAccessor(int32(AccessorIndex), RoleVertices);
+                                }
+                            }
+                        };
+
+                    AddVertexStreams(GetObject(Primitive, TEXT("attributes")));
+                    ForEachObject(Primitive, TEXT("targets"), AddVertexStreams);
+                }
+            );
+        }
+    );
+
+    // 5123 - 5121 is 2 bytes, 5125 - 5121 is 4 bytes, so non scalar index accessors are rejected too.
+    auto IsIndexData = [&](int32 AccessorIndex)
+        {
+            return Array_AccessorRoles[AccessorIndex] == RoleIndices && (Array_AccessorComponents[AccessorIndex] == ComponentTypeUnsignedShort || Array_AccessorComponents[AccessorIndex] == ComponentTypeUnsignedInt) && Array_AccessorSizes[AccessorIndex] == Array_AccessorComponents[AccessorIndex] - 5121;
+        };
+
+    TArray<int32> Array_Reorderable;
+
+    auto AddView = [&](int32 AccessorIndex, bool bCanCompress)
+        {
+            FPreparedView& Prepared = OutViews.FindOrAdd(Array_AccessorViews[AccessorIndex]);
+            Prepared.ElementSize = Array_AccessorSizes[AccessorIndex];
+            Prepared.Count = Array_AccessorCounts[AccessorIndex];
+            Prepared.bIsIndices = Array_AccessorRoles[AccessorIndex] == RoleIndices;
+            Prepared.bCanCompress = bCanCompress;
+        };
+
+    for (int32 PrimitiveIndex = 0; PrimitiveIndex < Array_Primitives.Num() && bReorderVertices == true; PrimitiveIndex++)
+    {
+        const FPrimitiveStreams& Streams = Array_Primitives[PrimitiveIndex];
+
+        if (Streams.bIsTriangleList == false || Streams.Vertices.Num() == 0 || IsTight(Streams.Indices) == false || IsIndexData(Streams.Indices) == false || Array_AccessorUses[Streams.Indices] != 1 || Array_AccessorCounts[Streams.Indices] % 3 != 0)
+        {
+            continue;
+        }
+
+        const int32 VertexCount = Array_AccessorCounts[Streams.Vertices[0]];
+        bool bIsReorderable = true;
+
+        for (const int32 EachVertices : Streams.Vertices)
+        {
+            bIsReorderable &= IsTight(EachVertices) == true && Array_AccessorRoles[EachVertices] == RoleVertices && Array_AccessorUses[EachVertices] == 1 && Array_AccessorCounts[EachVertices] == VertexCount;
+        }
+
+        if (bIsReorderable == true)
+        {
+            Array_Reorderable.Add(PrimitiveIndex);
+            AddView(Streams.Indices, false);
+
+            for (const int32 EachVertices : Streams.Vertices)
+            {
+                AddView(EachVertices, false);
+            }
+        }
+    }
+
+    // ATTRIBUTES mode needs 4 byte aligned strides. Anything else stays uncompressed.
+    for (int32 AccessorIndex = 0; AccessorIndex < AccessorCount && bCompressMeshes == true; AccessorIndex++)
+    {
+        if (IsTight(AccessorIndex) == true && (IsIndexData(AccessorIndex) == true || (Array_AccessorRoles[AccessorIndex] == RoleVertices && Array_AccessorSizes[AccessorIndex] % 4 == 0)))
+        {
+            AddView(AccessorIndex, true);
+        }
+    }
+
+    for (TPair<int32, FPreparedView>& EachView : OutViews)
+    {
+        const TSharedPtr<FJsonObject> BufferView = (*Array_BufferViews)[EachView.Key]->AsObject();
+
+        double ByteOffset = 0;
+        BufferView->TryGetNumberField(TEXT("byteOffset"), ByteOffset);
+
+        const int64 ViewOffset = int64(ByteOffset);
+        const int64 ViewLength = int64(EachView.Value.Count) * EachView.Value.ElementSize;
+
+        if (ViewOffset < 0 || ViewOffset + ViewLength > PartBinaryLength || ViewLength > MAX_int32)
+        {
+            ErrorCode = "Buffer view of export part exceeds its binary chunk.";
+            return false;
+        }
+
+        EachView.Value.Bytes.SetNumUninitialized(int32(ViewLength));
+
+        if (PartHandle.Seek(PartBinaryStart + ViewOffset) == false || PartHandle.Read(EachView.Value.Bytes.GetData(), ViewLength) == false)
+        {
+            ErrorCode = "Buffer view of export part can't be read.";
+            return false;
+        }
+    }
+
+    auto ReadIndices = [](const FPreparedView& Prepared, TArray<uint32>& OutIndices)
+        {
+            OutIndices.SetNumUninitialized(Prepared.Count);
+
+            for (int32 Index = 0; Index < Prepared.Count; Index++)
+            {
+                OutIndices[Index] = Prepared.ElementSize == 2 ? reinterpret_cast<const uint16*>(Prepared.Bytes.GetData())[Index] : reinterpret_cast<const uint32*>(Prepared.Bytes.GetData())[Index];
+            }
+        };
+
+    // Map isn't resized below, workers only touch views of their own primitive.
+    TArray<bool> Array_IsOptimized;
+    Array_IsOptimized.Init(false, Array_Reorderable.Num());
+
+    ParallelFor(Array_Reorderable.Num(), [&](int32 ReorderIndex)
+        {
+            const FPrimitiveStreams& Streams = Array_Primitives[Array_Reorderable[ReorderIndex]];
+            FPreparedView& IndexView = OutViews.FindChecked(Array_AccessorViews[Streams.Indices]);
+            const int32 VertexCount = Array_AccessorCounts[Streams.Vertices[0]];
+
+            TArray<uint32> Array_Indices;
+            ReadIndices(IndexView, Array_Indices);
+
+            for (const uint32 EachIndex : Array_Indices)
+            {
+                if (EachIndex >= uint32(VertexCount))
+                {
+                    return;
+                }
+            }
+
+            TArray<uint32> Array_Remap;
+            TArray<uint8> Array_Scratch;
+
+            FFileConvertersMeshopt::OptimizeVertexCache(Array_Indices, VertexCount);
+            FFileConvertersMeshopt::OptimizeVertexFetch(Array_Indices, VertexCount, Array_Remap);
+
+            for (const int32 EachVertices : Streams.Vertices)
+            {
+                FPreparedView& VertexView = OutViews.FindChecked(Array_AccessorViews[EachVertices]);
+                FFileConvertersMeshopt::RemapVertices(VertexView.Bytes.GetData(), VertexCount, VertexView.ElementSize, Array_Remap, Array_Scratch);
+            }
+
+            for (int32 Index = 0; Index < Array_Indices.Num(); Index++)
+            {
+                if (IndexView.ElementSize == 2)
+                {
+                    reinterpret_cast<uint16*>(IndexView.Bytes.GetData())[Index] = uint16(Array_Indices[Index]);
+                }
+
+                else
+                {
+                    reinterpret_cast<uint32*>(IndexView.Bytes.GetData())[Index] = Array_Indices[Index];
+                }
+            }
+
+            Array_IsOptimized[ReorderIndex] = true;
+        }
+    );
+
+    for (const bool bEachIsOptimized : Array_IsOptimized)
+    {
+        Stats.OptimizedPrimitiveCount += bEachIsOptimized ? 1 : 0;
+    }
+
+    TArray<FPreparedView*> Array_ToEncode;
+
+    for (TPair<int32, FPreparedView>& EachView : OutViews)
+    {
+        if (EachView.Value.bCanCompress == true)
+        {
+            Array_ToEncode.Add(&EachView.Value);
+        }
+    }
+
+    ParallelFor(Array_ToEncode.Num(), [&](int32 EncodeIndex)
+        {
+            FPreparedView& Prepared = *Array_ToEncode[EncodeIndex];
+
+            if (Prepared.bIsIndices == true)
+            {
+                TArray<uint32> Array_Indices;
+                ReadIndices(Prepared, Array_Indices);
+                FFileConvertersMeshopt::EncodeIndexSequence(Array_Indices.GetData(), Array_Indices.Num(), Prepared.Encoded);
+            }
+
+            else
+            {
+                FFileConvertersMeshopt::EncodeVertexBuffer(Prepared.Bytes.GetData(), Prepared.Count, Prepared.ElementSize, Prepared.Encoded);
+            }
+
+            // Incompressible data, like noisy floats, is cheaper to keep raw.
+            if (Prepared.Encoded.Num() >= Prepared.Bytes.Num())
+            {
+                Prepared.Encoded.Empty();
+            }
+        }
+    );
+
+    ErrorCode = "Success";
+    return true;
+}
+
+bool FFileConvertersGLBWriter::MergeBufferViews(const TSharedRef<FJsonObject>& PartJson, IFileHandle& PartHandle, int64 PartBinaryStart, int64 PartBinaryLength, TArray<int32>& OutRemap, FString& ErrorCode)
+{
+    OutRemap.Reset();
+
+    const TArray<TSharedPtr<FJsonValue>>* Array_BufferViews = nullptr;
+
+    if (PartJson->TryGetArrayField(TEXT("bufferViews"), Array_BufferViews) == false)
+    {
+        return true;
+    }
+
+    TMap<int32, FPreparedView> PreparedViews;
+
+    if (PrepareBufferViews(PartJson, PartHandle, PartBinaryStart, PartBinaryLength, PreparedViews, ErrorCode) == false)
+    {
+        return false;
+    }
+
+    // Without preparing, one view is in memory at a time. Largest view is one vertex attribute, index list or image.
+    for (int32 ViewIndex = 0; ViewIndex < Array_BufferViews->Num(); ViewIndex++)
+    {
+        const TSharedPtr<FJsonObject> BufferView = (*Array_BufferViews)[ViewIndex]->AsObject();
+
+        double ByteOffset = 0;
+        double ByteLength = 0;
+        double ByteStride = 0;
+        double Target = 0;
+
+        BufferView->TryGetNumberField(TEXT("byteOffset"), ByteOffset);
+        BufferView->TryGetNumberField(TEXT("byteLength"), ByteLength);
+        BufferView->TryGetNumberField(TEXT("byteStride"), ByteStride);
+        BufferView->TryGetNumberField(TEXT("target"), Target);
+
+        const int64 ViewOffset = int64(ByteOffset);
+        const int64 ViewLength = int64(ByteLength);
+
+        if (ViewOffset < 0 || ViewLength < 0 || ViewOffset + ViewLength > PartBinaryLength || ViewLength > MAX_int32)
+        {
+            ErrorCode = "Buffer view of export part exceeds its binary chunk.";
+            return false;
+        }
+
+        const FPreparedView* Prepared = PreparedViews.Find(ViewIndex);
+        const uint8* ViewData = nullptr;
+
+        if (Prepared != nullptr)
+        {
+            ViewData = Prepared->Bytes.GetData();
+        }
+
+        else
+        {
+            if (CopyBuffer.Num() < ViewLength)
+            {
+                CopyBuffer.SetNumUninitialized(int32(ViewLength));
+            }
+
+            if (PartHandle.Seek(PartBinaryStart + ViewOffset) == false || PartHandle.Read(CopyBuffer.GetData(), ViewLength) == false)
+            {
+                ErrorCode = "Buffer view of export part can't be read.";
+                return false;
+            }
+
+            ViewData = CopyBuffer.GetData();
+        }
+
+        FString ContentKey;
+
+        if (bOptimize == true)
+        {
+            // Same geometry or image from different parts has same bytes. Reordering is deterministic, so it keeps them equal.
+            ContentKey = FString::Printf(TEXT("%016llx|%lld|%d|%d"), FXxHash64::HashBuffer(ViewData, ViewLength).Hash, ViewLength, int32(ByteStride), int32(Target));
+
+            if (const int32* SharedView = SharedBufferViews.Find(ContentKey))
+            {
+                OutRemap.Add(*SharedView);
+                continue;
+            }
+        }
+
+        const int32 MergedView = AppendBufferView(ViewData, ViewLength, int32(ByteStride), int32(Target), Prepared, ErrorCode);
+
+        if (MergedView == INDEX_NONE)
+        {
+            return false;
+        }
+
+        if (bOptimize == true)
+        {
+            SharedBufferViews.Add(ContentKey, MergedView);
+        }
+
+        OutRemap.Add(MergedView);
+    }
+
+    return true;
+}
+
+void FFileConvertersGLBWriter::MergeObjects(const TSharedRef<FJsonObject>& PartJson, const TCHAR* Name, bool bCanShare, TArray<int32>& OutRemap)
+{
+    OutRemap.Reset();
+
+    const TArray<TSharedPtr<FJsonValue>>* Array_PartValues = nullptr;
+
+    if (PartJson->TryGetArrayField(Name, Array_PartValues) == false)
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FJsonValue>>& Array_Merged = GetArray(Name);
+    TMap<FString, int32>& SharedIndices = SharedObjects.FindOrAdd(Name);
+
+    for (const TSharedPtr<FJsonValue>& EachValue : *Array_PartValues)
+    {
+        if (bOptimize == true && bCanShare == true && EachValue->Type == EJson::Object)
+        {
+            // References inside are already merged indices, so equal keys mean equal content.
+            const FString ObjectKey = FileConvertersGLTF::MakeObjectKey(EachValue->AsObject());
+
+            if (const int32* SharedIndex = SharedIndices.Find(ObjectKey))
+            {
+                OutRemap.Add(*SharedIndex);
+                continue;
+            }
+
+            SharedIndices.Add(ObjectKey, Array_Merged.Num());
+        }
+
+        OutRemap.Add(Array_Merged.Num());
+        Array_Merged.Add(EachValue);
+    }
+}
+
+bool FFileConvertersGLBWriter::MergePart(const TSharedRef<FJsonObject>& PartJson, IFileHandle& PartHandle, int64 PartBinaryStart, int64 PartBinaryLength, FString& ErrorCode)
+{
+    using namespace FileConvertersGLTF;
+
+    const TSharedPtr<FJsonObject> PartObject = PartJson;
+
+    Stats.SourceBytes += PartBinaryLength;
+    Stats.SourceNodeCount += GetArrayNum(PartJson, TEXT("nodes"));
+    Stats.SourceMeshCount += GetArrayNum(PartJson, TEXT("meshes"));
+    Stats.SourceMaterialCount += GetArrayNum(PartJson, TEXT("materials"));
+    Stats.SourceImageCount += GetArrayNum(PartJson, TEXT("images"));
+
+    // Each kind is merged after the kinds it refers to, so its references are already merged indices when it is compared.
+    TArray<int32> Array_BufferViewRemap;
+    if (MergeBufferViews(PartJson, PartHandle, PartBinaryStart, PartBinaryLength, Array_BufferViewRemap, ErrorCode) == false)
+    {
+        return false;
+    }
+
+    ForEachObject(PartObject, TEXT("accessors"), [&Array_BufferViewRemap](const TSharedPtr<FJsonObject>& Accessor)
+        {
+            RemapIndex(Accessor, TEXT("bufferView"), Array_BufferViewRemap);
+
+            const TSharedPtr<FJsonObject> Sparse = GetObject(Accessor, TEXT("sparse"));
+            RemapIndex(GetObject(Sparse, TEXT("indices")), TEXT("bufferView"), Array_BufferViewRemap);
+            RemapIndex(GetObject(Sparse, TEXT("values")), TEXT("bufferView"), Array_BufferViewRemap);
+        }
+    );
+
+    TArray<int32> Array_AccessorRemap;
+    MergeObjects(PartJson, TEXT("accessors"), true, Array_AccessorRemap);
+
+    ForEachObject(PartObject, TEXT("images"), [&Array_BufferViewRemap](const TSharedPtr<FJsonObject>& Image)
+        {
+            RemapIndex(Image, TEXT("bufferView"), Array_BufferViewRemap);
+        }
+    );
+
+    TArray<int32> Array_ImageRemap;
+    MergeObjects(PartJson, TEXT("images"), true, Array_ImageRemap);
+
+    TArray<int32> Array_SamplerRemap;
+    MergeObjects(PartJson, TEXT("samplers"), true, Array_SamplerRemap);
+
+    ForEachObject(PartObject, TEXT("textures"), [&Array_ImageRemap, &Array_SamplerRemap](const TSharedPtr<FJsonObject>& Texture)
+        {
+            RemapIndex(Texture, TEXT("source"), Array_ImageRemap);
+            RemapIndex(Texture, TEXT("sampler"), Array_SamplerRemap);
+
+            // Image format extensions (KHR_texture_basisu, EXT_texture_webp...) have their own source.
+            if (const TSharedPtr<FJsonObject> Extensions = GetObject(Texture, TEXT("extensions")))
+            {
+                for (const TPair<FString, TSharedPtr<FJsonValue>>& EachExtension : Extensions->Values)
+                {
+                    if (EachExtension.Value.IsValid() == true && EachExtension.Value->Type == EJson::Object)
+                    {
+                        RemapIndex(EachExtension.Value->AsObject(), TEXT("source"), Array_ImageRemap);
+                    }
+                }
+            }
+        }
+    );
+
+    TArray<int32> Array_TextureRemap;
+    MergeObjects(PartJson, TEXT("textures"), true, Array_TextureRemap);
+
+    ForEachObject(PartObject, TEXT("materials"), [&Array_TextureRemap](const TSharedPtr<FJsonObject>& Material)
+        {
+            RemapTextureInfos(Material, Array_TextureRemap);
+        }
+    );
+
+    TArray<int32> Array_MaterialRemap;
+    MergeObjects(PartJson, TEXT("materials"), true, Array_MaterialRemap);
+
+    ForEachObject(PartObject, TEXT("meshes"), [&Array_AccessorRemap, &Array_MaterialRemap](const TSharedPtr<FJsonObject>& Mesh)
+        {
+            ForEachObject(Mesh, TEXT("primitives"), [&Array_AccessorRemap, &Array_MaterialRemap](const TSharedPtr<FJsonObject>& Primitive)
+                {
+                    RemapAllIndices(GetObject(Primitive, TEXT("attributes")), Array_AccessorRemap);
+                    RemapIndex(Primitive, TEXT("indices"), Array_AccessorRemap);
+                    RemapIndex(Primitive, TEXT("material"), Array_MaterialRemap);
+
+                    ForEachObject(Primitive, TEXT("targets"), [&Array_AccessorRemap](const TSharedPtr<FJsonObject>& Target)
+                        {
+                            RemapAllIndices(Target, Array_AccessorRemap);
+                        }
+                    );
+                }
+            );
+        }
+    );
+
+    TArray<int32> Array_MeshRemap;
+    MergeObjects(PartJson, TEXT("meshes"), true, Array_MeshRemap);
+
+    TArray<int32> Array_CameraRemap;
+    MergeObjects(PartJson, TEXT("cameras"), true, Array_CameraRemap);
+
+    // Nodes, lights, skins and animations belong to their actors and are never shared.
+    TArray<int32> Array_LightRemap;
+    TArray<int32> Array_NodeRemap;
+
+    const TSharedPtr<FJsonObject> LightsExtension = GetObject(GetObject(PartObject, TEXT("extensions")), TEXT("KHR_lights_punctual"));
+    const TArray<TSharedPtr<FJsonValue>>* Array_Lights = nullptr;
+
+    if (LightsExtension.IsValid() == true && LightsExtension->TryGetArrayField(TEXT("lights"), Array_Lights) == true)
+    {
+        for (int32 LightIndex = 0; LightIndex < Array_Lights->Num(); LightIndex++)
+        {
+            Array_LightRemap.Add(Lights.Num() + LightIndex);
+        }
+
+        Lights.Append(*Array_Lights);
+    }
+
+    const int32 NodeOffset = GetArray(TEXT("nodes")).Num();
+    for (int32 NodeIndex = 0; NodeIndex < GetArrayNum(PartJson, TEXT("nodes")); NodeIndex++)
+    {
+        Array_NodeRemap.Add(NodeOffset + NodeIndex);
+    }
+
+    ForEachObject(PartObject, TEXT("skins"), [&Array_AccessorRemap, &Array_NodeRemap](const TSharedPtr<FJsonObject>& Skin)
+        {
+            RemapIndex(Skin, TEXT("inverseBindMatrices"), Array_AccessorRemap);
+            RemapIndex(Skin, TEXT("skeleton"), Array_NodeRemap);
+            RemapIndexArray(Skin, TEXT("joints"), Array_NodeRemap);
+        }
+    );
+
+    TArray<int32> Array_SkinRemap;
+    MergeObjects(PartJson, TEXT("skins"), false, Array_SkinRemap);
+
+    ForEachObject(PartObject, TEXT("nodes"), [&](const TSharedPtr<FJsonObject>& Node)
+        {
+            RemapIndex(Node, TEXT("mesh"), Array_MeshRemap);
+            RemapIndex(Node, TEXT("camera"), Array_CameraRemap);
+            RemapIndex(Node, TEXT("skin"), Array_SkinRemap);
+            RemapIndexArray(Node, TEXT("children"), Array_NodeRemap);
+            RemapIndex(GetObject(GetObject(Node, TEXT("extensions")), TEXT("KHR_lights_punctual")), TEXT("light"), Array_LightRemap);
+        }
+    );
+
+    TArray<int32> Array_Unused;
+    MergeObjects(PartJson, TEXT("nodes"), false, Array_Unused);
+
+    ForEachObject(PartObject, TEXT("animations"), [&Array_AccessorRemap, &Array_NodeRemap](const TSharedPtr<FJsonObject>& Animation)
+        {
+            ForEachObject(Animation, TEXT("samplers"), [&Array_AccessorRemap](const TSharedPtr<FJsonObject>& Sampler)
+                {
+                    RemapIndex(Sampler, TEXT("input"), Array_AccessorRemap);
+                    RemapIndex(Sampler, TEXT("output"), Array_AccessorRemap);
+                }
+            );
+
+            ForEachObject(Animation, TEXT("channels"), [&Array_NodeRemap](const TSharedPtr<FJsonObject>& Channel)
+                {
+                    RemapIndex(GetObject(Channel, TEXT("target")), TEXT("node"), Array_NodeRemap);
+                }
+            );
+        }
+    );
+
+    MergeObjects(PartJson, TEXT("animations"), false, Array_Unused);
+
+    // Exporter writes one scene, its roots become roots of merged scene.
+    const TArray<TSharedPtr<FJsonValue>>* Array_Scenes = nullptr;
+    const int32 SceneIndex = PartJson->HasField(TEXT("scene")) ? int32(PartJson->GetNumberField(TEXT("scene"))) : 0;
+
+    if (PartJson->TryGetArrayField(TEXT("scenes"), Array_Scenes) == true && Array_Scenes->IsValidIndex(SceneIndex) == true)
+    {
+        const TSharedPtr<FJsonObject> Scene = (*Array_Scenes)[SceneIndex]->AsObject();
+        const TArray<TSharedPtr<FJsonValue>>* Array_RootIndices = nullptr;
+
+        if (Scene.IsValid() == true && Scene->TryGetArrayField(TEXT("nodes"), Array_RootIndices) == true)
+        {
+            for (const TSharedPtr<FJsonValue>& EachRootIndex : *Array_RootIndices)
+            {
+                const int32 RootIndex = int32(EachRootIndex->AsNumber());
+
+                if (Array_NodeRemap.IsValidIndex(RootIndex) == true)
+                {
+                    SceneNodes.Add(MakeShared<FJsonValueNumber>(Array_NodeRemap[RootIndex]));
+                }
+            }
+        }
+    }
+
+    AppendStrings(PartJson, TEXT("extensionsUsed"), ExtensionsUsed);
+    AppendStrings(PartJson, TEXT("extensionsRequired"), ExtensionsRequired);
+
+    if (Asset.IsValid() == false)
+    {
+        Asset = GetObject(PartObject, TEXT("asset"));
+    }
+
+    return true;
+}
+
+bool FFileConvertersGLBWriter::InstanceNodes(FString& ErrorCode)
+{
+    using namespace FileConvertersGLTF;
+
+    TArray<TSharedPtr<FJsonValue>>& Array_Nodes = GetArray(TEXT("nodes"));
+    const int32 NodeCount = Array_Nodes.Num();
+
+    TArray<int32> Array_Parents;
+    Array_Parents.Init(INDEX_NONE, NodeCount);
+
+    TBitArray<> Array_IsRoot(false, NodeCount);
+    TBitArray<> Array_IsPinned(false, NodeCount);
+
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_Children = nullptr;
+
+        if (Array_Nodes[NodeIndex]->AsObject()->TryGetArrayField(TEXT("children"), Array_Children) == true)
+        {
+            for (const TSharedPtr<FJsonValue>& EachChild : *Array_Children)
+            {
+                const int32 ChildIndex = int32(EachChild->AsNumber());
+
+                if (Array_Parents.IsValidIndex(ChildIndex) == true)
+                {
+                    Array_Parents[ChildIndex] = NodeIndex;
+                }
+            }
+        }
+    }
+
+    for (const TSharedPtr<FJsonValue>& EachRoot : SceneNodes)
+    {
+        const int32 RootIndex = int32(EachRoot->AsNumber());
+
+        if (Array_IsRoot.IsValidIndex(RootIndex) == true)
+        {
+            Array_IsRoot[RootIndex] = true;
+        }
+    }
+
+    // Joints and animated nodes need their own node.
+    const auto PinNode = [&Array_IsPinned](double NodeIndex)
+        {
+            if (Array_IsPinned.IsValidIndex(int32(NodeIndex)) == true)
+            {
+                Array_IsPinned[int32(NodeIndex)] = true;
+            }
+        };
+
+    for (const TSharedPtr<FJsonValue>& EachSkin : GetArray(TEXT("skins")))
+    {
+        double Skeleton = 0;
+        if (EachSkin->AsObject()->TryGetNumberField(TEXT("skeleton"), Skeleton) == true)
+        {
+            PinNode(Skeleton);
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Array_Joints = nullptr;
+        if (EachSkin->AsObject()->TryGetArrayField(TEXT("joints"), Array_Joints) == true)
+        {
+            for (const TSharedPtr<FJsonValue>& EachJoint : *Array_Joints)
+            {
+                PinNode(EachJoint->AsNumber());
+            }
+        }
+    }
+
+    for (const TSharedPtr<FJsonValue>& EachAnimation : GetArray(TEXT("animations")))
+    {
+        ForEachObject(EachAnimation->AsObject(), TEXT("channels"), [&PinNode](const TSharedPtr<FJsonObject>& Channel)
+            {
+                double TargetNode = 0;
+                const TSharedPtr<FJsonObject> Target = GetObject(Channel, TEXT("target"));
+
+                if (Target.IsValid() == true && Target->TryGetNumberField(TEXT("node"), TargetNode) == true)
+                {
+                    PinNode(TargetNode);
+                }
+            }
+        );
+    }
+
+    // Leaf nodes with only a mesh and a transform can be instances. Instances share a parent, so instance transforms stay relative to it.
+    TMap<TPair<int32, int32>, TArray<int32>> Groups;
+    TArray<TPair<int32, int32>> Array_GroupKeys;
+
+    for (int32 NodeIndex = 0; NodeIndex < NodeCount; NodeIndex++)
+    {
+        const TSharedPtr<FJsonObject> Node = Array_Nodes[NodeIndex]->AsObject();
+        double Mesh = 0;
+
+        if (Array_IsPinned[NodeIndex] == true || (Array_Parents[NodeIndex] == INDEX_NONE && Array_IsRoot[NodeIndex] == false) || Node->TryGetNumberField(TEXT("mesh"), Mesh) == false)
+        {
+            continue;
+        }
+
+        if (Node->HasField(TEXT("children")) == true || Node->HasField(TEXT("camera")) == true || Node->HasField(TEXT("skin")) == true || Node->HasField(TEXT("weights")) == true || Node->HasField(TEXT("matrix")) == true || Node->HasField(TEXT("extensions")) == true)
+        {
+            continue;
+        }
+
+        const TPair<int32, int32> GroupKey(Array_Parents[NodeIndex], int32(Mesh));
+        TArray<int32>* Group = Groups.Find(GroupKey);
+
+        if (Group == nullptr)
+        {
+            Array_GroupKeys.Add(GroupKey);
+            Group = &Groups.Add(GroupKey);
+        }
+
+        Group->Add(NodeIndex);
+    }
+
+    TBitArray<> Array_IsRemoved(false, NodeCount);
+    TArray<float> Array_Translations;
+    TArray<float> Array_Rotations;
+    TArray<float> Array_Scales;
+
+    for (const TPair<int32, int32>& EachGroupKey : Array_GroupKeys)
+    {
+        const TArray<int32>& Group = Groups[EachGroupKey];
+
+        if (Group.Num() < MinInstanceCount)
+        {
+            continue;
+        }
+
+        Array_Translations.Reset(Group.Num() * 3);
+        Array_Rotations.Reset(Group.Num() * 4);
+        Array_Scales.Reset(Group.Num() * 3);
+
+        bool bHasRotation = false;
+        bool bHasScale = false;
+
+        for (const int32 EachNodeIndex : Group)
+        {
+            const TSharedPtr<FJsonObject> Node = Array_Nodes[EachNodeIndex]->AsObject();
+
+            ReadFloats(Node, TEXT("translation"), Array_Translations, { 0.0f, 0.0f, 0.0f });
+            ReadFloats(Node, TEXT("rotation"), Array_Rotations, { 0.0f, 0.0f, 0.0f, 1.0f });
+            ReadFloats(Node, TEXT("scale"), Array_Scales, { 1.0f, 1.0f, 1.0f });
+
+            bHasRotation |= Node->HasField(TEXT("rotation"));
+            bHasScale |= Node->HasField(TEXT("scale"));
+
+            Array_IsRemoved[EachNodeIndex] = true;
+        }
+
+        // Missing attributes mean identity, so they are only written when some instance needs them.
+        const TSharedRef<FJsonObject> Attributes = MakeShared<FJsonObject>();
+        const int32 TranslationAccessor = AppendFloatAccessor(Array_Translations, 3, ErrorCode);
+        const int32 RotationAccessor = bHasRotation ? AppendFloatAccessor(Array_Rotations, 4, ErrorCode) : 0;
+        const int32 ScaleAccessor = bHasScale ? AppendFloatAccessor(Array_Scales, 3, ErrorCode) : 0;
+
+        if (TranslationAccessor == INDEX_NONE || RotationAccessor == INDEX_NONE || ScaleAccessor == INDEX_NONE)
+        {
+            return false;
+        }
+
+        Attributes->SetNumberField(TEXT("TRANSLATION"), TranslationAccessor);
+
+        if (bHasRotation == true)
+        {
+            Attributes->SetNumberField(TEXT("ROTATION"), RotationAccessor);
+        }
+
+        if (bHasScale == true)
+        {
+            Attributes->SetNumberField(TEXT("SCALE"), ScaleAccessor);
+        }
+
+        const TSharedRef<FJsonObject> Instancing = MakeShared<FJsonObject>();
+        Instancing->SetObjectField(TEXT("attributes"), Attributes);
+
+        const TSharedRef<FJsonObject> Extensions = MakeShared<FJsonObject>();
+        Extensions->SetObjectField(TEXT("EXT_mesh_gpu_instancing"), Instancing);
+
+        const TSharedRef<FJsonObject> InstancedNode = MakeShared<FJsonObject>();
+        FString FirstName;
+        if (Array_Nodes[Group[0]]->AsObject()->TryGetStringField(TEXT("name"), FirstName) == true)
+        {
+            InstancedNode->SetStringField(TEXT("name"), FirstName + TEXT(" Instances"));
+        }
+
+        InstancedNode->SetNumberField(TEXT("mesh"), EachGroupKey.Value);
+        InstancedNode->SetObjectField(TEXT("extensions"), Extensions);
+
+        const int32 InstancedIndex = Array_Nodes.Add(MakeShared<FJsonValueObject>(InstancedNode));
+        Array_IsRemoved.Add(false);
+
+        if (EachGroupKey.Key == INDEX_NONE)
+        {
+            SceneNodes.Add(MakeShared<FJsonValueNumber>(InstancedIndex));
+        }
+
+        else
+        {
+            const TSharedPtr<FJsonObject> Parent = Array_Nodes[EachGroupKey.Key]->AsObject();
+            TArray<TSharedPtr<FJsonValue>> Array_Children = Parent->GetArrayField(TEXT("children"));
+            Array_Children.Add(MakeShared<FJsonValueNumber>(InstancedIndex));
+            Parent->SetArrayField(TEXT("children"), Array_Children);
+        }
+
+        Stats.InstanceGroupCount++;
+        Stats.InstancedNodeCount += Group.Num();
+    }
+
+    if (Stats.InstanceGroupCount == 0)
+    {
+        return true;
+    }
+
+    // Instancing isn't optional for correct output. A viewer without it would show one instance only.
+    ExtensionsUsed.Add(TEXT("EXT_mesh_gpu_instancing"));
+    ExtensionsRequired.Add(TEXT("EXT_mesh_gpu_instancing"));
+
+    // Compact nodes and rewrite every node reference.
+    TArray<int32> Array_NodeRemap;
+    TArray<TSharedPtr<FJsonValue>> Array_Kept;
+    Array_NodeRemap.Init(INDEX_NONE, Array_Nodes.Num());
+    Array_Kept.Reserve(Array_Nodes.Num() - Stats.InstancedNodeCount);
+
+    for (int32 NodeIndex = 0; NodeIndex < Array_Nodes.Num(); NodeIndex++)
+    {
+        if (Array_IsRemoved[NodeIndex] == false)
+        {
+            Array_NodeRemap[NodeIndex] = Array_Kept.Add(Array_Nodes[NodeIndex]);
+        }
+    }
+
+    for (const TSharedPtr<FJsonValue>& EachNode : Array_Kept)
+    {
+        RemapIndexArray(EachNode->AsObject(), TEXT("children"), Array_NodeRemap);
+    }
+
+    TArray<TSharedPtr<FJsonValue>> Array_SceneNodes;
+    for (const TSharedPtr<FJsonValue>& EachRoot : SceneNodes)
+    {
+        const int32 RootIndex = Array_NodeRemap[int32(EachRoot->AsNumber())];
+
+        if (RootIndex != INDEX_NONE)
+        {
+            Array_SceneNodes.Add(MakeShared<FJsonValueNumber>(RootIndex));
+        }
+    }
+
+    SceneNodes = MoveTemp(Array_SceneNodes);
+
+    for (const TSharedPtr<FJsonValue>& EachSkin : GetArray(TEXT("skins")))
+    {
+        RemapIndex(EachSkin->AsObject(), TEXT("skeleton"), Array_NodeRemap);
+        RemapIndexArray(EachSkin->AsObject(), TEXT("joints"), Array_NodeRemap);
+    }
+
+    for (const TSharedPtr<FJsonValue>& EachAnimation : GetArray(TEXT("animations")))
+    {
+        ForEachObject(EachAnimation->AsObject(), TEXT("channels"), [&Array_NodeRemap](const TSharedPtr<FJsonObject>& Channel)
+            {
+                RemapIndex(GetObject(Channel, TEXT("target")), TEXT("node"), Array_NodeRemap);
+            }
+        );
+    }
+
+    Array_Nodes = MoveTemp(Array_Kept);
+    return true;
+}
+
+bool FFileConvertersGLBWriter::Finish(FString& ErrorCode)
+{
+    FILECONVERTERS_PHASE_SCOPE(FileWrite);
+
+    using namespace FileConvertersGLTF;
+
+    if (bIsFailed == true)
+    {
+        ErrorCode = "Writer failed on an earlier part.";
+        return false;
+    }
+
+    if (bOptimize == true && (OpenSpool(ErrorCode) == false || InstanceNodes(ErrorCode) == false))
+    {
+        return false;
+    }
+
+    // Closes spool, so it can be read back.
+    Spool.Reset();
+
+    const TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+
+    if (Asset.IsValid() == true)
+    {
+        Json->SetObjectField(TEXT("asset"), Asset);
+    }
+
+    else
+    {
+        const TSharedRef<FJsonObject> DefaultAsset = MakeShared<FJsonObject>();
+        DefaultAsset->SetStringField(TEXT("version"), TEXT("2.0"));
+        Json->SetObjectField(TEXT("asset"), DefaultAsset);
+    }
+
+    WriteStrings(Json, TEXT("extensionsUsed"), ExtensionsUsed);
+    WriteStrings(Json, TEXT("extensionsRequired"), ExtensionsRequired);
+
+    const TSharedRef<FJsonObject> Scene = MakeShared<FJsonObject>();
+    Scene->SetArrayField(TEXT("nodes"), SceneNodes);
+    Json->SetNumberField(TEXT("scene"), 0);
+    Json->SetArrayField(TEXT("scenes"), { MakeShared<FJsonValueObject>(Scene) });
+
+    for (const TPair<FString, TArray<TSharedPtr<FJsonValue>>>& EachArray : MergedArrays)
+    {
+        if (EachArray.Value.Num() > 0)
+        {
+            Json->SetArrayField(EachArray.Key, EachArray.Value);
+        }
+    }
+
+    if (BinaryLength > 0)
+    {
+        const TSharedRef<FJsonObject> Buffer = MakeShared<FJsonObject>();
+        Buffer->SetNumberField(TEXT("byteLength"), double(BinaryLength));
+
+        TArray<TSharedPtr<FJsonValue>> Array_Buffers = { MakeShared<FJsonValueObject>(Buffer) };
+
+        // Encoded views always write into binary chunk, so fallback buffer is second.
+        if (FallbackLength > 0)
+        {
+            const TSharedRef<FJsonObject> Fallback = MakeShared<FJsonObject>();
+            Fallback->SetBoolField(TEXT("fallback"), true);
+
+            const TSharedRef<FJsonObject> Extensions = MakeShared<FJsonObject>();
+            Extensions->SetObjectField(MeshoptExtension, Fallback);
+
+            const TSharedRef<FJsonObject> FallbackBuffer = MakeShared<FJsonObject>();
+            FallbackBuffer->SetNumberField(TEXT("byteLength"), double(Align(FallbackLength, 4)));
+            FallbackBuffer->SetObjectField(TEXT("extensions"), Extensions);
+            Array_Buffers.Add(MakeShared<FJsonValueObject>(FallbackBuffer));
+        }
+
+        Json->SetArrayField(TEXT("buffers"), Array_Buffers);
+    }
+
+    if (Lights.Num() > 0)
+    {
+        const TSharedRef<FJsonObject> LightsExtension = MakeShared<FJsonObject>();
+        LightsExtension->SetArrayField(TEXT("lights"), Lights);
+
+        const TSharedRef<FJsonObject> Extensions = MakeShared<FJsonObject>();
+        Extensions->SetObjectField(TEXT("KHR_lights_punctual"), LightsExtension);
+        Json->SetObjectField(TEXT("extensions"), Extensions);
+    }
+
+    TArray<uint8> JsonBytes;
+    SerializeJson(Json, JsonBytes);
+
+    const int64 JsonLength = Align(int64(JsonBytes.Num()), 4);
+    const int64 BinaryChunkLength = Align(BinaryLength, 4);
+    const int64 TotalLength = HeaderSize + ChunkHeaderSize + JsonLength + (BinaryLength > 0 ? ChunkHeaderSize + BinaryChunkLength : 0);
+
+    if (TotalLength > MAX_uint32)
+    {
+        ErrorCode = "Merged GLB exceeds 4 GB limit of the format.";
+        return false;
+    }
+
+    // Everything before binary data is small, it is built in memory.
+    TArray<uint8> HeaderBytes;
+    HeaderBytes.Reserve(int32(HeaderSize + ChunkHeaderSize * 2 + JsonLength));
+    WriteUInt32(HeaderBytes, GLBMagic);
+    WriteUInt32(HeaderBytes, GLBVersion);
+    WriteUInt32(HeaderBytes, uint32(TotalLength));
+    WriteUInt32(HeaderBytes, uint32(JsonLength));
+    WriteUInt32(HeaderBytes, ChunkTypeJson);
+    HeaderBytes.Append(JsonBytes);
+
+    for (int64 PaddingIndex = JsonBytes.Num(); PaddingIndex < JsonLength; PaddingIndex++)
+    {
+        HeaderBytes.Add(' ');
+    }
+
+    if (BinaryLength > 0)
+    {
+        WriteUInt32(HeaderBytes, uint32(BinaryChunkLength));
+        WriteUInt32(HeaderBytes, ChunkTypeBinary);
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IFileHandle> OutputHandle(PlatformFile.OpenWrite(*OutputPath));
+
+    if (OutputHandle.IsValid() == false || OutputHandle->Write(HeaderBytes.GetData(), HeaderBytes.Num()) == false)
+    {
+        ErrorCode = "Output file can't be written.";
+        return false;
+    }
+
+    if (BinaryLength > 0)
+    {
+        TUniquePtr<IFileHandle> SpoolHandle(PlatformFile.OpenRead(*SpoolPath));
+
+        if (SpoolHandle.IsValid() == false || CopyFileRange(*SpoolHandle, *OutputHandle, BinaryLength, CopyBuffer) == false || WriteZeros(*OutputHandle, BinaryChunkLength - BinaryLength) == false)
+        {
+            ErrorCode = "Binary chunk can't be written to output file.";
+            return false;
+        }
+    }
+
+    Stats.OutputBytes = TotalLength;
+    Stats.OutputNodeCount = GetArray(TEXT("nodes")).Num();
+    Stats.OutputMeshCount = GetArray(TEXT("meshes")).Num();
+    Stats.OutputMaterialCount = GetArray(TEXT("materials")).Num();
+    Stats.OutputImageCount = GetArray(TEXT("images")).Num();
+
+    ErrorCode = "Success";
+    return true;
+}
+
+FFileConvertersExportCache& FFileConvertersExportCache::Get()
+{
+    static FFileConvertersExportCache Cache;
+    return Cache;
+}
+
+FString FFileConvertersExportCache::GetCacheDir() const
+{
+    return FPaths::ProjectSavedDir() / TEXT("FileConverters/ExportCache");
+}
+
+FString FFileConvertersExportCache::GetEntryPath(uint64 Key) const
+{
+    return GetCacheDir() / FString::Printf(TEXT("%016llx.glb"), Key);
+}
+
+bool FFileConvertersExportCache::IsCoveredByKey(const USceneComponent* Component)
+{
+    // Editor only helpers like sprites and arrows aren't exported.
+    if (Component->IsEditorOnly() == true)
+    {
+        return true;
+    }
+
+    const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component);
+
+    // Other primitives, e.g. landscapes or procedural meshes, build geometry from data which isn't in their properties or a saved asset.
+    return PrimitiveComponent == nullptr || PrimitiveComponent->IsA<UStaticMeshComponent>() == true || PrimitiveComponent->IsA<USkinnedMeshComponent>() == true;
+}
+
+bool FFileConvertersExportCache::AppendAssetVersion(const UObject* Asset, FString& KeySource)
+{
+    if (Asset == nullptr)
+    {
+        KeySource += TEXT("None;");
+        return true;
+    }
+
+    const UPackage* Package = Asset->GetPackage();
+
+    // Unsaved edits aren't visible in package file, so they can't be part of a key.
+    if (Package == nullptr || Package == GetTransientPackage() || Package->IsDirty() == true)
+    {
+        return false;
+    }
+
+    FString PackageFile;
+
+    if (FPackageName::DoesPackageExist(Package->GetName(), &PackageFile) == false)
+    {
+        return false;
+    }
+
+    const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*PackageFile);
+
+    if (StatData.bIsValid == false)
+    {
+        return false;
+    }
+
+    KeySource += FString::Printf(TEXT("%s|%lld|%lld;"), *Asset->GetPathName(), StatData.FileSize, StatData.ModificationTime.GetTicks());
+    return true;
+}
+
+bool FFileConvertersExportCache::MakePartKey(const TSet<AActor*>& PartActors, bool bEnableQuantization, uint64& OutKey)
+{
+    // Key doesn't depend on set order.
+    TArray<TPair<FString, AActor*>> Array_Actors;
+    Array_Actors.Reserve(PartActors.Num());
+
+    for (AActor* EachActor : PartActors)
+    {
+        if (IsValid(EachActor) == true)
+        {
+            Array_Actors.Add(TPair<FString, AActor*>(EachActor->GetPathName(), EachActor));
+        }
+    }
+
+    Array_Actors.Sort([](const TPair<FString, AActor*>& A, const TPair<FString, AActor*>& B) { return A.Key < B.Key; });
+
+    FString KeySource = FString::Printf(TEXT("%d|%s|%d;"), FileConvertersGLTF::ExportCacheVersion, *FEngineVersion::Current().ToString(), bEnableQuantization ? 1 : 0);
+
+    TArray<USceneComponent*> Array_Components;
+    TArray<UTexture*> Array_Textures;
+    FString PropertyValue;
+
+    for (const TPair<FString, AActor*>& EachActor : Array_Actors)
+    {
+        KeySource += EachActor.Key;
+
+#if WITH_EDITOR
+        // Node names come from labels in editor.
+        KeySource += EachActor.Value->GetActorLabel();
+#endif
+
+        KeySource += EachActor.Value->IsHidden() ? TEXT("|H;") : TEXT("|V;");
+
+        EachActor.Value->GetComponents<USceneComponent>(Array_Components);
+        Array_Components.Sort([](const USceneComponent& A, const USceneComponent& B) { return A.GetFName().LexicalLess(B.GetFName()); });
+
+        for (USceneComponent* EachComponent : Array_Components)
+        {
+            if (IsCoveredByKey(EachComponent) == false)
+            {
+                return false;
+            }
+
+            const FTransform WorldTransform = EachComponent->GetComponentTransform();
+            const FVector Location = WorldTransform.GetLocation();
+            const FQuat Rotation = WorldTransform.GetRotation();
+            const FVector Scale = WorldTransform.GetScale3D();
+
+            KeySource += FString::Printf(TEXT("%s|%s|%.9g,%.9g,%.9g|%.9g,%.9g,%.9g,%.9g|%.9g,%.9g,%.9g;"), *EachComponent->GetClass()->GetPathName(), *EachComponent->GetName(), Location.X, Location.Y, Location.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W, Scale.X, Scale.Y, Scale.Z);
+
+            // Editable properties cover light colors, camera settings, visibility, material overrides and the like.
+            for (TFieldIterator<FProperty> PropertyIterator(EachComponent->GetClass()); PropertyIterator; ++PropertyIterator)
+            {
+                const FProperty* Property = *PropertyIterator;
+
+                if (Property->HasAnyPropertyFlags(CPF_Edit) == false || Property->HasAnyPropertyFlags(CPF_Transient) == true)
+                {
+                    continue;
+                }
+
+                for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++)
+                {
+                    PropertyValue.Reset();
+                    Property->ExportText_InContainer(ArrayIndex, PropertyValue, EachComponent, nullptr, EachComponent, PPF_None);
+
+                    KeySource += Property->GetName();
+                    KeySource += TEXT("=");
+                    KeySource += PropertyValue;
+                    KeySource += TEXT(";");
+                }
+            }
+
+            // Referenced assets change without changing the component, their saved versions are part of the key. This covers meshes, skeletons, physics assets,
+            // animations and material overrides. References into component's own package are other components or actors, their properties are in the key already.
+            for (TPropertyValueIterator<FObjectPropertyBase> PropertyIterator(EachComponent->GetClass(), EachComponent); PropertyIterator; ++PropertyIterator)
+            {
+                const FObjectPropertyBase* Property = PropertyIterator.Key();
+
+                if (Property->HasAnyPropertyFlags(CPF_Transient) == true)
+                {
+                    continue;
+                }
+
+                const UObject* Referenced = Property->GetObjectPropertyValue(PropertyIterator.Value());
+
+                if (Referenced == nullptr || Referenced->GetPackage() == EachComponent->GetPackage())
+                {
+                    continue;
+                }
+
+                if (AppendAssetVersion(Referenced, KeySource) == false)
+                {
+                    return false;
+                }
+            }
+
+            if (const UMeshComponent* MeshComponent = Cast<UMeshComponent>(EachComponent))
+            {
+                for (int32 MaterialIndex = 0; MaterialIndex < MeshComponent->GetNumMaterials(); MaterialIndex++)
+                {
+                    UMaterialInterface* Material = MeshComponent->GetMaterial(MaterialIndex);
+
+                    if (Material == nullptr)
+                    {
+                        continue;
+                    }
+
+                    for (const UMaterialInterface* EachMaterial = Material; EachMaterial != nullptr; )
+                    {
+                        if (AppendAssetVersion(EachMaterial, KeySource) == false)
+                        {
+                            return false;
+                        }
+
+                        const UMaterialInstance* MaterialInstance = Cast<UMaterialInstance>(EachMaterial);
+                        EachMaterial = MaterialInstance != nullptr ? MaterialInstance->Parent.Get() : nullptr;
+                    }
+
+                    Array_Textures.Reset();
+                    Material->GetUsedTextures(Array_Textures, EMaterialQualityLevel::Num, true, GMaxRHIFeatureLevel, true);
+
+                    for (const UTexture* EachTexture : Array_Textures)
+                    {
+                        if (AppendAssetVersion(EachTexture, KeySource) == false)
+                        {
+                            return false;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    OutKey = FXxHash64::HashBuffer(*KeySource, KeySource.Len() * sizeof(TCHAR)).Hash;
+    return true;
+}
+
+FString FFileConvertersExportCache::Find(uint64 Key)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const FString EntryPath = GetEntryPath(Key);
+
+    if (PlatformFile.FileExists(*EntryPath) == false)
+    {
+        return FString();
+    }
+
+    // Refresh timestamp, so eviction sees this entry as recently used.
+    PlatformFile.SetTimeStamp(*EntryPath, FDateTime::UtcNow());
+    return EntryPath;
+}
+
+FString FFileConvertersExportCache::Store(uint64 Key, const FString& PartPath)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const int64 PartSize = PlatformFile.FileSize(*PartPath);
+    const FString EntryPath = GetEntryPath(Key);
+
+    FScopeLock Lock(&Guard);
+
+    ScanUsedBytes();
+
+    if (PartSize < 0 || PartSize > BudgetBytes)
+    {
+        return FString();
+    }
+
+    PlatformFile.CreateDirectoryTree(*GetCacheDir());
+
+    // Same key can be stored again if the entry was deleted while its part was exported.
+    if (PlatformFile.FileExists(*EntryPath) == true)
+    {
+        UsedBytes -= PlatformFile.FileSize(*EntryPath);
+        PlatformFile.DeleteFile(*EntryPath);
+    }
+
+    if (PlatformFile.MoveFile(*EntryPath, *PartPath) == false)
+    {
+        return FString();
+    }
+
+    UsedBytes += PartSize;
+    EvictToBudget();
+
+    return EntryPath;
+}
+
+void FFileConvertersExportCache::ScanUsedBytes()
+{
+    if (UsedBytes != INDEX_NONE)
+    {
+        return;
+    }
+
+    UsedBytes = 0;
+    FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStat(*GetCacheDir(), [this](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory == false && FPaths::GetExtension(CharPath) == TEXT("glb"))
+            {
+                UsedBytes += StatData.FileSize;
+            }
+
+            return true;
+        }
+    );
+}
+
+void FFileConvertersExportCache::EvictToBudget()
+{
+    if (UsedBytes <= BudgetBytes)
+    {
+        return;
+    }
+
+    struct FCacheEntry
+    {
+        FString Path;
+        int64 Size;
+        FDateTime LastUsed;
+    };
+
+    TArray<FCacheEntry> Array_Entries;
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    PlatformFile.IterateDirectoryStat(*GetCacheDir(), [&Array_Entries](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory == false && FPaths::GetExtension(CharPath) == TEXT("glb"))
+            {
+                Array_Entries.Add({ CharPath, StatData.FileSize, StatData.ModificationTime });
+            }
+
+            return true;
+        }
+    );
+
+    Array_Entries.Sort([](const FCacheEntry& A, const FCacheEntry& B) { return A.LastUsed < B.LastUsed; });
+
+    UsedBytes = 0;
+    for (const FCacheEntry& EachEntry : Array_Entries)
+    {
+        UsedBytes += EachEntry.Size;
+    }
+
+    for (const FCacheEntry& EachEntry : Array_Entries)
+    {
+        if (UsedBytes <= BudgetBytes)
+        {
+            break;
+        }
+
+        if (PlatformFile.DeleteFile(*EachEntry.Path) == true)
+        {
+            UsedBytes -= EachEntry.Size;
+        }
+    }
+}
+
+void FFileConvertersExportCache::SetBudget(int64 InBudgetBytes)
+{
+    FScopeLock Lock(&Guard);
+    BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+    ScanUsedBytes();
+    EvictToBudget();
+}
+
+void FFileConvertersExportCache::Clear()
+{
+    FScopeLock Lock(&Guard);
+    FPlatformFileManager::Get().GetPlatformFile().DeleteDirectoryRecursively(*GetCacheDir());
+    UsedBytes = 0;
+}
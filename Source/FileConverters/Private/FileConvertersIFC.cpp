@@ -0,0 +1,1435 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersIFC.h"
+#include "FileConverters.h"
+#include "FileConvertersAssets.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+#include "Hash/xxhash.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define FILECONVERTERS_IFC_SSE2 1
+#else
+#define FILECONVERTERS_IFC_SSE2 0
+#endif
+
+namespace FileConvertersIFC
+{
+    // Representation items which carry coordinates or tessellation. Products and properties are small next to these.
+    static const ANSICHAR* GeometryTypes[] =
+    {
+        "IFCCARTESIANPOINT", "IFCCARTESIANPOINTLIST2D", "IFCCARTESIANPOINTLIST3D", "IFCDIRECTION", "IFCPOLYLINE", "IFCPOLYLOOP", "IFCINDEXEDPOLYCURVE",
+        "IFCFACE", "IFCFACEBOUND", "IFCFACEOUTERBOUND", "IFCCLOSEDSHELL", "IFCOPENSHELL", "IFCFACETEDBREP", "IFCADVANCEDBREP",
+        "IFCTRIANGULATEDFACESET", "IFCPOLYGONALFACESET", "IFCINDEXEDPOLYGONALFACE", "IFCINDEXEDPOLYGONALFACEWITHVOIDS",
+        "IFCEXTRUDEDAREASOLID", "IFCBOOLEANRESULT", "IFCBOOLEANCLIPPINGRESULT", "IFCBSPLINECURVEWITHKNOTS", "IFCBSPLINESURFACEWITHKNOTS", "IFCRATIONALBSPLINESURFACEWITHKNOTS"
+    };
+
+    // Complex instances like #1=(A()B()) have no single type.
+    static const ANSICHAR* ComplexTypeName = "(COMPLEX)";
+
+    static bool IsSpace(uint8 Char)
+    {
+        return Char == ' ' || Char == '\t' || Char == '\r' || Char == '\n';
+    }
+
+    static bool IsKeywordChar(uint8 Char)
+    {
+        return (Char >= 'A' && Char <= 'Z') || (Char >= 'a' && Char <= 'z') || (Char >= '0' && Char <= '9') || Char == '_' || Char == '-';
+    }
+
+    // Skips white space and comments between records.
+    static const uint8* SkipSpace(const uint8* Cursor, const uint8* End)
+    {
+        while (Cursor < End)
+        {
+            if (IsSpace(*Cursor) == true)
+            {
+                Cursor++;
+            }
+
+            else if (*Cursor == '/' && End - Cursor > 1 && Cursor[1] == '*')
+            {
+                Cursor += 2;
+                while (Cursor < End && (*Cursor != '*' || End - Cursor < 2 || Cursor[1] != '/'))
+                {
+                    Cursor++;
+                }
+
+                Cursor = FMath::Min(Cursor + 2, End);
+            }
+
+            else
+            {
+                break;
+            }
+        }
+
+        return Cursor;
+    }
+
+    static uint32 ParseHex(FAnsiStringView Digits)
+    {
+        uint32 Value = 0;
+        for (const ANSICHAR EachDigit : Digits)
+        {
+            Value = Value * 16 + uint32(FParse::HexDigit(TCHAR(EachDigit)));
+        }
+
+        return Value;
+    }
+}
+
+bool FFileConvertersIFCScanner::Scan(const FString& FilePath, FIFCScanResult& OutResult, FString& ErrorCode)
+{
+    using namespace FileConvertersIFC;
+
+    FILECONVERTERS_PHASE_SCOPE(IFCScan);
+
+    const double StartTime = FPlatformTime::Seconds();
+    OutResult = FIFCScanResult();
+
+    const TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = FFileConvertersMappedFile::Open(FilePath, ErrorCode);
+
+    if (MappedFile.IsValid() == false)
+    {
+        return false;
+    }
+
+    const uint8* FileBegin = MappedFile->GetData();
+    const uint8* FileEnd = FileBegin + MappedFile->GetSize();
+
+    OutResult.FileSize = MappedFile->GetSize();
+    PhaseScope_IFCScan.AddBytes(OutResult.FileSize);
+
+    // UTF-8 byte order mark.
+    if (FileEnd - FileBegin >= 3 && FileBegin[0] == 0xEF && FileBegin[1] == 0xBB && FileBegin[2] == 0xBF)
+    {
+        FileBegin += 3;
+    }
+
+    // Header is a handful of records before DATA, it is read in order.
+    const uint8* HeaderBegin = SkipSpace(FileBegin, FileEnd);
+    const uint8* DataBegin = nullptr;
+    TArray<FAnsiStringView> Array_Parameters;
+
+    for (const uint8* Cursor = HeaderBegin; Cursor < FileEnd; Cursor = SkipSpace(Cursor, FileEnd))
+    {
+        const uint8* RecordEnd = FindRecordEnd(Cursor, FileEnd);
+        const FAnsiStringView Keyword = ReadKeyword(Cursor, RecordEnd);
+
+        if (Cursor == HeaderBegin && Keyword.Equals("ISO-10303-21", ESearchCase::IgnoreCase) == false)
+        {
+            ErrorCode = "File isn't a STEP file.";
+            return false;
+        }
+
+        if (Keyword.Equals("DATA", ESearchCase::IgnoreCase) == true)
+        {
+            DataBegin = RecordEnd;
+            break;
+        }
+
+        if (Keyword.Equals("FILE_NAME", ESearchCase::IgnoreCase) == true)
+        {
+            ReadParameters(Cursor, RecordEnd, Array_Parameters);
+            OutResult.FileName = Array_Parameters.IsValidIndex(0) ? DecodeString(Array_Parameters[0]) : FString();
+            OutResult.TimeStamp = Array_Parameters.IsValidIndex(1) ? DecodeString(Array_Parameters[1]) : FString();
+            OutResult.OriginatingSystem = Array_Parameters.IsValidIndex(5) ? DecodeString(Array_Parameters[5]) : FString();
+        }
+
+        else if (Keyword.Equals("FILE_SCHEMA", ESearchCase::IgnoreCase) == true)
+        {
+            ReadParameters(Cursor, RecordEnd, Array_Parameters);
+            OutResult.Schema = Array_Parameters.IsValidIndex(0) ? DecodeString(Array_Parameters[0]) : FString();
+        }
+
+        else if (Keyword.IsEmpty() == true)
+        {
+            // Instances before DATA, header is broken.
+            break;
+        }
+
+        Cursor = RecordEnd;
+    }
+
+    if (DataBegin == nullptr)
+    {
+        ErrorCode = "DATA section isn't found.";
+        return false;
+    }
+
+    const int64 DataSize = FileEnd - DataBegin;
+    const int32 ChunkCount = int32(FMath::Clamp<int64>(DataSize / MinChunkSize, 1, MaxChunkCount));
+
+    // Both neighbours find a bound from same nominal offset, so every record belongs to exactly one chunk.
+    auto GetChunkStart = [&](int32 ChunkIndex) -> const uint8*
+        {
+            if (ChunkIndex == 0)
+            {
+                return DataBegin;
+            }
+
+            if (ChunkIndex == ChunkCount)
+            {
+                return FileEnd;
+            }
+
+            return FindChunkStart(DataBegin + DataSize * ChunkIndex / ChunkCount, FileEnd);
+        };
+
+    TArray<FChunk> Array_Chunks;
+    Array_Chunks.SetNum(ChunkCount);
+
+    ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+        {
+            const uint8* ChunkBegin = GetChunkStart(ChunkIndex);
+            const uint8* ChunkEnd = GetChunkStart(ChunkIndex + 1);
+
+            if (ChunkBegin < ChunkEnd)
+            {
+                ScanChunk(ChunkBegin, ChunkEnd, Array_Chunks[ChunkIndex]);
+            }
+        }
+    );
+
+    FHistogram Histogram;
+    const uint8* ProjectBegin = nullptr;
+    const uint8* ProjectEnd = nullptr;
+
+    for (const FChunk& EachChunk : Array_Chunks)
+    {
+        OutResult.EntityCount += EachChunk.EntityCount;
+
+        for (const TPair<uint64, FTypeCount>& EachType : EachChunk.Histogram)
+        {
+            FTypeCount& TypeCount = Histogram.FindOrAdd(EachType.Key);
+            TypeCount.Name = EachType.Value.Name;
+            TypeCount.NameLength = EachType.Value.NameLength;
+            TypeCount.Count += EachType.Value.Count;
+            TypeCount.Bytes += EachType.Value.Bytes;
+        }
+
+        if (ProjectBegin == nullptr && EachChunk.ProjectBegin != nullptr)
+        {
+            ProjectBegin = EachChunk.ProjectBegin;
+            ProjectEnd = EachChunk.ProjectEnd;
+        }
+    }
+
+    OutResult.EntityTypes.Reserve(Histogram.Num());
+
+    for (const TPair<uint64, FTypeCount>& EachType : Histogram)
+    {
+        const FAnsiStringView TypeName(EachType.Value.Name, EachType.Value.NameLength);
+
+        FIFCEntityCount& EntityCount = OutResult.EntityTypes.AddDefaulted_GetRef();
+        EntityCount.Type = FString(TypeName);
+        EntityCount.Count = EachType.Value.Count;
+        EntityCount.Bytes = EachType.Value.Bytes;
+
+        if (IsGeometryType(TypeName) == true)
+        {
+            OutResult.GeometryEntityCount += EachType.Value.Count;
+            OutResult.GeometryBytes += EachType.Value.Bytes;
+        }
+    }
+
+    OutResult.EntityTypes.Sort([](const FIFCEntityCount& A, const FIFCEntityCount& B) { return A.Count > B.Count; });
+
+    // IFCPROJECT(GlobalId, OwnerHistory, Name, ...)
+    if (ProjectBegin != nullptr)
+    {
+        ReadParameters(ProjectBegin, ProjectEnd, Array_Parameters);
+        OutResult.ProjectName = Array_Parameters.IsValidIndex(2) ? DecodeString(Array_Parameters[2]) : FString();
+    }
+
+    PhaseScope_IFCScan.AddItems(OutResult.EntityCount);
+    OutResult.Seconds = float(FPlatformTime::Seconds() - StartTime);
+
+    ErrorCode = "Success";
+    return true;
+}
+
+const uint8* FFileConvertersIFCScanner::FindEither(const uint8* Cursor, const uint8* End, uint8 A, uint8 B)
+{
+#if FILECONVERTERS_IFC_SSE2
+    const __m128i ALanes = _mm_set1_epi8(static_cast<char>(A));
+    const __m128i BLanes = _mm_set1_epi8(static_cast<char>(B));
+
+    for (; End - Cursor >= 16; Cursor += 16)
+    {
+        const __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Cursor));
+        const int32 Mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(Bytes, ALanes), _mm_cmpeq_epi8(Bytes, BLanes)));
+
+        if (Mask != 0)
+        {
+            return Cursor + FMath::CountTrailingZeros(uint32(Mask));
+        }
+    }
+#endif
+
+    for (; Cursor < End; Cursor++)
+    {
+        if (*Cursor == A || *Cursor == B)
+        {
+            return Cursor;
+        }
+    }
+
+    return End;
+}
+
+const uint8* FFileConvertersIFCScanner::FindRecordEnd(const uint8* Cursor, const uint8* End)
+{
+    bool bIsInString = false;
+
+    while (true)
+    {
+        Cursor = FindEither(Cursor, End, ';', '\'');
+
+        if (Cursor == End)
+        {
+            return End;
+        }
+
+        // Doubled quote inside a string toggles twice.
+        if (*Cursor == '\'')
+        {
+            bIsInString = !bIsInString;
+        }
+
+        else if (bIsInString == false)
+        {
+            return Cursor + 1;
+        }
+
+        Cursor++;
+    }
+}
+
+const uint8* FFileConvertersIFCScanner::FindChunkStart(const uint8* Cursor, const uint8* End)
+{
+    while (true)
+    {
+        Cursor = FindEither(Cursor, End, '\n', '\n');
+
+        if (End - Cursor < 3)
+        {
+            return End;
+        }
+
+        Cursor++;
+
+        // Only "#<digits> =" starts a record. A line of a multi line string or comment can also begin with '#'.
+        if (*Cursor != '#')
+        {
+            continue;
+        }
+
+        const uint8* Test = Cursor + 1;
+        const uint8* DigitsBegin = Test;
+
+        while (Test < End && *Test >= '0' && *Test <= '9')
+        {
+            Test++;
+        }
+
+        if (Test == DigitsBegin)
+        {
+            continue;
+        }
+
+        while (Test < End && FileConvertersIFC::IsSpace(*Test) == true)
+        {
+            Test++;
+        }
+
+        if (Test < End && *Test == '=')
+        {
+            return Cursor;
+        }
+    }
+}
+
+void FFileConvertersIFCScanner::ScanChunk(const uint8* Begin, const uint8* End, FChunk& OutChunk)
+{
+    using namespace FileConvertersIFC;
+
+    const FAnsiStringView ComplexType(ComplexTypeName);
+
+    for (const uint8* Cursor = SkipSpace(Begin, End); Cursor < End; Cursor = SkipSpace(Cursor, End))
+    {
+        const uint8* RecordEnd = FindRecordEnd(Cursor, End);
+
+        // Only instances count, ENDSEC and trailer are skipped.
+        if (*Cursor == '#')
+        {
+            const uint8* Equals = FindEither(Cursor, RecordEnd, '=', '=');
+            const FAnsiStringView Keyword = ReadKeyword(SkipSpace(Equals < RecordEnd ? Equals + 1 : RecordEnd, RecordEnd), RecordEnd);
+            const FAnsiStringView TypeName = Keyword.IsEmpty() == true ? ComplexType : Keyword;
+
+            FTypeCount& TypeCount = OutChunk.Histogram.FindOrAdd(CityHash64(TypeName.GetData(), uint32(TypeName.Len())));
+            TypeCount.Name = TypeName.GetData();
+            TypeCount.NameLength = TypeName.Len();
+            TypeCount.Count++;
+            TypeCount.Bytes += RecordEnd - Cursor;
+
+            OutChunk.EntityCount++;
+
+            if (OutChunk.ProjectBegin == nullptr && TypeName.Equals("IFCPROJECT", ESearchCase::IgnoreCase) == true)
+            {
+                OutChunk.ProjectBegin = Cursor;
+                OutChunk.ProjectEnd = RecordEnd;
+            }
+        }
+
+        Cursor = RecordEnd;
+    }
+}
+
+FAnsiStringView FFileConvertersIFCScanner::ReadKeyword(const uint8* Cursor, const uint8* End)
+{
+    const uint8* KeywordEnd = Cursor;
+    while (KeywordEnd < End && FileConvertersIFC::IsKeywordChar(*KeywordEnd) == true)
+    {
+        KeywordEnd++;
+    }
+
+    return FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Cursor), int32(KeywordEnd - Cursor));
+}
+
+void FFileConvertersIFCScanner::ReadParameters(const uint8* Begin, const uint8* End, TArray<FAnsiStringView>& OutParameters)
+{
+    OutParameters.Reset();
+
+    const uint8* Cursor = FindEither(Begin, End, '(', '(');
+
+    if (Cursor == End)
+    {
+        return;
+    }
+
+    const uint8* ParameterBegin = Cursor + 1;
+    int32 Depth = 0;
+    bool bIsInString = false;
+
+    for (; Cursor < End; Cursor++)
+    {
+        const uint8 Char = *Cursor;
+
+        if (Char == '\'')
+        {
+            bIsInString = !bIsInString;
+        }
+
+        else if (bIsInString == true)
+        {
+            continue;
+        }
+
+        else if (Char == '(')
+        {
+            Depth++;
+        }
+
+        else if (Char == ')' && Depth > 1)
+        {
+            Depth--;
+        }
+
+        else if (Char == ')' || (Char == ',' && Depth == 1))
+        {
+            OutParameters.Add(FAnsiStringView(reinterpret_cast<const ANSICHAR*>(ParameterBegin), int32(Cursor - ParameterBegin)).TrimStartAndEnd());
+
+            if (Char == ')')
+            {
+                return;
+            }
+
+            ParameterBegin = Cursor + 1;
+        }
+    }
+}
+
+FString FFileConvertersIFCScanner::DecodeString(FAnsiStringView Parameter)
+{
+    // Lists like FILE_SCHEMA(('IFC4')) give their first string. Unset "$" and derived "*" have none.
+    int32 QuoteIndex = INDEX_NONE;
+    if (Parameter.FindChar('\'', QuoteIndex) == false)
+    {
+        return FString();
+    }
+
+    FString Decoded;
+    Decoded.Reserve(Parameter.Len());
+
+    for (int32 CharIndex = QuoteIndex + 1; CharIndex < Parameter.Len(); CharIndex++)
+    {
+        const ANSICHAR Char = Parameter[CharIndex];
+
+        if (Char == '\'')
+        {
+            if (CharIndex + 1 < Parameter.Len() && Parameter[CharIndex + 1] == '\'')
+            {
+                Decoded.AppendChar(TEXT('\''));
+                CharIndex++;
+                continue;
+            }
+
+            break;
+        }
+
+        if (Char == '\\')
+        {
+            const FAnsiStringView Rest = Parameter.RightChop(CharIndex);
+
+            // UTF-16 code units as 4 hex digits until \X0\.
+            if (Rest.StartsWith("\\X2\\", ESearchCase::IgnoreCase) == true)
+            {
+                for (CharIndex += 4; CharIndex + 4 <= Parameter.Len() && Parameter[CharIndex] != '\\'; CharIndex += 4)
+                {
+                    Decoded.AppendChar(TCHAR(FileConvertersIFC::ParseHex(Parameter.Mid(CharIndex, 4))));
+                }
+
+                CharIndex += 3;
+                continue;
+            }
+
+            // One ISO 8859-1 character as 2 hex digits.
+            if (Rest.StartsWith("\\X\\", ESearchCase::IgnoreCase) == true && Rest.Len() >= 5)
+            {
+                Decoded.AppendChar(TCHAR(FileConvertersIFC::ParseHex(Rest.Mid(3, 2))));
+                CharIndex += 4;
+                continue;
+            }
+
+            if (Rest.StartsWith("\\\\") == true)
+            {
+                Decoded.AppendChar(TEXT('\\'));
+                CharIndex++;
+                continue;
+            }
+        }
+
+        Decoded.AppendChar(TCHAR(uint8(Char)));
+    }
+
+    return Decoded;
+}
+
+bool FFileConvertersIFCScanner::IsGeometryType(FAnsiStringView Type)
+{
+    for (const ANSICHAR* EachType : FileConvertersIFC::GeometryTypes)
+    {
+        if (Type.Equals(EachType, ESearchCase::IgnoreCase) == true)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+FFileConvertersIFCCache& FFileConvertersIFCCache::Get()
+{
+    static FFileConvertersIFCCache Cache;
+    return Cache;
+}
+
+FString FFileConvertersIFCCache::GetCacheDir() const
+{
+    return FPaths::ProjectSavedDir() / TEXT("FileConverters/IFCCache");
+}
+
+FString FFileConvertersIFCCache::GetEntryPath(uint64 Key, const FString& Extension) const
+{
+    return GetCacheDir() / FString::Printf(TEXT("%016llx.%s"), Key, *Extension);
+}
+
+bool FFileConvertersIFCCache::IsEntry(const TCHAR* CharPath)
+{
+    const FString Extension = FPaths::GetExtension(CharPath);
+    return Extension != TEXT("meta") && Extension != TEXT("tmp");
+}
+
+bool FFileConvertersIFCCache::MakeKey(const FIFCConversionJob& Job, uint64& OutKey, FString& ErrorCode)
+{
+    const TSharedPtr<FFileConvertersMappedFile, ESPMode::ThreadSafe> MappedFile = FFileConvertersMappedFile::Open(Job.InputPath, ErrorCode);
+
+    if (MappedFile.IsValid() == false)
+    {
+        return false;
+    }
+
+    // Content, not path or timestamp, so copies and re-exports of the same model still hit.
+    FXxHash64Builder ContentHash;
+    ContentHash.Update(MappedFile->GetData(), uint64(MappedFile->GetSize()));
+
+    FString ConverterVersion = Job.ConverterVersion;
+
+    if (ConverterVersion.IsEmpty() == true)
+    {
+        const FFileStatData StatData = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*Job.ConverterPath);
+
+        if (StatData.bIsValid == false)
+        {
+            ErrorCode = "Converter executable doesn't exist.";
+            return false;
+        }
+
+        // Updated converters nearly always change size or timestamp.
+        ConverterVersion = FString::Printf(TEXT("%lld|%lld"), StatData.FileSize, StatData.ModificationTime.GetTicks());
+    }
+
+    const FString KeySource = FString::Printf(TEXT("%016llx|%lld|%s|%s|%s"), ContentHash.Finalize().Hash, MappedFile->GetSize(), *Job.Arguments, *ConverterVersion, *FPaths::GetExtension(Job.OutputPath).ToLower());
+    OutKey = FXxHash64::HashBuffer(*KeySource, KeySource.Len() * sizeof(TCHAR)).Hash;
+
+    ErrorCode = "Success";
+    return true;
+}
+
+bool FFileConvertersIFCCache::Restore(uint64 Key, const FString& OutputPath)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const FString EntryPath = GetEntryPath(Key, FPaths::GetExtension(OutputPath).ToLower());
+
+    bool bIsHit = PlatformFile.FileExists(*EntryPath);
+
+    if (bIsHit == true)
+    {
+        // Caller never sees a half written output, even if a watcher picks it up while copying.
+        const FString TempPath = OutputPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+        PlatformFile.CreateDirectoryTree(*FPaths::GetPath(OutputPath));
+        bIsHit = IFileManager::Get().Copy(*TempPath, *EntryPath, true, true) == COPY_OK && IFileManager::Get().Move(*OutputPath, *TempPath, true, true) == true;
+
+        if (bIsHit == false)
+        {
+            PlatformFile.DeleteFile(*TempPath);
+        }
+    }
+
+    FString MetaText;
+    const double ConvertSeconds = bIsHit == true && FFileHelper::LoadFileToString(MetaText, *FPaths::ChangeExtension(EntryPath, TEXT("meta"))) == true ? FCString::Atod(*MetaText) : 0.0;
+
+    FScopeLock Lock(&Guard);
+
+    if (bIsHit == false)
+    {
+        MissCount++;
+        return false;
+    }
+
+    // Refresh timestamp, so eviction sees this entry as recently used.
+    PlatformFile.SetTimeStamp(*EntryPath, FDateTime::UtcNow());
+
+    HitCount++;
+    BytesSaved += PlatformFile.FileSize(*EntryPath);
+    SecondsSaved += ConvertSeconds;
+
+    return true;
+}
+
+void FFileConvertersIFCCache::Store(uint64 Key, const FString& OutputPath, double ConvertSeconds)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const int64 OutputSize = PlatformFile.FileSize(*OutputPath);
+    const FString EntryPath = GetEntryPath(Key, FPaths::GetExtension(OutputPath).ToLower());
+
+    {
+        FScopeLock Lock(&Guard);
+
+        ScanUsedBytes();
+
+        if (OutputSize < 0 || OutputSize > BudgetBytes)
+        {
+            return;
+        }
+    }
+
+    // Output is kept at its path for caller, cache gets a copy. Copy runs without lock, a big model would block other jobs' restores.
+    const FString TempPath = EntryPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+    PlatformFile.CreateDirectoryTree(*GetCacheDir());
+
+    if (PlatformFile.CopyFile(*TempPath, *OutputPath) == false)
+    {
+        PlatformFile.DeleteFile(*TempPath);
+        return;
+    }
+
+    FScopeLock Lock(&Guard);
+
+    // Two jobs with same input may finish one after another, entry of the first one is as good.
+    if (PlatformFile.FileExists(*EntryPath) == true || PlatformFile.MoveFile(*EntryPath, *TempPath) == false)
+    {
+        PlatformFile.DeleteFile(*TempPath);
+        return;
+    }
+
+    FFileHelper::SaveStringToFile(FString::Printf(TEXT("%f"), ConvertSeconds), *FPaths::ChangeExtension(EntryPath, TEXT("meta")));
+
+    UsedBytes += OutputSize;
+    EntryCount++;
+    EvictToBudget();
+}
+
+void FFileConvertersIFCCache::ScanUsedBytes()
+{
+    if (UsedBytes != INDEX_NONE)
+    {
+        return;
+    }
+
+    UsedBytes = 0;
+    EntryCount = 0;
+    FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStat(*GetCacheDir(), [this](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory == false && IsEntry(CharPath) == true)
+            {
+                UsedBytes += StatData.FileSize;
+                EntryCount++;
+            }
+
+            return true;
+        }
+    );
+}
+
+void FFileConvertersIFCCache::EvictToBudget()
+{
+    if (UsedBytes <= BudgetBytes)
+    {
+        return;
+    }
+
+    struct FCacheEntry
+    {
+        FString Path;
+        int64 Size;
+        FDateTime LastUsed;
+    };
+
+    TArray<FCacheEntry> Array_Entries;
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    PlatformFile.IterateDirectoryStat(*GetCacheDir(), [&Array_Entries](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory == false && IsEntry(CharPath) == true)
+            {
+                Array_Entries.Add({ CharPath, StatData.FileSize, StatData.ModificationTime });
+            }
+
+            return true;
+        }
+    );
+
+    Array_Entries.Sort([](const FCacheEntry& A, const FCacheEntry& B) { return A.LastUsed < B.LastUsed; });
+
+    UsedBytes = 0;
+    EntryCount = Array_Entries.Num();
+    for (const FCacheEntry& EachEntry : Array_Entries)
+    {
+        UsedBytes += EachEntry.Size;
+    }
+
+    for (const FCacheEntry& EachEntry : Array_Entries)
+    {
+        if (UsedBytes <= BudgetBytes)
+        {
+            break;
+        }
+
+        if (PlatformFile.DeleteFile(*EachEntry.Path) == true)
+        {
+            PlatformFile.DeleteFile(*FPaths::ChangeExtension(EachEntry.Path, TEXT("meta")));
+            UsedBytes -= EachEntry.Size;
+            EntryCount--;
+        }
+    }
+}
+
+void FFileConvertersIFCCache::SetBudget(int64 InBudgetBytes)
+{
+    FScopeLock Lock(&Guard);
+    BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+    ScanUsedBytes();
+    EvictToBudget();
+}
+
+void FFileConvertersIFCCache::Clear()
+{
+    FScopeLock Lock(&Guard);
+    FPlatformFileManager::Get().GetPlatformFile().DeleteDirectoryRecursively(*GetCacheDir());
+    UsedBytes = 0;
+    EntryCount = 0;
+}
+
+FIFCCacheStats FFileConvertersIFCCache::GetStats()
+{
+    FScopeLock Lock(&Guard);
+
+    ScanUsedBytes();
+
+    FIFCCacheStats Stats;
+    Stats.EntryCount = EntryCount;
+    Stats.UsedBytes = UsedBytes;
+    Stats.BudgetBytes = BudgetBytes;
+    Stats.HitCount = HitCount;
+    Stats.MissCount = MissCount;
+    Stats.HitRate = HitCount + MissCount > 0 ? float(double(HitCount) / double(HitCount + MissCount)) : 0.0f;
+    Stats.BytesSaved = BytesSaved;
+    Stats.SecondsSaved = float(SecondsSaved);
+
+    return Stats;
+}
+
+FFileConvertersIFCPool& FFileConvertersIFCPool::Get()
+{
+    static FFileConvertersIFCPool Pool;
+    return Pool;
+}
+
+FString FFileConvertersIFCPool::GetDefaultOutputPath(const FString& InputPath)
+{
+    return FPaths::ChangeExtension(InputPath, TEXT("dae"));
+}
+
+int32 FFileConvertersIFCPool::QueueJob(const FIFCConversionJob& Job, FDelegateIFCConversion DelegateConversion, FDelegateIFCProgress DelegateProgress)
+{
+    const FJobPtr NewJob = MakeShared<FJob, ESPMode::ThreadSafe>();
+    NewJob->Descriptor = Job;
+    NewJob->Delegate = DelegateConversion;
+    NewJob->DelegateProgress = DelegateProgress;
+    NewJob->QueueTime = FPlatformTime::Seconds();
+
+    // Converter runs in its own folder, so relative paths would point somewhere else.
+    NewJob->Descriptor.ConverterPath = FPaths::ConvertRelativePathToFull(Job.ConverterPath);
+    NewJob->Descriptor.InputPath = FPaths::ConvertRelativePathToFull(Job.InputPath);
+    NewJob->Descriptor.OutputPath = FPaths::ConvertRelativePathToFull(Job.OutputPath.IsEmpty() ? GetDefaultOutputPath(Job.InputPath) : Job.OutputPath);
+
+    FScopeLock Lock(&Guard);
+
+    NewJob->JobHandle = NextJobHandle++;
+    Jobs.Add(NewJob->JobHandle, NewJob);
+
+    if (NewJob->Descriptor.bUseCache == true)
+    {
+        // Hashing a big model takes a while, it doesn't hold game thread or a converter slot.
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, NewJob]()
+            {
+                ResolveCache(NewJob);
+            }
+        );
+
+        return NewJob->JobHandle;
+    }
+
+    QueuedJobs.Add(NewJob);
+    StartJobs();
+
+    return NewJob->JobHandle;
+}
+
+bool FFileConvertersIFCPool::CancelJob(int32 JobHandle)
+{
+    FJobPtr Job;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        const FJobPtr* FoundJob = Jobs.Find(JobHandle);
+
+        if (FoundJob == nullptr || ((*FoundJob)->State != EIFCConversionState::Queued && (*FoundJob)->State != EIFCConversionState::Running) || (*FoundJob)->bIsCancelRequested == true)
+        {
+            return false;
+        }
+
+        Job = *FoundJob;
+        Job->bIsCancelRequested = true;
+
+        // Running converters are terminated by monitor at its next poll.
+        if (Job->State == EIFCConversionState::Running)
+        {
+            MonitorEvent->Trigger();
+            return true;
+        }
+
+        QueuedJobs.Remove(Job);
+    }
+
+    FinishJob(Job, EIFCConversionState::Cancelled, TEXT("Conversion is cancelled."));
+    return true;
+}
+
+EIFCConversionState FFileConvertersIFCPool::GetProgress(int32 JobHandle, float& OutProgress) const
+{
+    OutProgress = 0;
+
+    FScopeLock Lock(&Guard);
+
+    const FJobPtr* FoundJob = Jobs.Find(JobHandle);
+
+    if (FoundJob == nullptr)
+    {
+        return EIFCConversionState::Unknown;
+    }
+
+    OutProgress = (*FoundJob)->Progress;
+    return (*FoundJob)->State;
+}
+
+void FFileConvertersIFCPool::SetConcurrency(int32 InMaxProcesses, int32 InMemoryPerProcessMB)
+{
+    FScopeLock Lock(&Guard);
+
+    MaxProcesses = FMath::Max(InMaxProcesses, 0);
+    MemoryPerProcessMB = FMath::Max(InMemoryPerProcessMB, 1);
+
+    StartJobs();
+}
+
+FIFCConversionStats FFileConvertersIFCPool::GetStats() const
+{
+    FScopeLock Lock(&Guard);
+
+    FIFCConversionStats Stats;
+    Stats.QueuedJobCount = QueuedJobs.Num();
+    Stats.RunningJobCount = RunningJobs.Num();
+    Stats.SucceededJobCount = SucceededJobCount;
+    Stats.FailedJobCount = FailedJobCount;
+    Stats.CancelledJobCount = CancelledJobCount;
+    Stats.TimedOutJobCount = TimedOutJobCount;
+    Stats.MaxProcesses = GetMaxProcesses();
+
+    return Stats;
+}
+
+void FFileConvertersIFCPool::Shutdown()
+{
+    FRunnableThread* Thread = nullptr;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        bIsShuttingDown = true;
+        Thread = MonitorThread;
+        MonitorThread = nullptr;
+    }
+
+    // Monitor may be polling a job right now, its handles and pipes are closed only after it is gone.
+    if (Thread != nullptr)
+    {
+        Thread->Kill(true);
+        delete Thread;
+    }
+
+    FScopeLock Lock(&Guard);
+
+    if (MonitorEvent != nullptr)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(MonitorEvent);
+        MonitorEvent = nullptr;
+    }
+
+    Monitor.Reset();
+
+    // Converters would outlive the editor otherwise.
+    for (const FJobPtr& EachJob : RunningJobs)
+    {
+        if (EachJob->ProcessHandle.IsValid() == true)
+        {
+            FPlatformProcess::TerminateProc(EachJob->ProcessHandle, true);
+        }
+    }
+
+    QueuedJobs.Empty();
+    RunningJobs.Empty();
+    FinishedHandles.Empty();
+    Jobs.Empty();
+}
+
+int32 FFileConvertersIFCPool::GetMaxProcesses() const
+{
+    const int32 CoreLimit = MaxProcesses > 0 ? MaxProcesses : FPlatformMisc::NumberOfCores();
+    const int64 MemoryLimit = int64(FPlatformMemory::GetConstants().TotalPhysical / (uint64(MemoryPerProcessMB) * 1024 * 1024));
+
+    return int32(FMath::Max<int64>(FMath::Min<int64>(CoreLimit, MemoryLimit), 1));
+}
+
+void FFileConvertersIFCPool::ResolveCache(const FJobPtr& Job)
+{
+    uint64 CacheKey = 0;
+    FString ErrorCode;
+
+    // Inputs that can't be hashed are left to converter, it reports missing files itself.
+    const bool bHasCacheKey = FFileConvertersIFCCache::MakeKey(Job->Descriptor, CacheKey, ErrorCode);
+
+    if (bHasCacheKey == true && FFileConvertersIFCCache::Get().Restore(CacheKey, Job->Descriptor.OutputPath) == true)
+    {
+        Job->bIsCacheHit = true;
+        FinishJob(Job, EIFCConversionState::Succeeded, TEXT("Success"));
+        return;
+    }
+
+    FScopeLock Lock(&Guard);
+
+    // Cancelled or shut down while hashing.
+    if (Job->bIsFinished == true || bIsShuttingDown == true)
+    {
+        return;
+    }
+
+    Job->CacheKey = CacheKey;
+    Job->bHasCacheKey = bHasCacheKey;
+
+    QueuedJobs.Add(Job);
+    StartJobs();
+}
+
+void FFileConvertersIFCPool::StartJobs()
+{
+    if (bIsShuttingDown == true)
+    {
+        return;
+    }
+
+    const int32 ProcessLimit = GetMaxProcesses();
+    const uint64 MemoryPerProcess = uint64(MemoryPerProcessMB) * 1024 * 1024;
+    const double Now = FPlatformTime::Seconds();
+
+    // Converters launched a moment ago haven't taken their memory yet, available memory doesn't show them.
+    uint64 ReservedMemory = 0;
+
+    for (const FJobPtr& EachJob : RunningJobs)
+    {
+        if (Now - EachJob->StartTime < RampUpSeconds)
+        {
+            ReservedMemory += MemoryPerProcess;
+        }
+    }
+
+    const uint64 AvailableMemory = FPlatformMemory::GetStats().AvailablePhysical;
+    const int32 RunningCount = RunningJobs.Num();
+
+    while (QueuedJobs.IsEmpty() == false && RunningJobs.Num() < ProcessLimit)
+    {
+        // Big models take gigabytes. One converter always runs, so small machines still make progress.
+        if (RunningJobs.IsEmpty() == false && AvailableMemory < ReservedMemory + MemoryPerProcess)
+        {
+            break;
+        }
+
+        const FJobPtr Job = QueuedJobs[0];
+        QueuedJobs.RemoveAt(0);
+
+        Job->State = EIFCConversionState::Running;
+        Job->StartTime = FPlatformTime::Seconds();
+        Launch(*Job);
+
+        RunningJobs.Add(Job);
+        ReservedMemory += MemoryPerProcess;
+    }
+
+    // Monitor calls this every poll, it is woken only when there is something new to poll.
+    if (RunningJobs.Num() == RunningCount)
+    {
+        return;
+    }
+
+    if (MonitorThread == nullptr)
+    {
+        MonitorEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        Monitor = MakeUnique<FMonitor>(*this);
+        MonitorThread = FRunnableThread::Create(Monitor.Get(), TEXT("FileConvertersIFCMonitor"), 0, TPri_BelowNormal);
+    }
+
+    MonitorEvent->Trigger();
+}
+
+void FFileConvertersIFCPool::Launch(FJob& Job)
+{
+    const FIFCConversionJob& Descriptor = Job.Descriptor;
+
+    if (FPaths::FileExists(Descriptor.ConverterPath) == false)
+    {
+        Job.LaunchError = "Converter executable doesn't exist.";
+        return;
+    }
+
+    if (FPaths::FileExists(Descriptor.InputPath) == false)
+    {
+        Job.LaunchError = "Input file doesn't exist.";
+        return;
+    }
+
+    // Same extension keeps converter's format detection working.
+    Job.TempOutputPath = FPaths::GetPath(Descriptor.OutputPath) / FPaths::GetBaseFilename(Descriptor.OutputPath) + TEXT(".converting.") + FPaths::GetExtension(Descriptor.OutputPath);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Descriptor.OutputPath));
+    PlatformFile.DeleteFile(*Job.TempOutputPath);
+
+    if (FPlatformProcess::CreatePipe(Job.StdOut.Read, Job.StdOut.Write) == false || FPlatformProcess::CreatePipe(Job.StdErr.Read, Job.StdErr.Write) == false)
+    {
+        ClosePipes(Job);
+        Job.LaunchError = "Converter pipes can't be created.";
+        return;
+    }
+
+    const FString Params = FString::Printf(TEXT("%s \"%s\" \"%s\""), *Descriptor.Arguments, *Descriptor.InputPath, *Job.TempOutputPath);
+    const FString WorkingDirectory = FPaths::GetPath(Descriptor.ConverterPath);
+
+    Job.ProcessHandle = FPlatformProcess::CreateProc(*Descriptor.ConverterPath, *Params, false, true, true, nullptr, 0, *WorkingDirectory, Job.StdOut.Write, nullptr, Job.StdErr.Write);
+
+    if (Job.ProcessHandle.IsValid() == false)
+    {
+        ClosePipes(Job);
+        Job.LaunchError = "Converter process can't be started.";
+    }
+}
+
+FFileConvertersIFCPool::FMonitor::FMonitor(FFileConvertersIFCPool& InPool) : Pool(InPool)
+{
+}
+
+uint32 FFileConvertersIFCPool::FMonitor::Run()
+{
+    Pool.RunMonitor();
+    return 0;
+}
+
+void FFileConvertersIFCPool::FMonitor::Stop()
+{
+    // Shutdown flag is already set, monitor only has to wake up to see it.
+    Pool.MonitorEvent->Trigger();
+}
+
+void FFileConvertersIFCPool::RunMonitor()
+{
+    while (true)
+    {
+        TArray<FJobPtr> Array_Running;
+
+        {
+            FScopeLock Lock(&Guard);
+
+            if (bIsShuttingDown == true)
+            {
+                return;
+            }
+
+            // Slots may have been held back by memory, retry while converters run.
+            StartJobs();
+
+            Array_Running = RunningJobs;
+        }
+
+        if (Array_Running.IsEmpty() == true)
+        {
+            MonitorEvent->Wait();
+            continue;
+        }
+
+        for (const FJobPtr& EachJob : Array_Running)
+        {
+            EIFCConversionState FinalState = EIFCConversionState::Failed;
+            FString ErrorCode;
+
+            if (PollJob(*EachJob, FinalState, ErrorCode) == true)
+            {
+                FinishJob(EachJob, FinalState, ErrorCode);
+            }
+        }
+
+        // Cancels wake monitor early.
+        MonitorEvent->Wait(FTimespan::FromSeconds(PollInterval));
+    }
+}
+
+bool FFileConvertersIFCPool::PollJob(FJob& Job, EIFCConversionState& OutFinalState, FString& OutErrorCode)
+{
+    if (Job.ProcessHandle.IsValid() == false)
+    {
+        OutFinalState = EIFCConversionState::Failed;
+        OutErrorCode = Job.LaunchError;
+        return true;
+    }
+
+    ReadPipes(Job);
+
+    bool bIsCancelRequested = false;
+
+    {
+        FScopeLock Lock(&Guard);
+        bIsCancelRequested = Job.bIsCancelRequested;
+    }
+
+    if (bIsCancelRequested == true)
+    {
+        Terminate(Job);
+        OutFinalState = EIFCConversionState::Cancelled;
+        OutErrorCode = "Conversion is cancelled.";
+        return true;
+    }
+
+    if (Job.Descriptor.TimeoutSeconds > 0 && FPlatformTime::Seconds() - Job.StartTime > Job.Descriptor.TimeoutSeconds)
+    {
+        Terminate(Job);
+        OutFinalState = EIFCConversionState::TimedOut;
+        OutErrorCode = "Converter timed out.";
+        return true;
+    }
+
+    if (FPlatformProcess::IsProcRunning(Job.ProcessHandle) == true)
+    {
+        return false;
+    }
+
+    // Converters often print their summary right before exiting.
+    ReadPipes(Job);
+    FPlatformProcess::GetProcReturnCode(Job.ProcessHandle, &Job.ExitCode);
+
+    OutFinalState = EIFCConversionState::Failed;
+
+    if (Job.ExitCode != 0)
+    {
+        OutErrorCode = "Converter exited with an error.";
+    }
+
+    else if (FPaths::FileExists(Job.TempOutputPath) == false)
+    {
+        OutErrorCode = "Converter didn't write output file.";
+    }
+
+    else if (IFileManager::Get().Move(*Job.Descriptor.OutputPath, *Job.TempOutputPath, true, true) == false)
+    {
+        OutErrorCode = "Output file can't be written.";
+    }
+
+    else
+    {
+        OutFinalState = EIFCConversionState::Succeeded;
+        OutErrorCode = "Success";
+
+        if (Job.bHasCacheKey == true)
+        {
+            const uint64 CacheKey = Job.CacheKey;
+            const FString OutputPath = Job.Descriptor.OutputPath;
+            const double ConvertSeconds = FPlatformTime::Seconds() - Job.StartTime;
+
+            // Copying a big output would hold polls of other converters.
+            AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [CacheKey, OutputPath, ConvertSeconds]()
+                {
+                    FFileConvertersIFCCache::Get().Store(CacheKey, OutputPath, ConvertSeconds);
+                }
+            );
+        }
+    }
+
+    return true;
+}
+
+void FFileConvertersIFCPool::ReadPipes(FJob& Job)
+{
+    float NewProgress = -1.0f;
+
+    for (FPipe* EachPipe : { &Job.StdOut, &Job.StdErr })
+    {
+        const FString Text = FPlatformProcess::ReadPipe(EachPipe->Read);
+
+        if (Text.IsEmpty() == true)
+        {
+            continue;
+        }
+
+        Job.Output += Text;
+        if (Job.Output.Len() > MaxOutputLength)
+        {
+            Job.Output = Job.Output.Right(MaxOutputLength);
+        }
+
+        float Progress = 0;
+        if (ParseProgress(EachPipe->Carry + Text, Progress) == true)
+        {
+            NewProgress = FMath::Max(NewProgress, Progress);
+        }
+
+        EachPipe->Carry = Text.Right(16);
+    }
+
+    if (NewProgress < 0)
+    {
+        return;
+    }
+
+    {
+        FScopeLock Lock(&Guard);
+
+        // Only whole percent steps are reported, so a chatty converter doesn't flood game thread.
+        if (FMath::FloorToInt(NewProgress * 100) <= FMath::FloorToInt(Job.Progress * 100))
+        {
+            return;
+        }
+
+        Job.Progress = NewProgress;
+    }
+
+    AsyncTask(ENamedThreads::GameThread, [DelegateProgress = Job.DelegateProgress, JobHandle = Job.JobHandle, NewProgress]()
+        {
+            DelegateProgress.ExecuteIfBound(JobHandle, NewProgress);
+        }
+    );
+}
+
+bool FFileConvertersIFCPool::ParseProgress(const FString& Text, float& OutProgress)
+{
+    for (int32 CharIndex = Text.Len() - 1; CharIndex > 0; CharIndex--)
+    {
+        if (Text[CharIndex] != TEXT('%'))
+        {
+            continue;
+        }
+
+        int32 StartIndex = CharIndex;
+        while (StartIndex > 0 && (FChar::IsDigit(Text[StartIndex - 1]) == true || Text[StartIndex - 1] == TEXT('.')))
+        {
+            StartIndex--;
+        }
+
+        if (StartIndex == CharIndex)
+        {
+            continue;
+        }
+
+        OutProgress = FMath::Clamp(FCString::Atof(*Text.Mid(StartIndex, CharIndex - StartIndex)) / 100.0f, 0.0f, 1.0f);
+        return true;
+    }
+
+    return false;
+}
+
+void FFileConvertersIFCPool::Terminate(FJob& Job)
+{
+    // Converters may start helpers of their own, tree is killed. Waiting releases output file handles before cleanup.
+    FPlatformProcess::TerminateProc(Job.ProcessHandle, true);
+    FPlatformProcess::WaitForProc(Job.ProcessHandle);
+}
+
+void FFileConvertersIFCPool::ClosePipes(FJob& Job)
+{
+    for (FPipe* EachPipe : { &Job.StdOut, &Job.StdErr })
+    {
+        if (EachPipe->Read != nullptr || EachPipe->Write != nullptr)
+        {
+            FPlatformProcess::ClosePipe(EachPipe->Read, EachPipe->Write);
+            EachPipe->Read = nullptr;
+            EachPipe->Write = nullptr;
+        }
+    }
+}
+
+void FFileConvertersIFCPool::FinishJob(const FJobPtr& Job, EIFCConversionState FinalState, const FString& ErrorCode)
+{
+    {
+        FScopeLock Lock(&Guard);
+
+        // Cancel may race with a cache hit.
+        if (Job->bIsFinished == true)
+        {
+            return;
+        }
+
+        Job->bIsFinished = true;
+    }
+
+    if (Job->ProcessHandle.IsValid() == true)
+    {
+        FPlatformProcess::CloseProc(Job->ProcessHandle);
+    }
+
+    ClosePipes(*Job);
+
+    if (FinalState != EIFCConversionState::Succeeded && Job->TempOutputPath.IsEmpty() == false)
+    {
+        FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Job->TempOutputPath);
+    }
+
+    const double FinishTime = FPlatformTime::Seconds();
+
+    FIFCConversionResult Result;
+    Result.JobHandle = Job->JobHandle;
+    Result.InputPath = Job->Descriptor.InputPath;
+    Result.OutputPath = FinalState == EIFCConversionState::Succeeded ? Job->Descriptor.OutputPath : FString();
+    Result.ExitCode = Job->ExitCode;
+    Result.Output = Job->Output;
+    Result.bIsCacheHit = Job->bIsCacheHit;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        if (bIsShuttingDown == true)
+        {
+            return;
+        }
+
+        Result.QueueSeconds = float((Job->StartTime > 0 ? Job->StartTime : FinishTime) - Job->QueueTime);
+        Result.Seconds = Job->StartTime > 0 ? float(FinishTime - Job->StartTime) : 0.0f;
+
+        Job->State = FinalState;
+        Job->Progress = FinalState == EIFCConversionState::Succeeded ? 1.0f : Job->Progress;
+        RunningJobs.Remove(Job);
+
+        switch (FinalState)
+        {
+        case EIFCConversionState::Succeeded:
+            SucceededJobCount++;
+            break;
+
+        case EIFCConversionState::Cancelled:
+            CancelledJobCount++;
+            break;
+
+        case EIFCConversionState::TimedOut:
+            TimedOutJobCount++;
+            break;
+
+        default:
+            FailedJobCount++;
+            break;
+        }
+
+        FinishedHandles.Add(Job->JobHandle);
+
+        while (FinishedHandles.Num() > MaxFinishedJobs)
+        {
+            Jobs.Remove(FinishedHandles[0]);
+            FinishedHandles.RemoveAt(0);
+        }
+
+        StartJobs();
+    }
+
+    if (FinalState != EIFCConversionState::Succeeded)
+    {
+        UE_LOG(LogFileConverters, Warning, TEXT("IFC conversion of %s: %s"), *Job->Descriptor.InputPath, *ErrorCode);
+    }
+
+    AsyncTask(ENamedThreads::GameThread, [Delegate = Job->Delegate, bIsSuccessful = FinalState == EIFCConversionState::Succeeded, ErrorCode, Result = MoveTemp(Result)]()
+        {
+            Delegate.ExecuteIfBound(bIsSuccessful, ErrorCode, Result);
+        }
+    );
+}
@@ -0,0 +1,273 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "HAL/Runnable.h"
+
+class FEvent;
+class FRunnableThread;
+
+/*
+*	Streaming tokenizer of STEP (ISO 10303-21) files. Reads header fields and counts DATA entities by type without building them.
+*	File is memory mapped. DATA section is split into chunks at record starts and chunks are scanned in parallel, each with its own histogram.
+*	Record ends and quotes are found with SSE2 16 bytes at a time, so semicolons inside strings don't split records.
+*/
+class FFileConvertersIFCScanner
+{
+public:
+
+	/* Smaller chunks aren't worth a task. */
+	static constexpr int64 MinChunkSize = 4 * 1024 * 1024;
+	static constexpr int32 MaxChunkCount = 256;
+
+	/* Any thread. */
+	static bool Scan(const FString& FilePath, FIFCScanResult& OutResult, FString& ErrorCode);
+
+private:
+
+	struct FTypeCount
+	{
+		/* Points into mapped file. */
+		const ANSICHAR* Name = nullptr;
+		int32 NameLength = 0;
+
+		int64 Count = 0;
+		int64 Bytes = 0;
+	};
+
+	/* Keyed by hash of type name. */
+	using FHistogram = TMap<uint64, FTypeCount>;
+
+	struct FChunk
+	{
+		FHistogram Histogram;
+		int64 EntityCount = 0;
+
+		/* IFCPROJECT record, if chunk has it. */
+		const uint8* ProjectBegin = nullptr;
+		const uint8* ProjectEnd = nullptr;
+	};
+
+	/* First byte equal to A or B, End if there is none. */
+	static const uint8* FindEither(const uint8* Cursor, const uint8* End, uint8 A, uint8 B);
+
+	/* Returns position after the semicolon which ends record starting at Cursor, End if record isn't closed. */
+	static const uint8* FindRecordEnd(const uint8* Cursor, const uint8* End);
+
+	/* First record start after Cursor: a line beginning with '#', digits, optional whitespace and '='. Other lines are skipped. DATA writers put every record on its own line. */
+	static const uint8* FindChunkStart(const uint8* Cursor, const uint8* End);
+
+	static void ScanChunk(const uint8* Begin, const uint8* End, FChunk& OutChunk);
+
+	/* Keyword or entity type at cursor. */
+	static FAnsiStringView ReadKeyword(const uint8* Cursor, const uint8* End);
+
+	/* Top level parameters of a record, each as written in file. */
+	static void ReadParameters(const uint8* Begin, const uint8* End, TArray<FAnsiStringView>& OutParameters);
+
+	/* Strips list parentheses and quotes, decodes '' and \X\, \X2\ escapes. "$" gives empty string. */
+	static FString DecodeString(FAnsiStringView Parameter);
+
+	static bool IsGeometryType(FAnsiStringView Type);
+};
+
+/*
+*	Persistent cache of converter outputs under Saved/FileConverters/IFCCache.
+*	Entries are content addressed: key covers input file content, converter arguments, output format and converter version, so renamed or copied inputs still hit.
+*	Each entry has a .meta sidecar with converter run time. Hits refresh the entry timestamp, eviction removes the least recently used entries until the disk budget fits.
+*/
+class FFileConvertersIFCCache
+{
+public:
+
+	static FFileConvertersIFCCache& Get();
+
+	/* Hashes whole input through a memory mapped view. Any thread, takes time for big models. */
+	static bool MakeKey(const FIFCConversionJob& Job, uint64& OutKey, FString& ErrorCode);
+
+	/* Copies entry to a temporary file next to output path and renames it. Returns false on miss. Counts hit or miss. */
+	bool Restore(uint64 Key, const FString& OutputPath);
+
+	/* Copies a converted output to a temporary file in cache without holding Guard, then renames it to entry. Worker thread. */
+	void Store(uint64 Key, const FString& OutputPath, double ConvertSeconds);
+
+	void SetBudget(int64 InBudgetBytes);
+	void Clear();
+	FIFCCacheStats GetStats();
+
+private:
+
+	FString GetCacheDir() const;
+	FString GetEntryPath(uint64 Key, const FString& Extension) const;
+
+	static bool IsEntry(const TCHAR* CharPath);
+
+	/* Needs Guard. Scans cache folder once to learn used bytes and entry count. */
+	void ScanUsedBytes();
+
+	/* Needs Guard. Removes oldest entries with their sidecars until used bytes fit into budget. */
+	void EvictToBudget();
+
+	FCriticalSection Guard;
+	int64 BudgetBytes = 8LL * 1024LL * 1024LL * 1024LL;
+	int64 UsedBytes = INDEX_NONE;
+	int32 EntryCount = 0;
+
+	int64 HitCount = 0;
+	int64 MissCount = 0;
+	int64 BytesSaved = 0;
+	double SecondsSaved = 0;
+};
+
+/*
+*	Pool of external IFC converter processes.
+*	Jobs wait in a queue, at most GetMaxProcesses() converters run at once. A converter is added to running ones only while available memory fits one more besides the ones still starting.
+*	One monitor thread polls all running converters: reads their stdout and stderr pipes, parses progress, enforces timeouts and cancellation. It waits for an event when nothing runs.
+*	Jobs using the cache are hashed on a worker before they are queued, a hit finishes without a converter.
+*	Nothing depends on ticking, so pool also works in commandlets. Delegates run on game thread, everything else is thread safe.
+*/
+class FFileConvertersIFCPool
+{
+public:
+
+	/* Finished jobs kept for progress queries. A whole batch of conversions fits. */
+	static constexpr int32 MaxFinishedJobs = 256;
+
+	/* Characters of converter output kept for result. */
+	static constexpr int32 MaxOutputLength = 4096;
+
+	static constexpr float PollInterval = 0.01f;
+
+	/* Converter doesn't reach its working set right after launch. Its memory is reserved this long, so a burst of launches doesn't pass the check together. */
+	static constexpr double RampUpSeconds = 10.0;
+
+	static FFileConvertersIFCPool& Get();
+
+	/* Used when job has no output path. */
+	static FString GetDefaultOutputPath(const FString& InputPath);
+
+	/* Returns job handle. */
+	int32 QueueJob(const FIFCConversionJob& Job, FDelegateIFCConversion DelegateConversion, FDelegateIFCProgress DelegateProgress);
+
+	/* Returns false if job is unknown or already finished. */
+	bool CancelJob(int32 JobHandle);
+
+	EIFCConversionState GetProgress(int32 JobHandle, float& OutProgress) const;
+
+	void SetConcurrency(int32 InMaxProcesses, int32 InMemoryPerProcessMB);
+	FIFCConversionStats GetStats() const;
+
+	/* Called by module shutdown. Monitor thread is stopped and joined first, then running converters are terminated. No delegates fire. */
+	void Shutdown();
+
+private:
+
+	struct FPipe
+	{
+		void* Read = nullptr;
+		void* Write = nullptr;
+
+		/* Tail of last read, a progress value may be split between two reads. */
+		FString Carry;
+	};
+
+	struct FJob
+	{
+		int32 JobHandle = INDEX_NONE;
+		FIFCConversionJob Descriptor;
+		FDelegateIFCConversion Delegate;
+		FDelegateIFCProgress DelegateProgress;
+		double QueueTime = 0;
+
+		/* Guarded by pool. */
+		EIFCConversionState State = EIFCConversionState::Queued;
+		float Progress = 0;
+		bool bIsCancelRequested = false;
+		bool bIsFinished = false;
+		double StartTime = 0;
+
+		/* Set by cache lookup before job is queued. */
+		uint64 CacheKey = 0;
+		bool bHasCacheKey = false;
+		bool bIsCacheHit = false;
+
+		/* Monitor only, after launch. Converter writes here, file is renamed to output path on success. */
+		FString TempOutputPath;
+		FProcHandle ProcessHandle;
+		FPipe StdOut;
+		FPipe StdErr;
+		FString Output;
+		FString LaunchError;
+		int32 ExitCode = -1;
+	};
+
+	using FJobPtr = TSharedPtr<FJob, ESPMode::ThreadSafe>;
+
+	/* Dedicated thread, it sleeps most of the time and would hold a task graph worker otherwise. */
+	class FMonitor : public FRunnable
+	{
+	public:
+
+		FMonitor(FFileConvertersIFCPool& InPool);
+
+		virtual uint32 Run() override;
+		virtual void Stop() override;
+
+	private:
+
+		FFileConvertersIFCPool& Pool;
+	};
+
+	/* Explicit limit or physical cores, capped by how many converters fit into total memory. */
+	int32 GetMaxProcesses() const;
+
+	/* Worker thread. Finishes job on cache hit, queues it otherwise. */
+	void ResolveCache(const FJobPtr& Job);
+
+	/* Needs Guard. Launches queued jobs while there are free slots and memory isn't reserved by other converters, then wakes monitor. Monitor thread is created on first launch. */
+	void StartJobs();
+
+	/* Needs Guard. Failure is kept in LaunchError, monitor finishes the job. */
+	static void Launch(FJob& Job);
+
+	/* Monitor thread. Polls running converters, waits for wake up while none runs. Returns on shutdown. */
+	void RunMonitor();
+
+	/* Monitor. Returns true if job is over. */
+	bool PollJob(FJob& Job, EIFCConversionState& OutFinalState, FString& OutErrorCode);
+
+	/* Monitor. Appends output and reports progress changes. */
+	void ReadPipes(FJob& Job);
+
+	/* Last "NN%" or "NN.N%" of text. */
+	static bool ParseProgress(const FString& Text, float& OutProgress);
+
+	static void Terminate(FJob& Job);
+	static void ClosePipes(FJob& Job);
+
+	/* Removes leftovers, moves job to finished records and queues delegate. Only first call for a job counts. */
+	void FinishJob(const FJobPtr& Job, EIFCConversionState FinalState, const FString& ErrorCode);
+
+	mutable FCriticalSection Guard;
+	TMap<int32, FJobPtr> Jobs;
+	TArray<FJobPtr> QueuedJobs;
+	TArray<FJobPtr> RunningJobs;
+	TArray<int32> FinishedHandles;
+
+	int32 MaxProcesses = 0;
+	int32 MemoryPerProcessMB = 2048;
+	int32 NextJobHandle = 1;
+	bool bIsShuttingDown = false;
+
+	/* Created with monitor thread, triggered by new jobs, cancels and shutdown. */
+	FEvent* MonitorEvent = nullptr;
+	TUniquePtr<FMonitor> Monitor;
+	FRunnableThread* MonitorThread = nullptr;
+
+	int32 SucceededJobCount = 0;
+	int32 FailedJobCount = 0;
+	int32 CancelledJobCount = 0;
+	int32 TimedOutJobCount = 0;
+};
@@ -0,0 +1,779 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersListing.h"
+#include "FileConvertersSearch.h"
+#include "FileConvertersStats.h"
+#include "FileConvertersWatcher.h"
+
+// UE Includes.
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Misc/Paths.h"
+
+namespace FileConvertersListing
+{
+    // Below this, one sort on the calling thread is faster than chunking.
+    static constexpr int32 MinChunkSize = 16384;
+
+    // Folder slots of the LRU. Real limits are entry and byte budgets.
+    static constexpr int32 MaxCachedFolders = 16384;
+
+    // Modified children of one cached folder, which are stat'ed one by one in a single watcher batch.
+    static constexpr int32 MaxModifiedChildren = 256;
+
+    template<typename PredicateType>
+    static void MergeRuns(FFolderContent* Source, int32 Begin, int32 Middle, int32 End, FFolderContent* Target, const PredicateType& Predicate)
+    {
+        int32 LeftIndex = Begin;
+        int32 RightIndex = Middle;
+        int32 TargetIndex = Begin;
+
+        while (LeftIndex < Middle && RightIndex < End)
+        {
+            // Right only wins when it is strictly smaller, so equal entries keep chunk order.
+            if (Predicate(Source[RightIndex], Source[LeftIndex]) == true)
+            {
+                Target[TargetIndex++] = MoveTemp(Source[RightIndex++]);
+            }
+
+            else
+            {
+                Target[TargetIndex++] = MoveTemp(Source[LeftIndex++]);
+            }
+        }
+
+        while (LeftIndex < Middle)
+        {
+            Target[TargetIndex++] = MoveTemp(Source[LeftIndex++]);
+        }
+
+        while (RightIndex < End)
+        {
+            Target[TargetIndex++] = MoveTemp(Source[RightIndex++]);
+        }
+    }
+
+    template<typename PredicateType>
+    static void ParallelSort(TArray<FFolderContent>& Contents, const PredicateType& Predicate)
+    {
+        const int32 EntryCount = Contents.Num();
+        const int32 ChunkCount = FMath::Clamp(EntryCount / MinChunkSize, 1, FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 1));
+
+        if (ChunkCount == 1)
+        {
+            Algo::Sort(Contents, Predicate);
+            return;
+        }
+
+        TArray<int32> Bounds;
+        for (int32 ChunkIndex = 0; ChunkIndex <= ChunkCount; ChunkIndex++)
+        {
+            Bounds.Add(static_cast<int32>(int64(EntryCount) * ChunkIndex / ChunkCount));
+        }
+
+        ParallelFor(ChunkCount, [&Contents, &Bounds, &Predicate](int32 ChunkIndex)
+            {
+                TArrayView<FFolderContent> Chunk(Contents.GetData() + Bounds[ChunkIndex], Bounds[ChunkIndex + 1] - Bounds[ChunkIndex]);
+                Algo::Sort(Chunk, Predicate);
+            }
+        );
+
+        // Neighbour runs are merged in parallel, every round halves the run count. Source and target swap each round.
+        TArray<FFolderContent> Buffer;
+        Buffer.SetNum(EntryCount);
+
+        TArray<FFolderContent>* Source = &Contents;
+        TArray<FFolderContent>* Target = &Buffer;
+
+        while (Bounds.Num() > 2)
+        {
+            const int32 RunCount = Bounds.Num() - 1;
+
+            ParallelFor((RunCount + 1) / 2, [Source, Target, &Bounds, RunCount, &Predicate](int32 PairIndex)
+                {
+                    const int32 Begin = Bounds[PairIndex * 2];
+                    const int32 Middle = Bounds[FMath::Min(PairIndex * 2 + 1, RunCount)];
+                    const int32 End = Bounds[FMath::Min(PairIndex * 2 + 2, RunCount)];
+
+                    MergeRuns(Source->GetData(), Begin, Middle, End, Target->GetData(), Predicate);
+                }
+            );
+
+            TArray<int32> NextBounds;
+            for (int32 BoundIndex = 0; BoundIndex <= RunCount; BoundIndex += 2)
+            {
+                NextBounds.Add(Bounds[BoundIndex]);
+            }
+
+            if (NextBounds.Last() != EntryCount)
+            {
+                NextBounds.Add(EntryCount);
+            }
+
+            Bounds = MoveTemp(NextBounds);
+            Swap(Source, Target);
+        }
+
+        if (Source != &Contents)
+        {
+            Contents = MoveTemp(Buffer);
+        }
+    }
+}
+
+FFileConvertersListing& FFileConvertersListing::Get()
+{
+    static FFileConvertersListing Listing;
+    return Listing;
+}
+
+void FFileConvertersListing::ListFolder(const FString& InPath, TArray<FFolderContent>& OutContents)
+{
+    FFileConvertersListingCache& ListingCache = FFileConvertersListingCache::Get();
+    const int64 ChangeSerial = ListingCache.GetChangeSerial();
+    const FFileStatData FolderStat = FPlatformFileManager::Get().GetPlatformFile().GetStatData(*InPath);
+
+    if (FolderStat.bIsValid == true && ListingCache.Find(InPath, FolderStat, OutContents) == true)
+    {
+        return;
+    }
+
+    ListFolderUncached(InPath, OutContents);
+
+    if (FolderStat.bIsValid == true)
+    {
+        ListingCache.Add(InPath, FolderStat, OutContents, ChangeSerial);
+    }
+}
+
+void FFileConvertersListing::ListFolderUncached(const FString& InPath, TArray<FFolderContent>& OutContents)
+{
+    FILECONVERTERS_PHASE_SCOPE(DirectoryWalk);
+
+    OutContents.Reset();
+
+    FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStat(*InPath, [&OutContents](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            // Size, timestamps and type come with the iteration, no extra stat per entry.
+            const FStringView PathView(CharPath);
+            const FStringView NameView = StatData.bIsDirectory ? FFileConvertersSearch::GetBaseName(PathView) : FFileConvertersSearch::GetCleanName(PathView);
+
+            FFolderContent& EachContent = OutContents.AddDefaulted_GetRef();
+            EachContent.Path = FString(PathView.Len(), PathView.GetData());
+            EachContent.Name = FString(NameView.Len(), NameView.GetData());
+            FFileConvertersSearch::SetStat(EachContent, StatData);
+
+            return true;
+        }
+    );
+
+    PhaseScope_DirectoryWalk.AddItems(OutContents.Num());
+}
+
+int32 FFileConvertersListing::CompareNatural(FStringView A, FStringView B)
+{
+    int32 IndexA = 0;
+    int32 IndexB = 0;
+
+    while (IndexA < A.Len() && IndexB < B.Len())
+    {
+        if (FChar::IsDigit(A[IndexA]) == true && FChar::IsDigit(B[IndexB]) == true)
+        {
+            // Leading zeros don't change the value. After them, longer run is the bigger number.
+            while (IndexA < A.Len() && A[IndexA] == TEXT('0'))
+            {
+                IndexA++;
+            }
+
+            while (IndexB < B.Len() && B[IndexB] == TEXT('0'))
+            {
+                IndexB++;
+            }
+
+            int32 EndA = IndexA;
+            while (EndA < A.Len() && FChar::IsDigit(A[EndA]) == true)
+            {
+                EndA++;
+            }
+
+            int32 EndB = IndexB;
+            while (EndB < B.Len() && FChar::IsDigit(B[EndB]) == true)
+            {
+                EndB++;
+            }
+
+            if (EndA - IndexA != EndB - IndexB)
+            {
+                return EndA - IndexA < EndB - IndexB ? -1 : 1;
+            }
+
+            for (; IndexA < EndA; IndexA++, IndexB++)
+            {
+                if (A[IndexA] != B[IndexB])
+                {
+                    return A[IndexA] < B[IndexB] ? -1 : 1;
+                }
+            }
+
+            continue;
+        }
+
+        const TCHAR CharA = FChar::ToLower(A[IndexA]);
+        const TCHAR CharB = FChar::ToLower(B[IndexB]);
+
+        if (CharA != CharB)
+        {
+            return CharA < CharB ? -1 : 1;
+        }
+
+        IndexA++;
+        IndexB++;
+    }
+
+    const int32 RemainingA = A.Len() - IndexA;
+    const int32 RemainingB = B.Len() - IndexB;
+
+    return RemainingA == RemainingB ? 0 : (RemainingA < RemainingB ? -1 : 1);
+}
+
+void FFileConvertersListing::Sort(TArray<FFolderContent>& Contents, EFolderSortMode SortMode, bool bDescending)
+{
+    auto Predicate = [SortMode, bDescending](const FFolderContent& A, const FFolderContent& B)
+        {
+            if (A.bIsFile != B.bIsFile)
+            {
+                return A.bIsFile == false;
+            }
+
+            int32 Order = 0;
+            switch (SortMode)
+            {
+                case EFolderSortMode::Size:
+                    Order = A.Size == B.Size ? 0 : (A.Size < B.Size ? -1 : 1);
+                    break;
+
+                case EFolderSortMode::ModificationTime:
+                    Order = A.ModificationTime == B.ModificationTime ? 0 : (A.ModificationTime < B.ModificationTime ? -1 : 1);
+                    break;
+
+                default:
+                    break;
+            }
+
+            if (Order == 0)
+            {
+                Order = CompareNatural(A.Name, B.Name);
+            }
+
+            if (Order == 0)
+            {
+                Order = A.Path.Compare(B.Path, ESearchCase::IgnoreCase);
+            }
+
+            return bDescending ? Order > 0 : Order < 0;
+        };
+
+    FileConvertersListing::ParallelSort(Contents, Predicate);
+}
+
+int32 FFileConvertersListing::AddListing(TArray<FFolderContent>&& Contents)
+{
+    check(IsInGameThread());
+
+    const int32 ListingHandle = NextHandle++;
+    Listings.Add(ListingHandle, MoveTemp(Contents));
+
+    return ListingHandle;
+}
+
+bool FFileConvertersListing::GetPage(int32 ListingHandle, int32 Offset, int32 Count, TArray<FFolderContent>& OutContents) const
+{
+    check(IsInGameThread());
+
+    OutContents.Reset();
+
+    const TArray<FFolderContent>* Contents = Listings.Find(ListingHandle);
+
+    if (Contents == nullptr)
+    {
+        return false;
+    }
+
+    Offset = FMath::Max(Offset, 0);
+
+    if (Offset >= Contents->Num())
+    {
+        return true;
+    }
+
+    Count = FMath::Clamp(Count, 0, Contents->Num() - Offset);
+
+    OutContents.Append(Contents->GetData() + Offset, Count);
+    return true;
+}
+
+void FFileConvertersListing::RemoveListing(int32 ListingHandle)
+{
+    check(IsInGameThread());
+
+    Listings.Remove(ListingHandle);
+}
+
+int64 FFileConvertersListingCache::FCachedFolder::GetAllocatedBytes() const
+{
+    return sizeof(FCachedFolder) + PathPrefix.GetAllocatedSize() + NameArena.GetAllocatedSize() + Entries.GetAllocatedSize();
+}
+
+FFileConvertersListingCache& FFileConvertersListingCache::Get()
+{
+    static FFileConvertersListingCache ListingCache;
+    return ListingCache;
+}
+
+FFileConvertersListingCache::FFileConvertersListingCache()
+    : Folders(FileConvertersListing::MaxCachedFolders)
+{
+    FFileConvertersWatcher::Get().OnFolderChanges.AddRaw(this, &FFileConvertersListingCache::HandleFolderChanges);
+    FFileConvertersWatcher::Get().OnWatchChanged.AddRaw(this, &FFileConvertersListingCache::HandleWatchChanged);
+}
+
+bool FFileConvertersListingCache::Find(const FString& InPath, const FFileStatData& FolderStat, TArray<FFolderContent>& OutContents)
+{
+    const FString Key = FFileConvertersWatcher::NormalizePath(InPath);
+    FCachedFolderPtr CachedFolder;
+    bool bRevalidate = false;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        const FCachedFolderPtr* FoundFolder = Folders.FindAndTouch(Key);
+
+        if (FoundFolder == nullptr)
+        {
+            MissCount++;
+            return false;
+        }
+
+        if ((*FoundFolder)->FolderModificationTicks != FolderStat.ModificationTime.GetTicks())
+        {
+            RemoveFolder(Key);
+            InvalidationCount++;
+            MissCount++;
+            return false;
+        }
+
+        CachedFolder = *FoundFolder;
+        bRevalidate = bRevalidateUnwatched == true && CachedFolder->bIsWatched == false;
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // Cached folders are immutable, so they are expanded outside of the lock.
+    OutContents.Reset(CachedFolder->Entries.Num());
+
+    for (const FCachedEntry& EachEntry : CachedFolder->Entries)
+    {
+        const TCHAR* Name = CachedFolder->NameArena.GetData() + EachEntry.NameOffset;
+
+        FFolderContent& EachContent = OutContents.AddDefaulted_GetRef();
+        EachContent.Path.Reserve(CachedFolder->PathPrefix.Len() + EachEntry.NameLength);
+        EachContent.Path.Append(CachedFolder->PathPrefix);
+        EachContent.Path.AppendChars(Name, EachEntry.NameLength);
+        EachContent.Name = FString(EachEntry.bIsDirectory ? EachEntry.BaseLength : EachEntry.NameLength, Name);
+
+        if (bRevalidate == false)
+        {
+            EachContent.bIsFile = EachEntry.bIsDirectory == 0;
+            EachContent.Size = EachEntry.Size;
+            EachContent.ModificationTime = FDateTime(EachEntry.ModificationTicks);
+            EachContent.CreationTime = FDateTime(EachEntry.CreationTicks);
+            continue;
+        }
+
+        const FFileStatData StatData = PlatformFile.GetStatData(*EachContent.Path);
+
+        // Replaced within folder time resolution, e.g. a file swapped for a folder of the same name.
+        if (StatData.bIsValid == false || StatData.bIsDirectory != (EachEntry.bIsDirectory == 1))
+        {
+            OutContents.Reset();
+
+            FScopeLock Lock(&Guard);
+
+            RemoveFolder(Key);
+            InvalidationCount++;
+            MissCount++;
+            return false;
+        }
+
+        FFileConvertersSearch::SetStat(EachContent, StatData);
+    }
+
+    FScopeLock Lock(&Guard);
+    HitCount++;
+
+    return true;
+}
+
+void FFileConvertersListingCache::Add(const FString& InPath, const FFileStatData& FolderStat, const TArray<FFolderContent>& Contents, int64 InChangeSerial)
+{
+    {
+        FScopeLock Lock(&Guard);
+
+        if (Contents.Num() > MaxEntries)
+        {
+            return;
+        }
+    }
+
+    TSharedPtr<FCachedFolder, ESPMode::ThreadSafe> CachedFolder = MakeShared<FCachedFolder, ESPMode::ThreadSafe>();
+    CachedFolder->FolderModificationTicks = FolderStat.ModificationTime.GetTicks();
+    CachedFolder->Entries.Reserve(Contents.Num());
+
+    int32 ArenaSize = 0;
+    for (const FFolderContent& EachContent : Contents)
+    {
+        ArenaSize += FFileConvertersSearch::GetCleanName(EachContent.Path).Len();
+    }
+
+    CachedFolder->NameArena.Reserve(ArenaSize);
+
+    for (const FFolderContent& EachContent : Contents)
+    {
+        const FStringView PathView(EachContent.Path);
+        const FStringView CleanName = FFileConvertersSearch::GetCleanName(PathView);
+        const FStringView PathPrefix = PathView.LeftChop(CleanName.Len());
+
+        // All children share one prefix. Anything else can't be rebuilt from it, so it isn't cached.
+        if (CachedFolder->Entries.IsEmpty() == true)
+        {
+            CachedFolder->PathPrefix = FString(PathPrefix.Len(), PathPrefix.GetData());
+        }
+
+        else if (PathPrefix.Equals(CachedFolder->PathPrefix, ESearchCase::CaseSensitive) == false)
+        {
+            return;
+        }
+
+        if (CleanName.Len() > MAX_uint16)
+        {
+            return;
+        }
+
+        FCachedEntry& Entry = CachedFolder->Entries.AddDefaulted_GetRef();
+        Entry.NameOffset = static_cast<uint32>(CachedFolder->NameArena.Num());
+        Entry.NameLength = static_cast<uint16>(CleanName.Len());
+        Entry.BaseLength = static_cast<uint16>(FFileConvertersSearch::GetBaseName(CleanName).Len());
+        Entry.bIsDirectory = EachContent.bIsFile ? 0 : 1;
+        Entry.Size = EachContent.Size;
+        Entry.ModificationTicks = EachContent.ModificationTime.GetTicks();
+        Entry.CreationTicks = EachContent.CreationTime.GetTicks();
+
+        CachedFolder->NameArena.Append(CleanName.GetData(), CleanName.Len());
+    }
+
+    const FString Key = FFileConvertersWatcher::NormalizePath(InPath);
+    const int64 FolderBytes = CachedFolder->GetAllocatedBytes();
+
+    FScopeLock Lock(&Guard);
+
+    if (FolderBytes > MaxBytes)
+    {
+        return;
+    }
+
+    // A watcher change during enumeration may not be in the listing. Such folder is cached, but not trusted as watched.
+    CachedFolder->bIsWatched = InChangeSerial == ChangeSerial && IsUnderWatchedRoot(Key);
+
+    RemoveFolder(Key);
+
+    // LRU would drop its oldest folder silently when slots are full. Do it here so totals stay right.
+    if (Folders.Num() >= Folders.Max())
+    {
+        const FCachedFolderPtr OldestFolder = Folders.RemoveLeastRecent();
+        UsedEntries -= OldestFolder->Entries.Num();
+        UsedBytes -= OldestFolder->GetAllocatedBytes();
+        EvictionCount++;
+    }
+
+    UsedEntries += CachedFolder->Entries.Num();
+    UsedBytes += FolderBytes;
+    Folders.Add(Key, MoveTemp(CachedFolder));
+
+    EvictToBudget();
+}
+
+int64 FFileConvertersListingCache::GetChangeSerial()
+{
+    FScopeLock Lock(&Guard);
+    return ChangeSerial;
+}
+
+void FFileConvertersListingCache::RemoveFolder(const FString& Key)
+{
+    if (const FCachedFolderPtr* FoundFolder = Folders.Find(Key))
+    {
+        UsedEntries -= (*FoundFolder)->Entries.Num();
+        UsedBytes -= (*FoundFolder)->GetAllocatedBytes();
+        Folders.Remove(Key);
+    }
+}
+
+void FFileConvertersListingCache::EvictToBudget()
+{
+    while (Folders.Num() > 0 && (UsedEntries > MaxEntries || UsedBytes > MaxBytes))
+    {
+        const FCachedFolderPtr OldestFolder = Folders.RemoveLeastRecent();
+        UsedEntries -= OldestFolder->Entries.Num();
+        UsedBytes -= OldestFolder->GetAllocatedBytes();
+        EvictionCount++;
+    }
+}
+
+bool FFileConvertersListingCache::IsUnderWatchedRoot(const FString& Key) const
+{
+    for (const FString& EachRoot : WatchedRoots)
+    {
+        if (Key.Equals(EachRoot, ESearchCase::IgnoreCase) == true || FPaths::IsUnderDirectory(Key, EachRoot) == true)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void FFileConvertersListingCache::SetBudget(int32 InMaxEntries, int64 InMaxBytes)
+{
+    FScopeLock Lock(&Guard);
+
+    MaxEntries = FMath::Max(InMaxEntries, 0);
+    MaxBytes = FMath::Max<int64>(InMaxBytes, 0);
+
+    EvictToBudget();
+}
+
+void FFileConvertersListingCache::SetRevalidateUnwatched(bool bInRevalidateUnwatched)
+{
+    FScopeLock Lock(&Guard);
+    bRevalidateUnwatched = bInRevalidateUnwatched;
+}
+
+void FFileConvertersListingCache::Clear()
+{
+    FScopeLock Lock(&Guard);
+
+    Folders.Empty(FileConvertersListing::MaxCachedFolders);
+    UsedEntries = 0;
+    UsedBytes = 0;
+}
+
+FListingCacheStats FFileConvertersListingCache::GetStats()
+{
+    FScopeLock Lock(&Guard);
+
+    FListingCacheStats Stats;
+    Stats.FolderCount = Folders.Num();
+    Stats.EntryCount = UsedEntries;
+    Stats.MemoryBytes = UsedBytes;
+    Stats.HitCount = HitCount;
+    Stats.MissCount = MissCount;
+    Stats.InvalidationCount = InvalidationCount;
+    Stats.EvictionCount = EvictionCount;
+    Stats.HitRate = HitCount + MissCount > 0 ? float(double(HitCount) / double(HitCount + MissCount)) : 0.0f;
+
+    return Stats;
+}
+
+void FFileConvertersListingCache::HandleFolderChanges(const FString& WatchedPath, const TArray<FFolderChange>& Changes)
+{
+    // Modified children of watched folders, grouped by cached folder. They are stat'ed outside of the lock, so workers don't wait for the disk.
+    TMap<FString, TPair<FCachedFolderPtr, TArray<FString>>> ModifiedFolders;
+
+    {
+        FScopeLock Lock(&Guard);
+
+        ChangeSerial++;
+        const int32 FolderCountBefore = Folders.Num();
+
+        for (const FFolderChange& EachChange : Changes)
+        {
+            // Watcher lost changes. Every cached folder under watched one may be stale.
+            if (EachChange.ChangeType == EFolderChangeType::RescanRequired)
+            {
+                TArray<FString> Array_Keys;
+                for (TLruCache<FString, FCachedFolderPtr>::TConstIterator It(Folders); It; ++It)
+                {
+                    if (It.Key().Equals(WatchedPath, ESearchCase::IgnoreCase) == true || FPaths::IsUnderDirectory(It.Key(), WatchedPath) == true)
+                    {
+                        Array_Keys.Add(It.Key());
+                    }
+                }
+
+                for (const FString& EachKey : Array_Keys)
+                {
+                    RemoveFolder(EachKey);
+                }
+
+                ModifiedFolders.Empty();
+                break;
+            }
+
+            const FString ParentKey = FPaths::GetPath(EachChange.Path);
+
+            // Added and removed entries change parent listing. A removed or re-added folder also loses its own listing.
+            if (EachChange.ChangeType != EFolderChangeType::Modified)
+            {
+                RemoveFolder(ParentKey);
+                RemoveFolder(EachChange.Path);
+                ModifiedFolders.Remove(ParentKey);
+                continue;
+            }
+
+            const FCachedFolderPtr* FoundFolder = Folders.Find(ParentKey);
+
+            if (FoundFolder == nullptr)
+            {
+                continue;
+            }
+
+            // Folder enumerated before its watch may already miss this change, so it isn't patched.
+            if ((*FoundFolder)->bIsWatched == false)
+            {
+                RemoveFolder(ParentKey);
+                continue;
+            }
+
+            TPair<FCachedFolderPtr, TArray<FString>>& ModifiedFolder = ModifiedFolders.FindOrAdd(ParentKey);
+            ModifiedFolder.Key = *FoundFolder;
+            ModifiedFolder.Value.AddUnique(FPaths::GetCleanFilename(EachChange.Path));
+
+            // A burst of writes is cheaper to enumerate again than to stat one by one.
+            if (ModifiedFolder.Value.Num() > FileConvertersListing::MaxModifiedChildren)
+            {
+                RemoveFolder(ParentKey);
+                ModifiedFolders.Remove(ParentKey);
+            }
+        }
+
+        InvalidationCount += FolderCountBefore - Folders.Num();
+    }
+
+    if (ModifiedFolders.IsEmpty() == true)
+    {
+        return;
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // Folders with a stale child are left out and dropped below.
+    TMap<FString, FCachedFolderPtr> UpdatedFolders;
+
+    for (const TPair<FString, TPair<FCachedFolderPtr, TArray<FString>>>& EachFolder : ModifiedFolders)
+    {
+        const FCachedFolder& CachedFolder = *EachFolder.Value.Key;
+
+        TMap<FString, int32> ChildIndices;
+        for (const FString& EachName : EachFolder.Value.Value)
+        {
+            ChildIndices.Add(EachName, INDEX_NONE);
+        }
+
+        for (int32 EntryIndex = 0; EntryIndex < CachedFolder.Entries.Num(); EntryIndex++)
+        {
+            const FCachedEntry& EachEntry = CachedFolder.Entries[EntryIndex];
+
+            if (int32* ChildIndex = ChildIndices.Find(FString(EachEntry.NameLength, CachedFolder.NameArena.GetData() + EachEntry.NameOffset)))
+            {
+                *ChildIndex = EntryIndex;
+            }
+        }
+
+        TSharedPtr<FCachedFolder, ESPMode::ThreadSafe> UpdatedFolder = MakeShared<FCachedFolder, ESPMode::ThreadSafe>(CachedFolder);
+        bool bIsStale = false;
+
+        for (const TPair<FString, int32>& EachChild : ChildIndices)
+        {
+            // Unknown child means an addition this listing never saw.
+            if (EachChild.Value == INDEX_NONE)
+            {
+                bIsStale = true;
+                break;
+            }
+
+            FCachedEntry& Entry = UpdatedFolder->Entries[EachChild.Value];
+            const FFileStatData StatData = PlatformFile.GetStatData(*(CachedFolder.PathPrefix + EachChild.Key));
+
+            if (StatData.bIsValid == false || StatData.bIsDirectory != (Entry.bIsDirectory == 1))
+            {
+                bIsStale = true;
+                break;
+            }
+
+            Entry.Size = StatData.bIsDirectory ? 0 : StatData.FileSize;
+            Entry.ModificationTicks = StatData.ModificationTime.GetTicks();
+            Entry.CreationTicks = StatData.CreationTime.GetTicks();
+        }
+
+        if (bIsStale == false)
+        {
+            UpdatedFolders.Add(EachFolder.Key, MoveTemp(UpdatedFolder));
+        }
+    }
+
+    FScopeLock Lock(&Guard);
+
+    for (const TPair<FString, TPair<FCachedFolderPtr, TArray<FString>>>& EachFolder : ModifiedFolders)
+    {
+        const FCachedFolderPtr* FoundFolder = Folders.Find(EachFolder.Key);
+
+        // Dropped or listed again by a worker meanwhile. A newer listing started after these changes.
+        if (FoundFolder == nullptr || *FoundFolder != EachFolder.Value.Key)
+        {
+            continue;
+        }
+
+        if (const FCachedFolderPtr* UpdatedFolder = UpdatedFolders.Find(EachFolder.Key))
+        {
+            UsedBytes += (*UpdatedFolder)->GetAllocatedBytes() - (*FoundFolder)->GetAllocatedBytes();
+            Folders.Add(EachFolder.Key, *UpdatedFolder);
+        }
+
+        else
+        {
+            RemoveFolder(EachFolder.Key);
+            InvalidationCount++;
+        }
+    }
+}
+
+void FFileConvertersListingCache::HandleWatchChanged(const FString& WatchedPath, bool bIsWatched)
+{
+    FScopeLock Lock(&Guard);
+
+    ChangeSerial++;
+
+    if (bIsWatched == true)
+    {
+        WatchedRoots.AddUnique(WatchedPath);
+        return;
+    }
+
+    WatchedRoots.Remove(WatchedPath);
+
+    // Nothing keeps these up to date anymore. Folders still under another watched root stay.
+    TArray<FString> Array_Keys;
+    for (TLruCache<FString, FCachedFolderPtr>::TConstIterator It(Folders); It; ++It)
+    {
+        if (It.Value()->bIsWatched == true && IsUnderWatchedRoot(It.Key()) == false)
+        {
+            Array_Keys.Add(It.Key());
+        }
+    }
+
+    for (const FString& EachKey : Array_Keys)
+    {
+        RemoveFolder(EachKey);
+    }
+}
@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "Containers/LruCache.h"
+
+/*
+*	Folder listings for explorer widgets.
+*	A listing is enumerated and sorted once on a worker, then kept here and read page by page. Widgets only hold the visible window.
+*	Listing registry is game thread only.
+*/
+class FFileConvertersListing
+{
+public:
+
+	static FFileConvertersListing& Get();
+
+	/* One stat enumeration of a single folder, served from listing cache when folder didn't change. Any thread. */
+	static void ListFolder(const FString& InPath, TArray<FFolderContent>& OutContents);
+
+	/* Same, but always asks the disk. */
+	static void ListFolderUncached(const FString& InPath, TArray<FFolderContent>& OutContents);
+
+	/* Folders always come first. Ties are broken by natural name, so order is stable between calls. Big listings are sorted in parallel chunks and merged. */
+	static void Sort(TArray<FFolderContent>& Contents, EFolderSortMode SortMode, bool bDescending);
+
+	/* Case insensitive, digit runs are compared by value. "file2" comes before "file10". */
+	static int32 CompareNatural(FStringView A, FStringView B);
+
+	/* Takes ownership of sorted contents. Returns listing handle. */
+	int32 AddListing(TArray<FFolderContent>&& Contents);
+
+	/* Returns false if handle isn't valid. Offset past the end gives an empty page. */
+	bool GetPage(int32 ListingHandle, int32 Offset, int32 Count, TArray<FFolderContent>& OutContents) const;
+
+	void RemoveListing(int32 ListingHandle);
+
+private:
+
+	TMap<int32, TArray<FFolderContent>> Listings;
+	int32 NextHandle = 1;
+};
+
+/*
+*	Listings of recently visited folders.
+*	A cached listing is valid while folder's modification time is unchanged. Folder time catches added, removed and renamed entries.
+*	Size and times of every child are kept with its name, taken from the same enumeration. Names of a folder share one arena. Full paths are rebuilt from the folder prefix when a listing is handed out.
+*	Writing a child doesn't touch folder time. Watched folders get child changes from the watcher, so their hits need no other disk access. Unwatched folders hand out sizes and times of the enumeration, unless children revalidation is enabled.
+*/
+class FFileConvertersListingCache
+{
+public:
+
+	static FFileConvertersListingCache& Get();
+
+	/* Thread safe. Returns false on miss or stale entry. With revalidation, a child of an unwatched folder which is gone or changed type since caching makes the entry stale. */
+	bool Find(const FString& InPath, const FFileStatData& FolderStat, TArray<FFolderContent>& OutContents);
+
+	/* Thread safe. FolderStat and ChangeSerial must be taken before the listing, so a change during enumeration makes the entry stale instead of wrong. */
+	void Add(const FString& InPath, const FFileStatData& FolderStat, const TArray<FFolderContent>& Contents, int64 ChangeSerial);
+
+	/* Thread safe. Grows with every watcher change and watch registration. */
+	int64 GetChangeSerial();
+
+	/* Zero entries or bytes disables the cache. */
+	void SetBudget(int32 InMaxEntries, int64 InMaxBytes);
+
+	/* Children of unwatched folders are stat'ed again on every hit. Costs one stat per child, but never hands out old sizes or times. */
+	void SetRevalidateUnwatched(bool bInRevalidateUnwatched);
+
+	void Clear();
+	FListingCacheStats GetStats();
+
+private:
+
+	struct FCachedEntry
+	{
+		int64 Size = 0;
+		int64 ModificationTicks = 0;
+		int64 CreationTicks = 0;
+		uint32 NameOffset = 0;
+		uint16 NameLength = 0;
+		uint16 BaseLength = 0;
+		uint8 bIsDirectory = 0;
+	};
+
+	struct FCachedFolder
+	{
+		int64 FolderModificationTicks = 0;
+
+		/* Folder was under a watched one since before its enumeration. Watcher changes keep its children up to date. */
+		bool bIsWatched = false;
+
+		/* Everything of a child path before its name, usually folder path and a slash. */
+		FString PathPrefix;
+		TArray<TCHAR> NameArena;
+		TArray<FCachedEntry> Entries;
+
+		int64 GetAllocatedBytes() const;
+	};
+
+	using FCachedFolderPtr = TSharedPtr<const FCachedFolder, ESPMode::ThreadSafe>;
+
+	FFileConvertersListingCache();
+
+	/* Game thread. Updates children of modified entries in place. Drops parent folders of added and removed ones. */
+	void HandleFolderChanges(const FString& WatchedPath, const TArray<FFolderChange>& Changes);
+
+	/* Game thread. Folders under an unwatched root lose their watcher updates, so they are dropped. */
+	void HandleWatchChanged(const FString& WatchedPath, bool bIsWatched);
+
+	/* Needs Guard. */
+	void RemoveFolder(const FString& Key);
+	void EvictToBudget();
+	bool IsUnderWatchedRoot(const FString& Key) const;
+
+	FCriticalSection Guard;
+	TLruCache<FString, FCachedFolderPtr> Folders;
+	TArray<FString> WatchedRoots;
+	int64 ChangeSerial = 0;
+	bool bRevalidateUnwatched = false;
+
+	int32 MaxEntries = 1000000;
+	int64 MaxBytes = 256LL * 1024LL * 1024LL;
+	int32 UsedEntries = 0;
+	int64 UsedBytes = 0;
+
+	int64 HitCount = 0;
+	int64 MissCount = 0;
+	int64 InvalidationCount = 0;
+	int64 EvictionCount = 0;
+};
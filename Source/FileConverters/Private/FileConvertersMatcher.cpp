@@ -0,0 +1,434 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersMatcher.h"
+#include "FileConvertersSearch.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define FILECONVERTERS_MATCHER_SSE2 1
+#else
+#define FILECONVERTERS_MATCHER_SSE2 0
+#endif
+
+namespace FileConvertersMatcher
+{
+    // Fuzzy score parts. Close to fzf: matched characters, word boundaries and runs are rewarded, gaps cost a little.
+    static constexpr int32 ScoreMatch = 16;
+    static constexpr int32 BonusBoundary = 8;
+    static constexpr int32 BonusCamelCase = 7;
+    static constexpr int32 BonusConsecutive = 4;
+    static constexpr int32 PenaltyGapStart = 3;
+    static constexpr int32 PenaltyGapExtension = 1;
+    static constexpr int32 MaxLeadingPenalty = 15;
+
+    static bool IsSeparator(TCHAR Char)
+    {
+        return Char == TEXT(' ') || Char == TEXT('_') || Char == TEXT('-') || Char == TEXT('.') || Char == TEXT('/') || Char == TEXT('\\');
+    }
+
+    static int32 GetBoundaryBonus(FStringView Text, int32 CharIndex)
+    {
+        if (CharIndex == 0 || IsSeparator(Text[CharIndex - 1]) == true)
+        {
+            return BonusBoundary;
+        }
+
+        if (FChar::IsLower(Text[CharIndex - 1]) == true && FChar::IsUpper(Text[CharIndex]) == true)
+        {
+            return BonusCamelCase;
+        }
+
+        return 0;
+    }
+}
+
+FFileConvertersMatcher::FFileConvertersMatcher(const FFileSearchQuery& InQuery)
+    : Mode(InQuery.Mode)
+    , bCaseSensitive(InQuery.bCaseSensitive)
+    , MaxResults(FMath::Max(InQuery.MaxResults, 0))
+    , Pattern(InQuery.bCaseSensitive ? InQuery.Pattern : InQuery.Pattern.ToLower())
+{
+    if (Mode == EFileSearchMode::Exact || Mode == EFileSearchMode::Substring)
+    {
+        RequiredLiteral = Pattern;
+    }
+
+    for (const FString& EachExtension : InQuery.Extensions)
+    {
+        FString Extension = EachExtension;
+        Extension.RemoveFromStart(TEXT("*"));
+        Extension.RemoveFromStart(TEXT("."));
+
+        if (Extension.IsEmpty() == false)
+        {
+            Extensions.Add(bCaseSensitive ? Extension : Extension.ToLower());
+        }
+    }
+
+    if (Pattern.Len() > 0)
+    {
+        FirstLower = bCaseSensitive ? Pattern[0] : FChar::ToLower(Pattern[0]);
+        FirstUpper = bCaseSensitive ? Pattern[0] : FChar::ToUpper(Pattern[0]);
+    }
+
+    if (Pattern.Len() > 1)
+    {
+        SecondLower = bCaseSensitive ? Pattern[1] : FChar::ToLower(Pattern[1]);
+        SecondUpper = bCaseSensitive ? Pattern[1] : FChar::ToUpper(Pattern[1]);
+    }
+}
+
+int32 FFileConvertersMatcher::FindChar(FStringView Text, int32 StartIndex, TCHAR Lower, TCHAR Upper)
+{
+    const TCHAR* Data = Text.GetData();
+    const int32 Length = Text.Len();
+    int32 CharIndex = FMath::Max(StartIndex, 0);
+
+#if FILECONVERTERS_MATCHER_SSE2
+    if constexpr (sizeof(TCHAR) == 2)
+    {
+        const __m128i LowerLanes = _mm_set1_epi16(static_cast<short>(Lower));
+        const __m128i UpperLanes = _mm_set1_epi16(static_cast<short>(Upper));
+
+        for (; CharIndex + 8 <= Length; CharIndex += 8)
+        {
+            const __m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + CharIndex));
+            const int32 Mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(Chars, LowerLanes), _mm_cmpeq_epi16(Chars, UpperLanes)));
+
+            if (Mask != 0)
+            {
+                return CharIndex + int32(FMath::CountTrailingZeros(uint32(Mask)) / 2);
+            }
+        }
+    }
+#endif
+
+    for (; CharIndex < Length; CharIndex++)
+    {
+        if (Data[CharIndex] == Lower || Data[CharIndex] == Upper)
+        {
+            return CharIndex;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+int32 FFileConvertersMatcher::FindPair(FStringView Text, int32 StartIndex, TCHAR InFirstLower, TCHAR InFirstUpper, TCHAR InSecondLower, TCHAR InSecondUpper)
+{
+    const TCHAR* Data = Text.GetData();
+    const int32 Length = Text.Len();
+    int32 CharIndex = FMath::Max(StartIndex, 0);
+
+#if FILECONVERTERS_MATCHER_SSE2
+    if constexpr (sizeof(TCHAR) == 2)
+    {
+        const __m128i FirstLowerLanes = _mm_set1_epi16(static_cast<short>(InFirstLower));
+        const __m128i FirstUpperLanes = _mm_set1_epi16(static_cast<short>(InFirstUpper));
+        const __m128i SecondLowerLanes = _mm_set1_epi16(static_cast<short>(InSecondLower));
+        const __m128i SecondUpperLanes = _mm_set1_epi16(static_cast<short>(InSecondUpper));
+
+        // Second load is shifted by one character, so every lane sees its pair. It needs one character after the block.
+        for (; CharIndex + 9 <= Length; CharIndex += 8)
+        {
+            const __m128i Chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + CharIndex));
+            const __m128i NextChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + CharIndex + 1));
+
+            const __m128i FirstHits = _mm_or_si128(_mm_cmpeq_epi16(Chars, FirstLowerLanes), _mm_cmpeq_epi16(Chars, FirstUpperLanes));
+            const __m128i SecondHits = _mm_or_si128(_mm_cmpeq_epi16(NextChars, SecondLowerLanes), _mm_cmpeq_epi16(NextChars, SecondUpperLanes));
+            const int32 Mask = _mm_movemask_epi8(_mm_and_si128(FirstHits, SecondHits));
+
+            if (Mask != 0)
+            {
+                return CharIndex + int32(FMath::CountTrailingZeros(uint32(Mask)) / 2);
+            }
+        }
+    }
+#endif
+
+    for (; CharIndex + 1 < Length; CharIndex++)
+    {
+        if ((Data[CharIndex] == InFirstLower || Data[CharIndex] == InFirstUpper) && (Data[CharIndex + 1] == InSecondLower || Data[CharIndex + 1] == InSecondUpper))
+        {
+            return CharIndex;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+bool FFileConvertersMatcher::Matches(FStringView CleanName, bool bIsDirectory, int32& OutScore) const
+{
+    OutScore = 0;
+
+    if (Extensions.IsEmpty() == false && (bIsDirectory == true || MatchesExtension(CleanName) == false))
+    {
+        return false;
+    }
+
+    if (Pattern.IsEmpty() == true)
+    {
+        return true;
+    }
+
+    const FStringView BaseName = FFileConvertersSearch::GetBaseName(CleanName);
+
+    switch (Mode)
+    {
+        case EFileSearchMode::Exact:
+        {
+            if (BaseName.Len() != Pattern.Len())
+            {
+                return false;
+            }
+
+            for (int32 CharIndex = 0; CharIndex < BaseName.Len(); CharIndex++)
+            {
+                if (Fold(BaseName[CharIndex]) != Pattern[CharIndex])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        case EFileSearchMode::Glob:
+            return MatchesGlob(CleanName);
+
+        case EFileSearchMode::Fuzzy:
+            return MatchesFuzzy(BaseName, OutScore);
+
+        default:
+            return MatchesSubstring(BaseName);
+    }
+}
+
+bool FFileConvertersMatcher::MatchesExtension(FStringView CleanName) const
+{
+    int32 DotIndex = INDEX_NONE;
+    if (CleanName.FindLastChar(TEXT('.'), DotIndex) == false)
+    {
+        return false;
+    }
+
+    const FStringView Extension = CleanName.RightChop(DotIndex + 1);
+
+    for (const FString& EachExtension : Extensions)
+    {
+        if (Extension.Equals(EachExtension, bCaseSensitive ? ESearchCase::CaseSensitive : ESearchCase::IgnoreCase) == true)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FFileConvertersMatcher::MatchesSubstring(FStringView BaseName) const
+{
+    const int32 PatternLength = Pattern.Len();
+
+    if (PatternLength > BaseName.Len())
+    {
+        return false;
+    }
+
+    if (PatternLength == 1)
+    {
+        return FindChar(BaseName, 0, FirstLower, FirstUpper) != INDEX_NONE;
+    }
+
+    // Prefilter finds positions of the leading pair, rest of the pattern is only compared there.
+    const FStringView Candidates = BaseName.Left(BaseName.Len() - PatternLength + 2);
+
+    for (int32 StartIndex = FindPair(Candidates, 0, FirstLower, FirstUpper, SecondLower, SecondUpper); StartIndex != INDEX_NONE; StartIndex = FindPair(Candidates, StartIndex + 1, FirstLower, FirstUpper, SecondLower, SecondUpper))
+    {
+        int32 PatternIndex = 2;
+        while (PatternIndex < PatternLength && Fold(BaseName[StartIndex + PatternIndex]) == Pattern[PatternIndex])
+        {
+            PatternIndex++;
+        }
+
+        if (PatternIndex == PatternLength)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FFileConvertersMatcher::MatchesGlob(FStringView CleanName) const
+{
+    // Iterative wildcard match. On a mismatch, last star takes one more character.
+    int32 NameIndex = 0;
+    int32 PatternIndex = 0;
+    int32 StarIndex = INDEX_NONE;
+    int32 StarNameIndex = 0;
+
+    while (NameIndex < CleanName.Len())
+    {
+        if (PatternIndex < Pattern.Len() && (Pattern[PatternIndex] == TEXT('?') || Pattern[PatternIndex] == Fold(CleanName[NameIndex])))
+        {
+            NameIndex++;
+            PatternIndex++;
+        }
+
+        else if (PatternIndex < Pattern.Len() && Pattern[PatternIndex] == TEXT('*'))
+        {
+            StarIndex = PatternIndex++;
+            StarNameIndex = NameIndex;
+        }
+
+        else if (StarIndex != INDEX_NONE)
+        {
+            PatternIndex = StarIndex + 1;
+            NameIndex = ++StarNameIndex;
+        }
+
+        else
+        {
+            return false;
+        }
+    }
+
+    while (PatternIndex < Pattern.Len() && Pattern[PatternIndex] == TEXT('*'))
+    {
+        PatternIndex++;
+    }
+
+    return PatternIndex == Pattern.Len();
+}
+
+bool FFileConvertersMatcher::MatchesFuzzy(FStringView BaseName, int32& OutScore) const
+{
+    using namespace FileConvertersMatcher;
+
+    const int32 PatternLength = Pattern.Len();
+
+    // Prefilter: first pattern character has to be there at all.
+    int32 StartIndex = FindChar(BaseName, 0, FirstLower, FirstUpper);
+    if (StartIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Forward pass finds where the first full subsequence ends.
+    int32 EndIndex = INDEX_NONE;
+    for (int32 CharIndex = StartIndex, PatternIndex = 0; CharIndex < BaseName.Len(); CharIndex++)
+    {
+        if (Fold(BaseName[CharIndex]) == Pattern[PatternIndex] && ++PatternIndex == PatternLength)
+        {
+            EndIndex = CharIndex;
+            break;
+        }
+    }
+
+    if (EndIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Backward pass from that end gives the shortest window, so scattered early matches don't hide a tight one.
+    for (int32 CharIndex = EndIndex, PatternIndex = PatternLength - 1; CharIndex >= 0; CharIndex--)
+    {
+        if (Fold(BaseName[CharIndex]) == Pattern[PatternIndex])
+        {
+            if (PatternIndex == 0)
+            {
+                StartIndex = CharIndex;
+                break;
+            }
+
+            PatternIndex--;
+        }
+    }
+
+    int32 Score = -FMath::Min(StartIndex, MaxLeadingPenalty);
+    int32 PatternIndex = 0;
+    int32 RunLength = 0;
+    bool bIsInGap = false;
+
+    for (int32 CharIndex = StartIndex; CharIndex <= EndIndex; CharIndex++)
+    {
+        if (PatternIndex < PatternLength && Fold(BaseName[CharIndex]) == Pattern[PatternIndex])
+        {
+            Score += ScoreMatch + GetBoundaryBonus(BaseName, CharIndex) + RunLength * BonusConsecutive;
+            RunLength++;
+            PatternIndex++;
+            bIsInGap = false;
+        }
+
+        else
+        {
+            Score -= bIsInGap ? PenaltyGapExtension : PenaltyGapStart;
+            RunLength = 0;
+            bIsInGap = true;
+        }
+    }
+
+    OutScore = Score;
+    return true;
+}
+
+bool FFileConvertersMatcher::IsBetter(const FFolderContent& A, const FFolderContent& B) const
+{
+    if (IsRanked() == true && A.Score != B.Score)
+    {
+        return A.Score > B.Score;
+    }
+
+    return A.Path < B.Path;
+}
+
+bool FFileConvertersMatcher::ShouldCollect(const TArray<FFolderContent>& Results, FStringView Path, int32 Score) const
+{
+    if (MaxResults == 0 || Results.Num() < MaxResults)
+    {
+        return true;
+    }
+
+    // Heap top is the worst kept result.
+    const FFolderContent& Worst = Results.HeapTop();
+
+    if (IsRanked() == true && Score != Worst.Score)
+    {
+        return Score > Worst.Score;
+    }
+
+    return Path.Compare(Worst.Path, ESearchCase::IgnoreCase) < 0;
+}
+
+void FFileConvertersMatcher::Collect(TArray<FFolderContent>& Results, FFolderContent&& Content) const
+{
+    if (MaxResults == 0)
+    {
+        Results.Add(MoveTemp(Content));
+        return;
+    }
+
+    auto IsWorse = [this](const FFolderContent& A, const FFolderContent& B) { return IsBetter(B, A); };
+
+    if (Results.Num() >= MaxResults)
+    {
+        if (IsBetter(Content, Results.HeapTop()) == false)
+        {
+            return;
+        }
+
+        Results.HeapPopDiscard(IsWorse, false);
+    }
+
+    Results.HeapPush(MoveTemp(Content), IsWorse);
+}
+
+void FFileConvertersMatcher::Finish(TArray<FFolderContent>& Results) const
+{
+    Results.Sort([this](const FFolderContent& A, const FFolderContent& B) { return IsBetter(A, B); });
+
+    if (MaxResults > 0 && Results.Num() > MaxResults)
+    {
+        Results.SetNum(MaxResults);
+    }
+}
@@ -0,0 +1,425 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersMeshopt.h"
+
+namespace FileConvertersMeshopt
+{
+    static constexpr uint8 VertexHeader = 0xA0;
+    static constexpr uint8 SequenceHeader = 0xD1;
+
+    static constexpr int32 ByteGroupSize = 16;
+    static constexpr int32 VertexBlockSizeBytes = 8192;
+    static constexpr int32 VertexBlockMaxSize = 256;
+    static constexpr int32 TailMinSize = 32;
+
+    static float ScoreVertex(int32 CachePosition, int32 RemainingValence)
+    {
+        if (RemainingValence == 0)
+        {
+            return -1.0f;
+        }
+
+        float Score = 0.0f;
+
+        // Last triangle's vertices get a fixed score, so next triangle doesn't just reuse them.
+        if (CachePosition >= 0)
+        {
+            Score = CachePosition < 3 ? 0.75f : FMath::Pow(1.0f - float(CachePosition - 3) / float(FFileConvertersMeshopt::CacheSize - 3), 1.5f);
+        }
+
+        // Vertices with few remaining triangles are finished first.
+        return Score + 2.0f * FMath::InvSqrt(float(RemainingValence));
+    }
+
+    static FORCEINLINE uint8 ZigZag8(uint8 Value)
+    {
+        return uint8((int8(Value) >> 7) ^ (Value << 1));
+    }
+
+    static int32 MeasureGroup(const uint8* Buffer, int32 Bits)
+    {
+        if (Bits == 1)
+        {
+            for (int32 Index = 0; Index < ByteGroupSize; Index++)
+            {
+                if (Buffer[Index] != 0)
+                {
+                    return MAX_int32;
+                }
+            }
+
+            return 0;
+        }
+
+        if (Bits == 8)
+        {
+            return ByteGroupSize;
+        }
+
+        // Values that don't fit are written as sentinel plus a full byte after the group.
+        const uint8 Sentinel = uint8((1 << Bits) - 1);
+        int32 Result = ByteGroupSize * Bits / 8;
+
+        for (int32 Index = 0; Index < ByteGroupSize; Index++)
+        {
+            Result += Buffer[Index] >= Sentinel ? 1 : 0;
+        }
+
+        return Result;
+    }
+
+    static void EncodeGroup(TArray<uint8>& Out, const uint8* Buffer, int32 Bits)
+    {
+        if (Bits == 1)
+        {
+            return;
+        }
+
+        if (Bits == 8)
+        {
+            Out.Append(Buffer, ByteGroupSize);
+            return;
+        }
+
+        const int32 ValuesPerByte = 8 / Bits;
+        const uint8 Sentinel = uint8((1 << Bits) - 1);
+
+        for (int32 Index = 0; Index < ByteGroupSize; Index += ValuesPerByte)
+        {
+            uint8 Packed = 0;
+
+            for (int32 Offset = 0; Offset < ValuesPerByte; Offset++)
+            {
+                Packed = uint8(Packed << Bits);
+                Packed |= FMath::Min(Buffer[Index + Offset], Sentinel);
+            }
+
+            Out.Add(Packed);
+        }
+
+        for (int32 Index = 0; Index < ByteGroupSize; Index++)
+        {
+            if (Buffer[Index] >= Sentinel)
+            {
+                Out.Add(Buffer[Index]);
+            }
+        }
+    }
+
+    /* Size is a multiple of ByteGroupSize. Each group of 16 bytes takes the smallest of 0, 2, 4 or 8 bits per value. */
+    static void EncodeBytes(TArray<uint8>& Out, const uint8* Buffer, int32 BufferSize)
+    {
+        const int32 GroupCount = BufferSize / ByteGroupSize;
+        const int32 HeaderOffset = Out.Num();
+
+        // Two bits per group, four groups per header byte.
+        Out.AddZeroed((GroupCount + 3) / 4);
+
+        for (int32 GroupIndex = 0; GroupIndex < GroupCount; GroupIndex++)
+        {
+            const uint8* Group = Buffer + GroupIndex * ByteGroupSize;
+
+            int32 BestBits = 8;
+            int32 BestSize = MeasureGroup(Group, 8);
+
+            for (int32 Bits = 1; Bits < 8; Bits *= 2)
+            {
+                const int32 Size = MeasureGroup(Group, Bits);
+
+                if (Size < BestSize)
+                {
+                    BestBits = Bits;
+                    BestSize = Size;
+                }
+            }
+
+            const uint8 BitsLog2 = BestBits == 1 ? 0 : BestBits == 2 ? 1 : BestBits == 4 ? 2 : 3;
+            Out[HeaderOffset + GroupIndex / 4] |= uint8(BitsLog2 << ((GroupIndex % 4) * 2));
+
+            EncodeGroup(Out, Group, BestBits);
+        }
+    }
+
+    static void EncodeVByte(TArray<uint8>& Out, uint32 Value)
+    {
+        do
+        {
+            Out.Add(uint8((Value & 127) | (Value > 127 ? 128 : 0)));
+            Value >>= 7;
+        } while (Value != 0);
+    }
+}
+
+void FFileConvertersMeshopt::OptimizeVertexCache(TArrayView<uint32> Indices, int32 VertexCount)
+{
+    using namespace FileConvertersMeshopt;
+
+    const int32 TriangleCount = Indices.Num() / 3;
+
+    if (TriangleCount < 2 || VertexCount <= 0)
+    {
+        return;
+    }
+
+    // Triangles of each vertex. Active triangles are kept at the front of each vertex range.
+    TArray<int32> Array_Offsets;
+    Array_Offsets.SetNumZeroed(VertexCount + 1);
+
+    for (int32 Index = 0; Index < TriangleCount * 3; Index++)
+    {
+        Array_Offsets[Indices[Index] + 1]++;
+    }
+
+    for (int32 VertexIndex = 0; VertexIndex < VertexCount; VertexIndex++)
+    {
+        Array_Offsets[VertexIndex + 1] += Array_Offsets[VertexIndex];
+    }
+
+    TArray<int32> Array_Adjacency;
+    TArray<int32> Array_Remaining;
+    Array_Adjacency.SetNumUninitialized(TriangleCount * 3);
+    Array_Remaining.SetNumZeroed(VertexCount);
+
+    for (int32 TriangleIndex = 0; TriangleIndex < TriangleCount; TriangleIndex++)
+    {
+        for (int32 Corner = 0; Corner < 3; Corner++)
+        {
+            const uint32 Vertex = Indices[TriangleIndex * 3 + Corner];
+            Array_Adjacency[Array_Offsets[Vertex] + Array_Remaining[Vertex]++] = TriangleIndex;
+        }
+    }
+
+    TArray<int32> Array_CachePositions;
+    TArray<float> Array_VertexScores;
+    Array_CachePositions.Init(INDEX_NONE, VertexCount);
+    Array_VertexScores.SetNumUninitialized(VertexCount);
+
+    for (int32 VertexIndex = 0; VertexIndex < VertexCount; VertexIndex++)
+    {
+        Array_VertexScores[VertexIndex] = ScoreVertex(INDEX_NONE, Array_Remaining[VertexIndex]);
+    }
+
+    TBitArray<> Array_IsEmitted(false, TriangleCount);
+    TArray<uint32> Array_Output;
+    Array_Output.Reserve(TriangleCount * 3);
+
+    uint32 Cache[CacheSize + 3];
+    uint32 NextCache[CacheSize + 3];
+    int32 CacheCount = 0;
+
+    int32 BestTriangle = INDEX_NONE;
+    int32 Cursor = 0;
+
+    for (int32 EmittedCount = 0; EmittedCount < TriangleCount; EmittedCount++)
+    {
+        // Nothing useful in cache, continue with the next unused triangle in input order.
+        if (BestTriangle == INDEX_NONE)
+        {
+            while (Array_IsEmitted[Cursor] == true)
+            {
+                Cursor++;
+            }
+
+            BestTriangle = Cursor;
+        }
+
+        const uint32 TriangleVertices[3] = { Indices[BestTriangle * 3], Indices[BestTriangle * 3 + 1], Indices[BestTriangle * 3 + 2] };
+
+        Array_Output.Append(TriangleVertices, 3);
+        Array_IsEmitted[BestTriangle] = true;
+
+        for (const uint32 EachVertex : TriangleVertices)
+        {
+            const int32 Start = Array_Offsets[EachVertex];
+            const int32 Last = Start + Array_Remaining[EachVertex] - 1;
+
+            for (int32 AdjacencyIndex = Start; AdjacencyIndex <= Last; AdjacencyIndex++)
+            {
+                if (Array_Adjacency[AdjacencyIndex] == BestTriangle)
+                {
+                    Array_Adjacency[AdjacencyIndex] = Array_Adjacency[Last];
+                    Array_Remaining[EachVertex]--;
+                    break;
+                }
+            }
+        }
+
+        // New cache: triangle vertices first, then previous entries which aren't in the triangle.
+        int32 NextCount = 0;
+
+        for (const uint32 EachVertex : TriangleVertices)
+        {
+            NextCache[NextCount++] = EachVertex;
+        }
+
+        for (int32 CacheIndex = 0; CacheIndex < CacheCount; CacheIndex++)
+        {
+            const uint32 CachedVertex = Cache[CacheIndex];
+
+            if (CachedVertex != TriangleVertices[0] && CachedVertex != TriangleVertices[1] && CachedVertex != TriangleVertices[2])
+            {
+                NextCache[NextCount++] = CachedVertex;
+            }
+        }
+
+        CacheCount = FMath::Min(NextCount, CacheSize);
+
+        for (int32 CacheIndex = 0; CacheIndex < NextCount; CacheIndex++)
+        {
+            const uint32 CachedVertex = NextCache[CacheIndex];
+            const int32 CachePosition = CacheIndex < CacheSize ? CacheIndex : INDEX_NONE;
+
+            Array_CachePositions[CachedVertex] = CachePosition;
+            Array_VertexScores[CachedVertex] = ScoreVertex(CachePosition, Array_Remaining[CachedVertex]);
+
+            if (CacheIndex < CacheSize)
+            {
+                Cache[CacheIndex] = CachedVertex;
+            }
+        }
+
+        // Only triangles of cached vertices changed score. Best of them is next.
+        BestTriangle = INDEX_NONE;
+        float BestScore = 0.0f;
+
+        for (int32 CacheIndex = 0; CacheIndex < CacheCount; CacheIndex++)
+        {
+            const uint32 CachedVertex = Cache[CacheIndex];
+            const int32 Start = Array_Offsets[CachedVertex];
+
+            for (int32 AdjacencyIndex = Start; AdjacencyIndex < Start + Array_Remaining[CachedVertex]; AdjacencyIndex++)
+            {
+                const int32 TriangleIndex = Array_Adjacency[AdjacencyIndex];
+                const float TriangleScore = Array_VertexScores[Indices[TriangleIndex * 3]] + Array_VertexScores[Indices[TriangleIndex * 3 + 1]] + Array_VertexScores[Indices[TriangleIndex * 3 + 2]];
+
+                if (TriangleScore > BestScore)
+                {
+                    BestScore = TriangleScore;
+                    BestTriangle = TriangleIndex;
+                }
+            }
+        }
+    }
+
+    FMemory::Memcpy(Indices.GetData(), Array_Output.GetData(), Array_Output.Num() * sizeof(uint32));
+}
+
+void FFileConvertersMeshopt::OptimizeVertexFetch(TArrayView<uint32> Indices, int32 VertexCount, TArray<uint32>& OutRemap)
+{
+    OutRemap.Init(MAX_uint32, VertexCount);
+    uint32 NextVertex = 0;
+
+    for (uint32& EachIndex : Indices)
+    {
+        if (OutRemap[EachIndex] == MAX_uint32)
+        {
+            OutRemap[EachIndex] = NextVertex++;
+        }
+
+        EachIndex = OutRemap[EachIndex];
+    }
+
+    for (uint32& EachRemap : OutRemap)
+    {
+        if (EachRemap == MAX_uint32)
+        {
+            EachRemap = NextVertex++;
+        }
+    }
+}
+
+void FFileConvertersMeshopt::RemapVertices(uint8* Data, int32 VertexCount, int32 Stride, const TArray<uint32>& Remap, TArray<uint8>& Scratch)
+{
+    Scratch.SetNumUninitialized(VertexCount * Stride);
+    FMemory::Memcpy(Scratch.GetData(), Data, VertexCount * Stride);
+
+    for (int32 VertexIndex = 0; VertexIndex < VertexCount; VertexIndex++)
+    {
+        FMemory::Memcpy(Data + int64(Remap[VertexIndex]) * Stride, Scratch.GetData() + int64(VertexIndex) * Stride, Stride);
+    }
+}
+
+void FFileConvertersMeshopt::EncodeVertexBuffer(const uint8* Data, int32 VertexCount, int32 Stride, TArray<uint8>& OutEncoded)
+{
+    using namespace FileConvertersMeshopt;
+
+    check(Stride > 0 && Stride <= 256 && Stride % 4 == 0);
+
+    OutEncoded.Reset();
+    OutEncoded.Add(VertexHeader);
+
+    uint8 FirstVertex[256] = {};
+    uint8 LastVertex[256] = {};
+
+    if (VertexCount > 0)
+    {
+        FMemory::Memcpy(FirstVertex, Data, Stride);
+        FMemory::Memcpy(LastVertex, Data, Stride);
+    }
+
+    const int32 BlockSize = FMath::Min((VertexBlockSizeBytes / Stride) & ~(ByteGroupSize - 1), VertexBlockMaxSize);
+    uint8 Buffer[VertexBlockMaxSize];
+
+    for (int32 BlockStart = 0; BlockStart < VertexCount; BlockStart += BlockSize)
+    {
+        const int32 BlockCount = FMath::Min(BlockSize, VertexCount - BlockStart);
+        const uint8* BlockData = Data + int64(BlockStart) * Stride;
+
+        // Each byte of the vertex is its own stream of zigzag deltas to previous vertex.
+        for (int32 ByteIndex = 0; ByteIndex < Stride; ByteIndex++)
+        {
+            FMemory::Memzero(Buffer, sizeof(Buffer));
+
+            uint8 Previous = LastVertex[ByteIndex];
+
+            for (int32 VertexIndex = 0; VertexIndex < BlockCount; VertexIndex++)
+            {
+                const uint8 Current = BlockData[VertexIndex * Stride + ByteIndex];
+                Buffer[VertexIndex] = ZigZag8(uint8(Current - Previous));
+                Previous = Current;
+            }
+
+            EncodeBytes(OutEncoded, Buffer, Align(BlockCount, ByteGroupSize));
+        }
+
+        FMemory::Memcpy(LastVertex, BlockData + (BlockCount - 1) * Stride, Stride);
+    }
+
+    // First vertex goes to the padded tail, decoders read it as the first baseline.
+    if (Stride < TailMinSize)
+    {
+        OutEncoded.AddZeroed(TailMinSize - Stride);
+    }
+
+    OutEncoded.Append(FirstVertex, Stride);
+}
+
+void FFileConvertersMeshopt::EncodeIndexSequence(const uint32* Indices, int32 IndexCount, TArray<uint8>& OutEncoded)
+{
+    using namespace FileConvertersMeshopt;
+
+    OutEncoded.Reset();
+    OutEncoded.Add(SequenceHeader);
+
+    // Two baselines, deltas are taken from the one used last unless delta grows large.
+    uint32 Last[2] = { 0, 0 };
+    uint32 Current = 0;
+
+    for (int32 Index = 0; Index < IndexCount; Index++)
+    {
+        const uint32 Value = Indices[Index];
+        const int32 CurrentDelta = int32(Value - Last[Current]);
+
+        Current ^= (CurrentDelta < 0 ? -CurrentDelta : CurrentDelta) >= 30 ? 1 : 0;
+
+        const uint32 Delta = Value - Last[Current];
+        const uint32 ZigZag = (Delta << 1) ^ uint32(int32(Delta) >> 31);
+
+        // Low bit tells decoder which baseline was used.
+        EncodeVByte(OutEncoded, (ZigZag << 1) | Current);
+
+        Last[Current] = Value;
+    }
+
+    OutEncoded.AddZeroed(4);
+}
@@ -0,0 +1,33 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+*	Mesh data optimizations for GLB export.
+*	Index and vertex reordering follow the usual cache and fetch optimizations, encoders write EXT_meshopt_compression streams (codec version 0 for attributes, 1 for index sequences).
+*	Everything works on one primitive or one buffer view and is safe to run on workers in parallel.
+*/
+class FFileConvertersMeshopt
+{
+public:
+
+	/* Size of simulated post transform cache. */
+	static constexpr int32 CacheSize = 32;
+
+	/* Reorders triangles for vertex cache reuse (Forsyth). Indices have to be a triangle list. */
+	static void OptimizeVertexCache(TArrayView<uint32> Indices, int32 VertexCount);
+
+	/* Numbers vertices by first use in index order, unused vertices go last. Rewrites indices and returns old to new vertex map. */
+	static void OptimizeVertexFetch(TArrayView<uint32> Indices, int32 VertexCount, TArray<uint32>& OutRemap);
+
+	/* Moves vertices of one attribute stream to their new places. Scratch is reused between calls. */
+	static void RemapVertices(uint8* Data, int32 VertexCount, int32 Stride, const TArray<uint32>& Remap, TArray<uint8>& Scratch);
+
+	/* ATTRIBUTES mode. Stride has to be a multiple of 4 and at most 256. */
+	static void EncodeVertexBuffer(const uint8* Data, int32 VertexCount, int32 Stride, TArray<uint8>& OutEncoded);
+
+	/* INDICES mode. */
+	static void EncodeIndexSequence(const uint32* Indices, int32 IndexCount, TArray<uint8>& OutEncoded);
+};
@@ -0,0 +1,538 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersPDF.h"
+#include "FileConverters.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Hash/xxhash.h"
+#include "Misc/Paths.h"
+
+namespace FileConvertersPDF
+{
+    static const ANSICHAR Base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    // Every 12 bit value mapped to its two Base64 characters. One 24 bit group needs only two lookups.
+    template<typename CharType>
+    struct TBase64PairTable
+    {
+        CharType Pairs[4096][2];
+
+        TBase64PairTable()
+        {
+            for (int32 PairIndex = 0; PairIndex < 4096; PairIndex++)
+            {
+                Pairs[PairIndex][0] = Base64Alphabet[PairIndex >> 6];
+                Pairs[PairIndex][1] = Base64Alphabet[PairIndex & 63];
+            }
+        }
+    };
+
+    template<typename CharType>
+    static const TBase64PairTable<CharType>& GetPairTable()
+    {
+        static const TBase64PairTable<CharType> PairTable;
+        return PairTable;
+    }
+
+    template<typename CharType>
+    FORCEINLINE void EncodeGroup(const TBase64PairTable<CharType>& PairTable, const uint8* Bytes, CharType* Dest)
+    {
+        const uint32 Group = (uint32(Bytes[0]) << 16) | (uint32(Bytes[1]) << 8) | uint32(Bytes[2]);
+        FMemory::Memcpy(Dest, PairTable.Pairs[Group >> 12], 2 * sizeof(CharType));
+        FMemory::Memcpy(Dest + 2, PairTable.Pairs[Group & 0xFFF], 2 * sizeof(CharType));
+    }
+
+    template<typename CharType>
+    static void EncodeBase64(const uint8* Source, int64 SourceSize, CharType* Dest)
+    {
+        const TBase64PairTable<CharType>& PairTable = GetPairTable<CharType>();
+        int64 SourceIndex = 0;
+
+        // 12 bytes to 16 characters per iteration. Groups are independent, so they don't wait each other.
+        for (; SourceIndex + 12 <= SourceSize; SourceIndex += 12)
+        {
+            EncodeGroup(PairTable, Source + SourceIndex, Dest);
+            EncodeGroup(PairTable, Source + SourceIndex + 3, Dest + 4);
+            EncodeGroup(PairTable, Source + SourceIndex + 6, Dest + 8);
+            EncodeGroup(PairTable, Source + SourceIndex + 9, Dest + 12);
+            Dest += 16;
+        }
+
+        for (; SourceIndex + 3 <= SourceSize; SourceIndex += 3)
+        {
+            EncodeGroup(PairTable, Source + SourceIndex, Dest);
+            Dest += 4;
+        }
+
+        const int64 Remaining = SourceSize - SourceIndex;
+
+        if (Remaining == 1)
+        {
+            const uint32 Group = uint32(Source[SourceIndex]) << 16;
+            Dest[0] = Base64Alphabet[Group >> 18];
+            Dest[1] = Base64Alphabet[(Group >> 12) & 63];
+            Dest[2] = '=';
+            Dest[3] = '=';
+        }
+
+        else if (Remaining == 2)
+        {
+            const uint32 Group = (uint32(Source[SourceIndex]) << 16) | (uint32(Source[SourceIndex + 1]) << 8);
+            Dest[0] = Base64Alphabet[Group >> 18];
+            Dest[1] = Base64Alphabet[(Group >> 12) & 63];
+            Dest[2] = Base64Alphabet[(Group >> 6) & 63];
+            Dest[3] = '=';
+        }
+    }
+}
+
+int64 FFileConvertersPDF::GetEncodedLength(int64 ByteCount)
+{
+    return ((ByteCount + 2) / 3) * 4;
+}
+
+void FFileConvertersPDF::EncodeBase64(const uint8* Source, int64 SourceSize, TCHAR* Dest)
+{
+    FILECONVERTERS_PHASE_SCOPE(Base64Encode);
+    PhaseScope_Base64Encode.AddBytes(SourceSize);
+
+    FileConvertersPDF::EncodeBase64<TCHAR>(Source, SourceSize, Dest);
+}
+
+void FFileConvertersPDF::EncodeBase64(const uint8* Source, int64 SourceSize, ANSICHAR* Dest)
+{
+    FILECONVERTERS_PHASE_SCOPE(Base64Encode);
+    PhaseScope_Base64Encode.AddBytes(SourceSize);
+
+    FileConvertersPDF::EncodeBase64<ANSICHAR>(Source, SourceSize, Dest);
+}
+
+bool FFileConvertersPDF::Splice(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, int64 EncodedLength, TFunctionRef<bool(TCHAR* Dest)> WritePayload)
+{
+    FILECONVERTERS_PHASE_SCOPE(TemplateSplice);
+
+    TArray<int32, TInlineAllocator<4>> Array_Positions;
+
+    if (DummyText.IsEmpty() == false)
+    {
+        int32 SearchFrom = 0;
+        while (true)
+        {
+            const int32 FoundIndex = In_HTML_Content.Find(*DummyText, ESearchCase::CaseSensitive, ESearchDir::FromStart, SearchFrom);
+
+            if (FoundIndex == INDEX_NONE)
+            {
+                break;
+            }
+
+            Array_Positions.Add(FoundIndex);
+            SearchFrom = FoundIndex + DummyText.Len();
+        }
+    }
+
+    // Nothing to replace, so there is no need to encode anything.
+    if (Array_Positions.IsEmpty() == true)
+    {
+        OutHTML = In_HTML_Content;
+        return true;
+    }
+
+    const int64 TotalLength = In_HTML_Content.Len() + Array_Positions.Num() * (EncodedLength - DummyText.Len());
+
+    if (TotalLength >= MAX_int32)
+    {
+        UE_LOG(LogFileConverters, Warning, TEXT("PDF viewer output is too big for a string. Encoded length: %lld"), EncodedLength);
+        OutHTML.Empty();
+        return false;
+    }
+
+    TArray<TCHAR>& CharArray = OutHTML.GetCharArray();
+    CharArray.Empty(static_cast<int32>(TotalLength) + 1);
+    CharArray.SetNumUninitialized(static_cast<int32>(TotalLength) + 1);
+
+    const TCHAR* Source = *In_HTML_Content;
+    TCHAR* Dest = CharArray.GetData();
+    TCHAR* FirstPayload = nullptr;
+    int32 SourceCursor = 0;
+
+    for (const int32 EachPosition : Array_Positions)
+    {
+        const int32 CopyLength = EachPosition - SourceCursor;
+        FMemory::Memcpy(Dest, Source + SourceCursor, CopyLength * sizeof(TCHAR));
+        Dest += CopyLength;
+
+        // First occurrence is encoded once, others are copies of it.
+        if (FirstPayload == nullptr)
+        {
+            FirstPayload = Dest;
+
+            if (WritePayload(Dest) == false)
+            {
+                OutHTML.Empty();
+                return false;
+            }
+        }
+
+        else
+        {
+            FMemory::Memcpy(Dest, FirstPayload, EncodedLength * sizeof(TCHAR));
+        }
+
+        Dest += EncodedLength;
+        SourceCursor = EachPosition + DummyText.Len();
+    }
+
+    const int32 TailLength = In_HTML_Content.Len() - SourceCursor;
+    FMemory::Memcpy(Dest, Source + SourceCursor, TailLength * sizeof(TCHAR));
+    Dest[TailLength] = TEXT('\0');
+
+    return true;
+}
+
+bool FFileConvertersPDF::EmbedBytes(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, const TArray<uint8>& In_PDF_Bytes)
+{
+    return Splice(OutHTML, In_HTML_Content, DummyText, GetEncodedLength(In_PDF_Bytes.Num()), [&In_PDF_Bytes](TCHAR* Dest)
+        {
+            EncodeBase64(In_PDF_Bytes.GetData(), In_PDF_Bytes.Num(), Dest);
+            return true;
+        }
+    );
+}
+
+bool FFileConvertersPDF::EmbedFile(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, const FString& In_PDF_Path)
+{
+    TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*In_PDF_Path));
+
+    // Same as embedding an empty file. Dummy text is removed.
+    if (FileHandle.IsValid() == false)
+    {
+        return Splice(OutHTML, In_HTML_Content, DummyText, 0, [](TCHAR* Dest) { return true; });
+    }
+
+    const int64 FileSize = FileHandle->Size();
+
+    return Splice(OutHTML, In_HTML_Content, DummyText, GetEncodedLength(FileSize), [&FileHandle, FileSize](TCHAR* Dest)
+        {
+            TArray<uint8> Chunk;
+            Chunk.SetNumUninitialized(static_cast<int32>(FMath::Min(ChunkSize, FileSize)));
+
+            int64 Remaining = FileSize;
+            while (Remaining > 0)
+            {
+                const int64 ReadSize = FMath::Min(ChunkSize, Remaining);
+
+                if (FileHandle->Read(Chunk.GetData(), ReadSize) == false)
+                {
+                    UE_LOG(LogFileConverters, Warning, TEXT("PDF couldn't be read completely."));
+                    return false;
+                }
+
+                EncodeBase64(Chunk.GetData(), ReadSize, Dest);
+                Dest += GetEncodedLength(ReadSize);
+                Remaining -= ReadSize;
+            }
+
+            return true;
+        }
+    );
+}
+
+FFileConvertersPDFCache& FFileConvertersPDFCache::Get()
+{
+    static FFileConvertersPDFCache Cache;
+    return Cache;
+}
+
+FString FFileConvertersPDFCache::GetCacheDir() const
+{
+    return FPaths::ProjectSavedDir() / TEXT("FileConverters/PDFCache");
+}
+
+FString FFileConvertersPDFCache::GetEntryPath(const FString& FullPath, const FFileStatData& StatData) const
+{
+    const FString KeySource = FString::Printf(TEXT("%s|%lld|%lld"), *FullPath, StatData.FileSize, StatData.ModificationTime.GetTicks());
+    const uint64 Key = FXxHash64::HashBuffer(*KeySource, KeySource.Len() * sizeof(TCHAR)).Hash;
+
+    return GetCacheDir() / FString::Printf(TEXT("%016llx.b64"), Key);
+}
+
+bool FFileConvertersPDFCache::Embed(FString& OutHTML, FString& ErrorCode, const FString& In_HTML_Content, const FString& DummyText, const FString& In_PDF_Path)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    FString FullPath = FPaths::ConvertRelativePathToFull(In_PDF_Path);
+    FPaths::NormalizeFilename(FullPath);
+
+    const FFileStatData StatData = PlatformFile.GetStatData(*FullPath);
+
+    if (StatData.bIsValid == false || StatData.bIsDirectory == true)
+    {
+        ErrorCode = "PDF doesn't exist.";
+        return false;
+    }
+
+    const FString EntryPath = GetEntryPath(FullPath, StatData);
+    const int64 EncodedLength = FFileConvertersPDF::GetEncodedLength(StatData.FileSize);
+
+    if (PlatformFile.FileExists(*EntryPath) == true)
+    {
+        // Refresh timestamp, so eviction sees this entry as recently used.
+        PlatformFile.SetTimeStamp(*EntryPath, FDateTime::UtcNow());
+
+        if (SpliceEntry(OutHTML, In_HTML_Content, DummyText, EntryPath) == true)
+        {
+            ErrorCode = "Success";
+            return true;
+        }
+    }
+
+    bool bIsCacheable = false;
+    {
+        // Sums existing entries before the new one is in the directory, so it is counted only once below.
+        FScopeLock Lock(&Guard);
+        ScanUsedBytes();
+        bIsCacheable = EncodedLength <= BudgetBytes;
+    }
+
+    bool bIsCreated = false;
+
+    if (bIsCacheable == true && WriteEntry(FullPath, StatData.FileSize, EntryPath, bIsCreated) == true)
+    {
+        // Entry written by a concurrent request is already counted by it.
+        if (bIsCreated == true)
+        {
+            FScopeLock Lock(&Guard);
+            UsedBytes += EncodedLength;
+            EvictToBudget();
+        }
+
+        if (SpliceEntry(OutHTML, In_HTML_Content, DummyText, EntryPath) == true)
+        {
+            ErrorCode = "Success";
+            return true;
+        }
+    }
+
+    // Cache is not usable (budget, disk or a concurrent eviction). Encode directly.
+    if (FFileConvertersPDF::EmbedFile(OutHTML, In_HTML_Content, DummyText, FullPath) == false)
+    {
+        ErrorCode = "PDF couldn't be encoded.";
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+bool FFileConvertersPDFCache::WriteEntry(const FString& In_PDF_Path, int64 FileSize, const FString& EntryPath, bool& bOutIsCreated)
+{
+    bOutIsCreated = false;
+
+    FILECONVERTERS_PHASE_SCOPE(FileWrite);
+    PhaseScope_FileWrite.AddBytes(FFileConvertersPDF::GetEncodedLength(FileSize));
+    PhaseScope_FileWrite.AddItems(1);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*GetCacheDir());
+
+    const FString TempPath = EntryPath + TEXT(".") + FGuid::NewGuid().ToString() + TEXT(".tmp");
+
+    TUniquePtr<IFileHandle> ReadHandle(PlatformFile.OpenRead(*In_PDF_Path));
+    TUniquePtr<IFileHandle> WriteHandle(PlatformFile.OpenWrite(*TempPath));
+
+    if (ReadHandle.IsValid() == false || WriteHandle.IsValid() == false)
+    {
+        return false;
+    }
+
+    const int64 ChunkSize = FFileConvertersPDF::ChunkSize;
+
+    TArray<uint8> Chunk;
+    Chunk.SetNumUninitialized(static_cast<int32>(FMath::Min(ChunkSize, FileSize)));
+
+    TArray<ANSICHAR> EncodedChunk;
+    EncodedChunk.SetNumUninitialized(static_cast<int32>(FFileConvertersPDF::GetEncodedLength(Chunk.Num())));
+
+    bool bIsWritten = true;
+    int64 Remaining = FileSize;
+    while (Remaining > 0)
+    {
+        const int64 ReadSize = FMath::Min(ChunkSize, Remaining);
+        const int64 EncodedSize = FFileConvertersPDF::GetEncodedLength(ReadSize);
+
+        if (ReadHandle->Read(Chunk.GetData(), ReadSize) == false)
+        {
+            bIsWritten = false;
+            break;
+        }
+
+        FFileConvertersPDF::EncodeBase64(Chunk.GetData(), ReadSize, EncodedChunk.GetData());
+
+        if (WriteHandle->Write(reinterpret_cast<const uint8*>(EncodedChunk.GetData()), EncodedSize) == false)
+        {
+            bIsWritten = false;
+            break;
+        }
+
+        Remaining -= ReadSize;
+    }
+
+    WriteHandle.Reset();
+
+    // Another request may have written the same entry in the meantime, that is fine. Rename replaces files on some platforms, so existence is checked under lock.
+    FScopeLock Lock(&Guard);
+
+    if (bIsWritten == false || PlatformFile.FileExists(*EntryPath) == true || PlatformFile.MoveFile(*EntryPath, *TempPath) == false)
+    {
+        PlatformFile.DeleteFile(*TempPath);
+        return PlatformFile.FileExists(*EntryPath);
+    }
+
+    bOutIsCreated = true;
+    return true;
+}
+
+bool FFileConvertersPDFCache::SpliceEntry(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, const FString& EntryPath)
+{
+    TUniquePtr<IFileHandle> EntryHandle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*EntryPath));
+
+    if (EntryHandle.IsValid() == false)
+    {
+        return false;
+    }
+
+    const int64 EncodedLength = EntryHandle->Size();
+
+    return FFileConvertersPDF::Splice(OutHTML, In_HTML_Content, DummyText, EncodedLength, [&EntryHandle, EncodedLength](TCHAR* Dest)
+        {
+            const int64 ChunkSize = FFileConvertersPDF::ChunkSize;
+
+            TArray<uint8> Chunk;
+            Chunk.SetNumUninitialized(static_cast<int32>(FMath::Min(ChunkSize, EncodedLength)));
+
+            int64 Remaining = EncodedLength;
+            while (Remaining > 0)
+            {
+                const int64 ReadSize = FMath::Min(ChunkSize, Remaining);
+
+                if (EntryHandle->Read(Chunk.GetData(), ReadSize) == false)
+                {
+                    return false;
+                }
+
+                const uint8* Source = Chunk.GetData();
+                for (int64 CharIndex = 0; CharIndex < ReadSize; CharIndex++)
+                {
+                    Dest[CharIndex] = static_cast<TCHAR>(Source[CharIndex]);
+                }
+
+                Dest += ReadSize;
+                Remaining -= ReadSize;
+            }
+
+            return true;
+        }
+    );
+}
+
+void FFileConvertersPDFCache::ScanUsedBytes()
+{
+    if (UsedBytes != INDEX_NONE)
+    {
+        return;
+    }
+
+    UsedBytes = 0;
+    FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStat(*GetCacheDir(), [this](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory == false && FPaths::GetExtension(CharPath) == TEXT("b64"))
+            {
+                UsedBytes += StatData.FileSize;
+            }
+
+            return true;
+        }
+    );
+}
+
+void FFileConvertersPDFCache::EvictToBudget()
+{
+    if (UsedBytes <= BudgetBytes)
+    {
+        return;
+    }
+
+    struct FCacheEntry
+    {
+        FString Path;
+        int64 Size;
+        FDateTime LastUsed;
+    };
+
+    TArray<FCacheEntry> Array_Entries;
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    PlatformFile.IterateDirectoryStat(*GetCacheDir(), [&Array_Entries](const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            if (StatData.bIsDirectory == false && FPaths::GetExtension(CharPath) == TEXT("b64"))
+            {
+                Array_Entries.Add({ CharPath, StatData.FileSize, StatData.ModificationTime });
+            }
+
+            return true;
+        }
+    );
+
+    Array_Entries.Sort([](const FCacheEntry& A, const FCacheEntry& B) { return A.LastUsed < B.LastUsed; });
+
+    UsedBytes = 0;
+    for (const FCacheEntry& EachEntry : Array_Entries)
+    {
+        UsedBytes += EachEntry.Size;
+    }
+
+    for (const FCacheEntry& EachEntry : Array_Entries)
+    {
+        if (UsedBytes <= BudgetBytes)
+        {
+            break;
+        }
+
+        // Entries which are open by a reader can't be deleted on Windows, they stay until next eviction.
+        if (PlatformFile.DeleteFile(*EachEntry.Path) == true)
+        {
+            UsedBytes -= EachEntry.Size;
+        }
+    }
+}
+
+void FFileConvertersPDFCache::SetBudget(int64 InBudgetBytes)
+{
+    FScopeLock Lock(&Guard);
+    BudgetBytes = FMath::Max<int64>(InBudgetBytes, 0);
+    ScanUsedBytes();
+    EvictToBudget();
+}
+
+int64 FFileConvertersPDFCache::GetBudget()
+{
+    FScopeLock Lock(&Guard);
+    return BudgetBytes;
+}
+
+int64 FFileConvertersPDFCache::GetUsedBytes()
+{
+    FScopeLock Lock(&Guard);
+    ScanUsedBytes();
+    return UsedBytes;
+}
+
+void FFileConvertersPDFCache::Clear()
+{
+    FScopeLock Lock(&Guard);
+    FPlatformFileManager::Get().GetPlatformFile().DeleteDirectoryRecursively(*GetCacheDir());
+    UsedBytes = 0;
+}
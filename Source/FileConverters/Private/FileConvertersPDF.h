@@ -0,0 +1,75 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+/*
+*	Single pass PDF embedding for HTML viewer templates.
+*	PDF is encoded straight into one pre-sized output string, so peak memory is the output itself plus one read chunk.
+*/
+class FFileConvertersPDF
+{
+public:
+
+	/* Read size for file based embedding. It is a multiple of 3, so only the last chunk produces Base64 padding. */
+	static constexpr int64 ChunkSize = 3 * 256 * 1024;
+
+	/* Number of characters Base64 produces for given byte count, padding included. */
+	static int64 GetEncodedLength(int64 ByteCount);
+
+	/* Encodes source bytes into destination. Destination needs GetEncodedLength(SourceSize) characters. */
+	static void EncodeBase64(const uint8* Source, int64 SourceSize, TCHAR* Dest);
+	static void EncodeBase64(const uint8* Source, int64 SourceSize, ANSICHAR* Dest);
+
+	/* Replaces every DummyText in template with Base64 of given bytes. */
+	static bool EmbedBytes(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, const TArray<uint8>& In_PDF_Bytes);
+
+	/* Replaces every DummyText in template with Base64 of given file. File is read in ChunkSize pieces. */
+	static bool EmbedFile(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, const FString& In_PDF_Path);
+
+	/* Replaces every DummyText in template with already encoded payload. WritePayload has to write exactly EncodedLength characters. */
+	static bool Splice(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, int64 EncodedLength, TFunctionRef<bool(TCHAR* Dest)> WritePayload);
+};
+
+/*
+*	Persistent cache of encoded PDF payloads.
+*	Entries are plain Base64 (ANSI) files under Saved/FileConverters/PDFCache, keyed by full path, size and modification time.
+*	Hits refresh the entry timestamp, eviction removes the least recently used entries until the disk budget fits.
+*/
+class FFileConvertersPDFCache
+{
+public:
+
+	static FFileConvertersPDFCache& Get();
+
+	/* Same as FFileConvertersPDF::EmbedFile, but payload is read from cache when possible. Thread safe. */
+	bool Embed(FString& OutHTML, FString& ErrorCode, const FString& In_HTML_Content, const FString& DummyText, const FString& In_PDF_Path);
+
+	void SetBudget(int64 InBudgetBytes);
+	int64 GetBudget();
+	int64 GetUsedBytes();
+	void Clear();
+
+private:
+
+	FString GetCacheDir() const;
+	FString GetEntryPath(const FString& FullPath, const FFileStatData& StatData) const;
+
+	/* Encodes PDF into a temporary file and moves it to entry path. Returns true if entry exists, bOutIsCreated only if this call created it. */
+	bool WriteEntry(const FString& In_PDF_Path, int64 FileSize, const FString& EntryPath, bool& bOutIsCreated);
+
+	/* Splices entry payload into template. ANSI payload is widened while it is copied. */
+	bool SpliceEntry(FString& OutHTML, const FString& In_HTML_Content, const FString& DummyText, const FString& EntryPath);
+
+	/* Needs Guard. Scans cache folder once to learn used bytes. */
+	void ScanUsedBytes();
+
+	/* Needs Guard. Removes oldest entries until used bytes fit into budget. */
+	void EvictToBudget();
+
+	FCriticalSection Guard;
+	int64 BudgetBytes = 1024LL * 1024LL * 1024LL;
+	int64 UsedBytes = INDEX_NONE;
+};
@@ -0,0 +1,250 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersSearch.h"
+#include "FileConvertersBPLibrary.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "Async/ParallelFor.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformFileManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+#include <atomic>
+
+namespace FileConvertersWalker
+{
+    struct FWorkerQueue
+    {
+        FCriticalSection Guard;
+        TArray<FString> Folders;
+
+        /* Set while worker waits for work. Whoever clears it triggers WakeEvent. */
+        std::atomic<bool> bIsIdle{ false };
+        FEvent* WakeEvent = nullptr;
+    };
+
+    static bool HasQueuedFolders(TArray<TUniquePtr<FWorkerQueue>>& Queues)
+    {
+        for (const TUniquePtr<FWorkerQueue>& EachQueue : Queues)
+        {
+            FScopeLock Lock(&EachQueue->Guard);
+
+            if (EachQueue->Folders.IsEmpty() == false)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Wakes one idle worker after a push.
+    static void WakeIdle(TArray<TUniquePtr<FWorkerQueue>>& Queues, std::atomic<int32>& IdleCount)
+    {
+        for (const TUniquePtr<FWorkerQueue>& EachQueue : Queues)
+        {
+            if (EachQueue->bIsIdle.exchange(false) == true)
+            {
+                IdleCount.fetch_sub(1);
+                EachQueue->WakeEvent->Trigger();
+                return;
+            }
+        }
+    }
+
+    static bool PopOwn(FWorkerQueue& OwnQueue, FString& OutFolder)
+    {
+        FScopeLock Lock(&OwnQueue.Guard);
+
+        if (OwnQueue.Folders.IsEmpty() == true)
+        {
+            return false;
+        }
+
+        OutFolder = OwnQueue.Folders.Pop(false);
+        return true;
+    }
+
+    static bool Steal(TArray<TUniquePtr<FWorkerQueue>>& Queues, int32 WorkerIndex, FString& OutFolder)
+    {
+        const int32 WorkerCount = Queues.Num();
+
+        for (int32 Offset = 1; Offset < WorkerCount; Offset++)
+        {
+            FWorkerQueue& VictimQueue = *Queues[(WorkerIndex + Offset) % WorkerCount];
+            TArray<FString> Array_Stolen;
+
+            {
+                FScopeLock Lock(&VictimQueue.Guard);
+
+                // Oldest folders are the shallowest ones, so they carry the biggest subtrees.
+                const int32 StealCount = (VictimQueue.Folders.Num() + 1) / 2;
+
+                if (StealCount == 0)
+                {
+                    continue;
+                }
+
+                Array_Stolen.Reserve(StealCount);
+                for (int32 StealIndex = 0; StealIndex < StealCount; StealIndex++)
+                {
+                    Array_Stolen.Add(MoveTemp(VictimQueue.Folders[StealIndex]));
+                }
+
+                VictimQueue.Folders.RemoveAt(0, StealCount, false);
+            }
+
+            OutFolder = Array_Stolen.Pop(false);
+
+            if (Array_Stolen.IsEmpty() == false)
+            {
+                FWorkerQueue& OwnQueue = *Queues[WorkerIndex];
+                FScopeLock Lock(&OwnQueue.Guard);
+                OwnQueue.Folders.Append(MoveTemp(Array_Stolen));
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+}
+
+int32 FFileConvertersWalker::GetDefaultWorkerCount()
+{
+    // Walk is mostly waiting for file system, more workers than cores still helps on network shares.
+    return FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads(), 2, 16);
+}
+
+void FFileConvertersWalker::Walk(const FString& RootPath, int32 WorkerCount, FVisitor Visitor)
+{
+    using namespace FileConvertersWalker;
+
+    FILECONVERTERS_PHASE_SCOPE(DirectoryWalk);
+
+    WorkerCount = FMath::Max(WorkerCount, 1);
+
+    TArray<TUniquePtr<FWorkerQueue>> Queues;
+    for (int32 WorkerIndex = 0; WorkerIndex < WorkerCount; WorkerIndex++)
+    {
+        Queues.Add(MakeUnique<FWorkerQueue>());
+        Queues.Last()->WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    }
+
+    // Pushes skip the idle scan while every worker is busy, which is most of the walk.
+    std::atomic<int32> IdleCount{ 0 };
+
+    // Folders which are queued or being iterated. Walk is over when it hits zero.
+    std::atomic<int64> PendingFolders{ 1 };
+    Queues[0]->Folders.Add(RootPath);
+
+    std::atomic<int64> VisitedEntries{ 0 };
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    ParallelFor(WorkerCount, [&](int32 WorkerIndex)
+        {
+            FWorkerQueue& OwnQueue = *Queues[WorkerIndex];
+            FString Folder;
+
+            while (PendingFolders.load() > 0)
+            {
+                if (PopOwn(OwnQueue, Folder) == false && Steal(Queues, WorkerIndex, Folder) == false)
+                {
+                    // Others are still iterating folders, they may push new work. Idle flag is set before the last check, so a push after the check always wakes this worker.
+                    OwnQueue.bIsIdle.store(true);
+                    IdleCount.fetch_add(1);
+
+                    if (PendingFolders.load() > 0 && HasQueuedFolders(Queues) == false)
+                    {
+                        OwnQueue.WakeEvent->Wait();
+                    }
+
+                    if (OwnQueue.bIsIdle.exchange(false) == true)
+                    {
+                        IdleCount.fetch_sub(1);
+                    }
+
+                    continue;
+                }
+
+                PlatformFile.IterateDirectoryStat(*Folder, [&](const TCHAR* CharPath, const FFileStatData& StatData)
+                    {
+                        Visitor(WorkerIndex, CharPath, StatData);
+                        VisitedEntries.fetch_add(1, std::memory_order_relaxed);
+
+                        if (StatData.bIsDirectory == true)
+                        {
+                            PendingFolders.fetch_add(1);
+
+                            {
+                                FScopeLock Lock(&OwnQueue.Guard);
+                                OwnQueue.Folders.Emplace(CharPath);
+                            }
+
+                            if (IdleCount.load() > 0)
+                            {
+                                WakeIdle(Queues, IdleCount);
+                            }
+                        }
+
+                        return true;
+                    }
+                );
+
+                // Children are already counted, so this can't drop to zero while work remains. Last folder wakes everyone to leave.
+                if (PendingFolders.fetch_sub(1) == 1)
+                {
+                    for (const TUniquePtr<FWorkerQueue>& EachQueue : Queues)
+                    {
+                        EachQueue->WakeEvent->Trigger();
+                    }
+                }
+            }
+        }
+    );
+
+    for (const TUniquePtr<FWorkerQueue>& EachQueue : Queues)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(EachQueue->WakeEvent);
+    }
+
+    PhaseScope_DirectoryWalk.AddItems(VisitedEntries.load());
+}
+
+FStringView FFileConvertersSearch::GetCleanName(FStringView Path)
+{
+    int32 SlashIndex = INDEX_NONE;
+    for (int32 CharIndex = Path.Len() - 1; CharIndex >= 0; CharIndex--)
+    {
+        if (Path[CharIndex] == TEXT('/') || Path[CharIndex] == TEXT('\\'))
+        {
+            SlashIndex = CharIndex;
+            break;
+        }
+    }
+
+    return Path.RightChop(SlashIndex + 1);
+}
+
+FStringView FFileConvertersSearch::GetBaseName(FStringView Path)
+{
+    const FStringView CleanName = GetCleanName(Path);
+
+    int32 DotIndex = INDEX_NONE;
+    if (CleanName.FindLastChar(TEXT('.'), DotIndex) == true)
+    {
+        return CleanName.Left(DotIndex);
+    }
+
+    return CleanName;
+}
+
+void FFileConvertersSearch::SetStat(FFolderContent& Content, const FFileStatData& StatData)
+{
+    Content.bIsFile = StatData.bIsDirectory == false;
+    Content.Size = StatData.bIsDirectory ? 0 : StatData.FileSize;
+    Content.ModificationTime = StatData.ModificationTime;
+    Content.CreationTime = StatData.CreationTime;
+}
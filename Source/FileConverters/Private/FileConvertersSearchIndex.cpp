@@ -0,0 +1,1017 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersSearchIndex.h"
+#include "FileConverters.h"
+#include "FileConvertersSearch.h"
+#include "FileConvertersStats.h"
+#include "FileConvertersWatcher.h"
+
+// UE Includes.
+#include "Algo/BinarySearch.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/Archive.h"
+#include "String/Find.h"
+
+namespace FileConvertersSearchIndex
+{
+    static constexpr uint32 FileMagic = 0x58494346;     // FCIX
+    static constexpr uint32 FileVersion = 2;
+
+    template<typename ElementType>
+    static void SerializeRaw(FArchive& Archive, TArray<ElementType>& Array)
+    {
+        int32 ElementCount = Array.Num();
+        Archive << ElementCount;
+
+        if (Archive.IsLoading() == true)
+        {
+            // Count of a damaged file mustn't allocate more than the file holds.
+            if (ElementCount < 0 || int64(ElementCount) * int64(sizeof(ElementType)) > Archive.TotalSize() - Archive.Tell())
+            {
+                Archive.SetError();
+                return;
+            }
+
+            Array.SetNumUninitialized(ElementCount);
+        }
+
+        Archive.Serialize(Array.GetData(), int64(ElementCount) * sizeof(ElementType));
+    }
+
+    static bool Serialize(FArchive& Archive, FFileConvertersRootIndex& Index)
+    {
+        uint32 Magic = FileMagic;
+        uint32 Version = FileVersion;
+        uint32 CharSize = sizeof(TCHAR);
+        uint32 EntrySize = sizeof(FFileConvertersRootIndex::FEntry);
+
+        Archive << Magic << Version << CharSize << EntrySize;
+
+        if (Magic != FileMagic || Version != FileVersion || CharSize != sizeof(TCHAR) || EntrySize != sizeof(FFileConvertersRootIndex::FEntry))
+        {
+            return false;
+        }
+
+        Archive << Index.RootPath;
+        SerializeRaw(Archive, Index.PathArena);
+        SerializeRaw(Archive, Index.Entries);
+        SerializeRaw(Archive, Index.EntryStats);
+        SerializeRaw(Archive, Index.TrigramKeys);
+        SerializeRaw(Archive, Index.PostingOffsets);
+        SerializeRaw(Archive, Index.Postings);
+
+        return Archive.IsError() == false && Index.EntryStats.Num() == Index.Entries.Num();
+    }
+
+    // Worker local part of an index. Parts are concatenated after the walk.
+    struct FIndexPart
+    {
+        TArray<TCHAR> PathArena;
+        TArray<FFileConvertersRootIndex::FEntry> Entries;
+        TArray<FFileConvertersRootIndex::FEntryStat> EntryStats;
+    };
+}
+
+FFileConvertersRootIndex::FEntryStat FFileConvertersRootIndex::MakeStat(const FFileStatData& StatData)
+{
+    FEntryStat Stat;
+    Stat.Size = StatData.bIsDirectory ? 0 : StatData.FileSize;
+    Stat.ModificationTicks = StatData.ModificationTime.GetTicks();
+    Stat.CreationTicks = StatData.CreationTime.GetTicks();
+
+    return Stat;
+}
+
+uint32 FFileConvertersRootIndex::MakeTrigram(TCHAR First, TCHAR Second, TCHAR Third)
+{
+    const uint32 A = FChar::ToLower(First);
+    const uint32 B = FChar::ToLower(Second);
+    const uint32 C = FChar::ToLower(Third);
+
+    // Latin-1 trigrams are packed exactly, others are hashed into the upper half.
+    if ((A | B | C) < 256)
+    {
+        return (A << 16) | (B << 8) | C;
+    }
+
+    return ((A * 0x9E3779B1u) ^ (B * 0x85EBCA77u) ^ (C * 0xC2B2AE3Du)) | 0x80000000u;
+}
+
+uint32 FFileConvertersRootIndex::HashPath(FStringView RelativePath)
+{
+    // FNV-1a.
+    uint32 Hash = 2166136261u;
+
+    for (const TCHAR EachChar : RelativePath)
+    {
+        Hash = (Hash ^ uint32(FChar::ToLower(EachChar))) * 16777619u;
+    }
+
+    return Hash;
+}
+
+void FFileConvertersRootIndex::GetTrigrams(FStringView BaseName, TArray<uint32, TInlineAllocator<64>>& OutKeys)
+{
+    OutKeys.Reset();
+
+    for (int32 CharIndex = 0; CharIndex + 2 < BaseName.Len(); CharIndex++)
+    {
+        OutKeys.Add(MakeTrigram(BaseName[CharIndex], BaseName[CharIndex + 1], BaseName[CharIndex + 2]));
+    }
+
+    OutKeys.Sort();
+
+    // Remove adjacent duplicates.
+    int32 UniqueCount = 0;
+    for (int32 KeyIndex = 0; KeyIndex < OutKeys.Num(); KeyIndex++)
+    {
+        if (UniqueCount == 0 || OutKeys[UniqueCount - 1] != OutKeys[KeyIndex])
+        {
+            OutKeys[UniqueCount++] = OutKeys[KeyIndex];
+        }
+    }
+
+    OutKeys.SetNum(UniqueCount, false);
+}
+
+TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> FFileConvertersRootIndex::Build(const FString& InRootPath)
+{
+    using namespace FileConvertersSearchIndex;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 RootLength = InRootPath.Len() + 1;
+    const int32 WorkerCount = FFileConvertersWalker::GetDefaultWorkerCount();
+
+    TArray<FIndexPart> Array_Parts;
+    Array_Parts.SetNum(WorkerCount);
+
+    FFileConvertersWalker::Walk(InRootPath, WorkerCount, [&Array_Parts, RootLength](int32 WorkerIndex, const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            const FStringView RelativePath = FStringView(CharPath).RightChop(RootLength);
+
+            if (RelativePath.Len() > MAX_uint16)
+            {
+                return;
+            }
+
+            const FStringView CleanName = FFileConvertersSearch::GetCleanName(RelativePath);
+            const FStringView BaseName = FFileConvertersSearch::GetBaseName(RelativePath);
+
+            FIndexPart& Part = Array_Parts[WorkerIndex];
+
+            FEntry& Entry = Part.Entries.AddDefaulted_GetRef();
+            Entry.PathOffset = static_cast<uint32>(Part.PathArena.Num());
+            Entry.PathLength = static_cast<uint16>(RelativePath.Len());
+            Entry.NameStart = static_cast<uint16>(RelativePath.Len() - CleanName.Len());
+            Entry.BaseLength = static_cast<uint16>(BaseName.Len());
+            Entry.bIsDirectory = StatData.bIsDirectory ? 1 : 0;
+
+            Part.EntryStats.Add(MakeStat(StatData));
+            Part.PathArena.Append(RelativePath.GetData(), RelativePath.Len());
+        }
+    );
+
+    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index = MakeShared<FFileConvertersRootIndex, ESPMode::ThreadSafe>();
+    Index->RootPath = InRootPath;
+
+    int64 ArenaSize = 0;
+    int64 EntryCount = 0;
+    for (const FIndexPart& EachPart : Array_Parts)
+    {
+        ArenaSize += EachPart.PathArena.Num();
+        EntryCount += EachPart.Entries.Num();
+    }
+
+    if (ArenaSize >= MAX_int32 || EntryCount >= MAX_int32)
+    {
+        UE_LOG(LogFileConverters, Warning, TEXT("Search index for %s is too big. Entries: %lld"), *InRootPath, EntryCount);
+        return nullptr;
+    }
+
+    Index->PathArena.Reserve(ArenaSize);
+    Index->Entries.Reserve(EntryCount);
+    Index->EntryStats.Reserve(EntryCount);
+
+    for (FIndexPart& EachPart : Array_Parts)
+    {
+        const uint32 ArenaOffset = Index->PathArena.Num();
+
+        for (FEntry& EachEntry : EachPart.Entries)
+        {
+            EachEntry.PathOffset += ArenaOffset;
+        }
+
+        Index->PathArena.Append(EachPart.PathArena);
+        Index->Entries.Append(EachPart.Entries);
+        Index->EntryStats.Append(EachPart.EntryStats);
+
+        EachPart.PathArena.Empty();
+        EachPart.Entries.Empty();
+        EachPart.EntryStats.Empty();
+    }
+
+    Index->BuildTrigrams();
+    Index->BuildPathKeys();
+    Index->BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+    return Index;
+}
+
+void FFileConvertersRootIndex::BuildPathKeys()
+{
+    PathKeys.SetNumUninitialized(Entries.Num());
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+    {
+        PathKeys[EntryIndex] = (uint64(HashPath(GetRelativePath(PathArena, Entries[EntryIndex]))) << 32) | uint32(EntryIndex);
+    }
+
+    PathKeys.Sort();
+}
+
+void FFileConvertersRootIndex::BuildTrigrams()
+{
+    TArray<uint32, TInlineAllocator<64>> EntryKeys;
+
+    // First pass counts postings per key, second pass fills them. Postings end up sorted by entry index.
+    TMap<uint32, uint32> KeyCounts;
+    for (const FEntry& EachEntry : Entries)
+    {
+        GetTrigrams(GetBaseName(PathArena, EachEntry), EntryKeys);
+
+        for (const uint32 EachKey : EntryKeys)
+        {
+            KeyCounts.FindOrAdd(EachKey)++;
+        }
+    }
+
+    KeyCounts.KeySort([](uint32 A, uint32 B) { return A < B; });
+
+    TrigramKeys.Reset(KeyCounts.Num());
+    PostingOffsets.Reset(KeyCounts.Num() + 1);
+
+    TMap<uint32, int32> KeySlots;
+    KeySlots.Reserve(KeyCounts.Num());
+
+    uint32 PostingCount = 0;
+    for (const TPair<uint32, uint32>& EachCount : KeyCounts)
+    {
+        KeySlots.Add(EachCount.Key, TrigramKeys.Num());
+        TrigramKeys.Add(EachCount.Key);
+        PostingOffsets.Add(PostingCount);
+        PostingCount += EachCount.Value;
+    }
+
+    PostingOffsets.Add(PostingCount);
+    Postings.SetNumUninitialized(PostingCount);
+
+    TArray<uint32> Array_Cursors(PostingOffsets.GetData(), TrigramKeys.Num());
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+    {
+        GetTrigrams(GetBaseName(PathArena, Entries[EntryIndex]), EntryKeys);
+
+        for (const uint32 EachKey : EntryKeys)
+        {
+            Postings[Array_Cursors[KeySlots[EachKey]]++] = EntryIndex;
+        }
+    }
+}
+
+TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> FFileConvertersRootIndex::Load(const FString& FilePath, const FString& InRootPath)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+
+    if (Reader.IsValid() == false)
+    {
+        return nullptr;
+    }
+
+    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index = MakeShared<FFileConvertersRootIndex, ESPMode::ThreadSafe>();
+
+    if (FileConvertersSearchIndex::Serialize(*Reader, *Index) == false || Index->RootPath != InRootPath)
+    {
+        return nullptr;
+    }
+
+    // A damaged file would send queries outside of arena or entries.
+    if (Index->IsConsistent() == false)
+    {
+        UE_LOG(LogFileConverters, Warning, TEXT("Search index file %s is damaged, index is rebuilt."), *FilePath);
+        return nullptr;
+    }
+
+    Index->BuildPathKeys();
+
+    return Index;
+}
+
+bool FFileConvertersRootIndex::IsConsistent() const
+{
+    for (const FEntry& EachEntry : Entries)
+    {
+        if (int64(EachEntry.PathOffset) + EachEntry.PathLength > PathArena.Num() || int32(EachEntry.NameStart) + EachEntry.BaseLength > EachEntry.PathLength)
+        {
+            return false;
+        }
+    }
+
+    if (PostingOffsets.Num() != TrigramKeys.Num() + 1 || PostingOffsets[0] != 0 || PostingOffsets.Last() != uint32(Postings.Num()))
+    {
+        return false;
+    }
+
+    // Keys are binary searched, so they have to be ascending too.
+    for (int32 KeyIndex = 0; KeyIndex < TrigramKeys.Num(); KeyIndex++)
+    {
+        if (PostingOffsets[KeyIndex] > PostingOffsets[KeyIndex + 1] || (KeyIndex > 0 && TrigramKeys[KeyIndex - 1] >= TrigramKeys[KeyIndex]))
+        {
+            return false;
+        }
+    }
+
+    // Candidate lists are intersected with binary search, each list is ascending.
+    for (int32 KeyIndex = 0; KeyIndex < TrigramKeys.Num(); KeyIndex++)
+    {
+        for (uint32 PostingIndex = PostingOffsets[KeyIndex]; PostingIndex < PostingOffsets[KeyIndex + 1]; PostingIndex++)
+        {
+            if (Postings[PostingIndex] >= uint32(Entries.Num()) || (PostingIndex > PostingOffsets[KeyIndex] && Postings[PostingIndex - 1] >= Postings[PostingIndex]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FFileConvertersRootIndex::Save(const FString& FilePath) const
+{
+    TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+
+    if (Writer.IsValid() == false)
+    {
+        return false;
+    }
+
+    // Serialize is symmetric, it doesn't change anything while saving.
+    const bool bIsSaved = FileConvertersSearchIndex::Serialize(*Writer, const_cast<FFileConvertersRootIndex&>(*this));
+    return Writer->Close() && bIsSaved;
+}
+
+bool FFileConvertersRootIndex::FindCandidates(FStringView InSearch, TArray<uint32>& OutCandidates) const
+{
+    OutCandidates.Reset();
+
+    // Too short for trigrams. Caller scans the arena, it is still far cheaper than the disk.
+    if (InSearch.Len() < 3)
+    {
+        return false;
+    }
+
+    TArray<uint32, TInlineAllocator<64>> QueryKeys;
+    GetTrigrams(InSearch, QueryKeys);
+
+    TArray<TArrayView<const uint32>, TInlineAllocator<64>> Array_Lists;
+    for (const uint32 EachKey : QueryKeys)
+    {
+        const int32 KeyIndex = Algo::BinarySearch(TrigramKeys, EachKey);
+
+        if (KeyIndex == INDEX_NONE)
+        {
+            return true;
+        }
+
+        Array_Lists.Add(TArrayView<const uint32>(Postings.GetData() + PostingOffsets[KeyIndex], PostingOffsets[KeyIndex + 1] - PostingOffsets[KeyIndex]));
+    }
+
+    // Intersect starting from the rarest trigram. Candidates shrink quickly, others are binary searched.
+    Array_Lists.Sort([](const TArrayView<const uint32>& A, const TArrayView<const uint32>& B) { return A.Num() < B.Num(); });
+
+    OutCandidates.Append(Array_Lists[0].GetData(), Array_Lists[0].Num());
+    for (int32 ListIndex = 1; ListIndex < Array_Lists.Num() && OutCandidates.IsEmpty() == false; ListIndex++)
+    {
+        const TArrayView<const uint32>& List = Array_Lists[ListIndex];
+        OutCandidates.RemoveAll([&List](uint32 Candidate) { return Algo::BinarySearch(List, Candidate) == INDEX_NONE; });
+    }
+
+    return true;
+}
+
+void FFileConvertersRootIndex::Query(FStringView RelativePrefix, const FFileConvertersMatcher& Matcher, TArray<FFolderContent>& OutFounds) const
+{
+    // Wall time of the whole query. Name matching of walks is CPU time summed over workers, the two aren't comparable.
+    FILECONVERTERS_PHASE_SCOPE(IndexQuery);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    auto AcceptEntry = [this, RelativePrefix, &Matcher, &OutFounds](const TArray<TCHAR>& Arena, const FEntry& Entry, const FEntryStat& Stat)
+        {
+            const FStringView RelativePath = GetRelativePath(Arena, Entry);
+            const FStringView CleanName = RelativePath.RightChop(Entry.NameStart);
+
+            int32 Score = 0;
+            if (Matcher.Matches(CleanName, Entry.bIsDirectory == 1, Score) == false)
+            {
+                return;
+            }
+
+            if (RelativePath.StartsWith(RelativePrefix, ESearchCase::IgnoreCase) == false)
+            {
+                return;
+            }
+
+            const FString Path = RootPath / FString(RelativePath.Len(), RelativePath.GetData());
+
+            if (Matcher.ShouldCollect(OutFounds, Path, Score) == false)
+            {
+                return;
+            }
+
+            FFolderContent EachContent;
+            EachContent.Path = Path;
+            EachContent.Name = FString(CleanName.Len(), CleanName.GetData());
+            EachContent.bIsFile = Entry.bIsDirectory == 0;
+            EachContent.Size = Stat.Size;
+            EachContent.ModificationTime = FDateTime(Stat.ModificationTicks);
+            EachContent.CreationTime = FDateTime(Stat.CreationTicks);
+            EachContent.Score = Score;
+
+            Matcher.Collect(OutFounds, MoveTemp(EachContent));
+        };
+
+    FReadScopeLock Lock(DeltaLock);
+
+    // Glob and fuzzy have no literal every match must contain, they scan the arena.
+    TArray<uint32> Array_Candidates;
+    if (FindCandidates(Matcher.GetRequiredLiteral(), Array_Candidates) == true)
+    {
+        for (const uint32 EachCandidate : Array_Candidates)
+        {
+            if (IsRemoved(EachCandidate) == false)
+            {
+                AcceptEntry(PathArena, Entries[EachCandidate], EntryStats[EachCandidate]);
+            }
+        }
+    }
+
+    else
+    {
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+        {
+            if (IsRemoved(EntryIndex) == false)
+            {
+                AcceptEntry(PathArena, Entries[EntryIndex], EntryStats[EntryIndex]);
+            }
+        }
+    }
+
+    // Entries added after build are few, they are scanned.
+    for (int32 DeltaIndex = 0; DeltaIndex < DeltaEntries.Num(); DeltaIndex++)
+    {
+        AcceptEntry(DeltaArena, DeltaEntries[DeltaIndex], DeltaStats[DeltaIndex]);
+    }
+
+    LastQuerySeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+int32 FFileConvertersRootIndex::FindEntry(FStringView RelativePath) const
+{
+    const uint64 Hash = uint64(HashPath(RelativePath)) << 32;
+
+    // Entries with the same hash are next to each other, collisions are told apart by comparing paths.
+    for (int32 KeyIndex = Algo::LowerBound(PathKeys, Hash); KeyIndex < PathKeys.Num() && (PathKeys[KeyIndex] & 0xFFFFFFFF00000000ull) == Hash; KeyIndex++)
+    {
+        const int32 EntryIndex = int32(PathKeys[KeyIndex] & 0xFFFFFFFFull);
+
+        if (IsRemoved(EntryIndex) == false && GetRelativePath(PathArena, Entries[EntryIndex]).Equals(RelativePath, ESearchCase::IgnoreCase) == true)
+        {
+            return EntryIndex;
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+void FFileConvertersRootIndex::AddEntry(FStringView RelativePath, const FFileStatData& StatData)
+{
+    if (RelativePath.IsEmpty() == true || RelativePath.Len() > MAX_uint16)
+    {
+        return;
+    }
+
+    FWriteScopeLock Lock(DeltaLock);
+
+    if (bIsCompacting == true)
+    {
+        CompactionLog.Add({ FString(RelativePath.Len(), RelativePath.GetData()), false, StatData });
+    }
+
+    const int32 EntryIndex = FindEntry(RelativePath);
+    if (EntryIndex != INDEX_NONE)
+    {
+        EntryStats[EntryIndex] = MakeStat(StatData);
+        return;
+    }
+
+    for (int32 DeltaIndex = 0; DeltaIndex < DeltaEntries.Num(); DeltaIndex++)
+    {
+        if (GetRelativePath(DeltaArena, DeltaEntries[DeltaIndex]).Equals(RelativePath, ESearchCase::IgnoreCase) == true)
+        {
+            DeltaStats[DeltaIndex] = MakeStat(StatData);
+            return;
+        }
+    }
+
+    const FStringView CleanName = FFileConvertersSearch::GetCleanName(RelativePath);
+    const FStringView BaseName = FFileConvertersSearch::GetBaseName(RelativePath);
+
+    FEntry& Entry = DeltaEntries.AddDefaulted_GetRef();
+    Entry.PathOffset = static_cast<uint32>(DeltaArena.Num());
+    Entry.PathLength = static_cast<uint16>(RelativePath.Len());
+    Entry.NameStart = static_cast<uint16>(RelativePath.Len() - CleanName.Len());
+    Entry.BaseLength = static_cast<uint16>(BaseName.Len());
+    Entry.bIsDirectory = StatData.bIsDirectory ? 1 : 0;
+
+    DeltaStats.Add(MakeStat(StatData));
+    DeltaArena.Append(RelativePath.GetData(), RelativePath.Len());
+}
+
+void FFileConvertersRootIndex::RemoveEntry(FStringView RelativePath)
+{
+    if (RelativePath.IsEmpty() == true)
+    {
+        return;
+    }
+
+    FWriteScopeLock Lock(DeltaLock);
+
+    const FString ChildPrefix = FString(RelativePath.Len(), RelativePath.GetData()) + TEXT("/");
+
+    auto RemoveLive = [this](int32 EntryIndex)
+        {
+            if (RemovedEntries.Num() != Entries.Num())
+            {
+                RemovedEntries.Init(false, Entries.Num());
+            }
+
+            if (RemovedEntries[EntryIndex] == false)
+            {
+                RemovedEntries[EntryIndex] = true;
+                RemovedCount++;
+            }
+        };
+
+    const int32 EntryIndex = FindEntry(RelativePath);
+    if (EntryIndex != INDEX_NONE)
+    {
+        RemoveLive(EntryIndex);
+
+        // Watcher reports only the folder itself, everything under it is gone too.
+        if (Entries[EntryIndex].bIsDirectory == 1)
+        {
+            for (int32 ChildIndex = 0; ChildIndex < Entries.Num(); ChildIndex++)
+            {
+                if (GetRelativePath(PathArena, Entries[ChildIndex]).StartsWith(ChildPrefix, ESearchCase::IgnoreCase) == true)
+                {
+                    RemoveLive(ChildIndex);
+                }
+            }
+        }
+    }
+
+    // Stats are a parallel column, so delta entries are compacted by hand instead of RemoveAll.
+    int32 KeptCount = 0;
+    for (int32 DeltaIndex = 0; DeltaIndex < DeltaEntries.Num(); DeltaIndex++)
+    {
+        const FStringView DeltaPath = GetRelativePath(DeltaArena, DeltaEntries[DeltaIndex]);
+
+        if (DeltaPath.Equals(RelativePath, ESearchCase::IgnoreCase) == false && DeltaPath.StartsWith(ChildPrefix, ESearchCase::IgnoreCase) == false)
+        {
+            DeltaEntries[KeptCount] = DeltaEntries[DeltaIndex];
+            DeltaStats[KeptCount] = DeltaStats[DeltaIndex];
+            KeptCount++;
+        }
+    }
+
+    DeltaEntries.SetNum(KeptCount, false);
+    DeltaStats.SetNum(KeptCount, false);
+
+    if (bIsCompacting == true)
+    {
+        CompactionLog.Add({ FString(RelativePath.Len(), RelativePath.GetData()), true });
+    }
+}
+
+int32 FFileConvertersRootIndex::GetDeltaSize() const
+{
+    FReadScopeLock Lock(DeltaLock);
+    return DeltaEntries.Num() + RemovedCount;
+}
+
+TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> FFileConvertersRootIndex::Compact()
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index = MakeShared<FFileConvertersRootIndex, ESPMode::ThreadSafe>();
+    Index->RootPath = RootPath;
+
+    {
+        FReadScopeLock Lock(DeltaLock);
+
+        Index->PathArena.Reserve(PathArena.Num() + DeltaArena.Num());
+        Index->Entries.Reserve(Entries.Num() - RemovedCount + DeltaEntries.Num());
+        Index->EntryStats.Reserve(Entries.Num() - RemovedCount + DeltaEntries.Num());
+
+        auto CopyEntry = [&Index](const TArray<TCHAR>& Arena, const FEntry& Entry, const FEntryStat& Stat)
+            {
+                Index->EntryStats.Add(Stat);
+
+                FEntry& NewEntry = Index->Entries.Add_GetRef(Entry);
+                NewEntry.PathOffset = static_cast<uint32>(Index->PathArena.Num());
+                Index->PathArena.Append(Arena.GetData() + Entry.PathOffset, Entry.PathLength);
+            };
+
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+        {
+            if (IsRemoved(EntryIndex) == false)
+            {
+                CopyEntry(PathArena, Entries[EntryIndex], EntryStats[EntryIndex]);
+            }
+        }
+
+        for (int32 DeltaIndex = 0; DeltaIndex < DeltaEntries.Num(); DeltaIndex++)
+        {
+            CopyEntry(DeltaArena, DeltaEntries[DeltaIndex], DeltaStats[DeltaIndex]);
+        }
+    }
+
+    Index->BuildTrigrams();
+    Index->BuildPathKeys();
+    Index->BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+    return Index;
+}
+
+int64 FFileConvertersRootIndex::GetAllocatedBytes() const
+{
+    FReadScopeLock Lock(DeltaLock);
+    return sizeof(FFileConvertersRootIndex) + RootPath.GetAllocatedSize() + PathArena.GetAllocatedSize() + Entries.GetAllocatedSize() + EntryStats.GetAllocatedSize() + TrigramKeys.GetAllocatedSize() + PostingOffsets.GetAllocatedSize() + Postings.GetAllocatedSize() + PathKeys.GetAllocatedSize()
+        + RemovedEntries.GetAllocatedSize() + DeltaArena.GetAllocatedSize() + DeltaEntries.GetAllocatedSize() + DeltaStats.GetAllocatedSize();
+}
+
+FSearchIndexStats FFileConvertersRootIndex::GetStats() const
+{
+    FSearchIndexStats Stats;
+    Stats.RootPath = RootPath;
+    Stats.MemoryBytes = GetAllocatedBytes();
+    Stats.TrigramCount = TrigramKeys.Num();
+    Stats.PostingCount = Postings.Num();
+
+    {
+        FReadScopeLock Lock(DeltaLock);
+        Stats.EntryCount = Entries.Num() - RemovedCount + DeltaEntries.Num();
+    }
+
+    Stats.BytesPerEntry = Stats.EntryCount > 0 ? float(double(Stats.MemoryBytes) / Stats.EntryCount) : 0.0f;
+    Stats.BuildSeconds = float(BuildSeconds);
+    Stats.LastQueryMicroseconds = float(LastQuerySeconds.load() * 1000000.0);
+
+    return Stats;
+}
+
+FFileConvertersSearchIndex& FFileConvertersSearchIndex::Get()
+{
+    static FFileConvertersSearchIndex SearchIndex;
+    return SearchIndex;
+}
+
+FFileConvertersSearchIndex::FFileConvertersSearchIndex()
+{
+    FFileConvertersWatcher::Get().OnFolderChanges.AddRaw(this, &FFileConvertersSearchIndex::HandleFolderChanges);
+}
+
+FString FFileConvertersSearchIndex::NormalizeRoot(const FString& InPath)
+{
+    FString NormalizedPath = FPaths::ConvertRelativePathToFull(InPath);
+    FPaths::NormalizeDirectoryName(NormalizedPath);
+
+    return NormalizedPath;
+}
+
+FString FFileConvertersSearchIndex::GetPersistPath(const FString& NormalizedRoot) const
+{
+    const FString RootKey = NormalizedRoot.ToLower();
+    const uint64 Key = FXxHash64::HashBuffer(*RootKey, RootKey.Len() * sizeof(TCHAR)).Hash;
+
+    return FPaths::ProjectSavedDir() / TEXT("FileConverters/SearchIndex") / FString::Printf(TEXT("%016llx.idx"), Key);
+}
+
+bool FFileConvertersSearchIndex::RegisterRoot(const FString& InRootPath, bool bRebuild, FSearchIndexStats& OutStats, FString& ErrorCode)
+{
+    const FString NormalizedRoot = NormalizeRoot(InRootPath);
+    const FString PersistPath = GetPersistPath(NormalizedRoot);
+
+    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index;
+
+    if (bRebuild == false)
+    {
+        Index = FFileConvertersRootIndex::Load(PersistPath, NormalizedRoot);
+    }
+
+    if (Index.IsValid() == false)
+    {
+        Index = FFileConvertersRootIndex::Build(NormalizedRoot);
+
+        if (Index.IsValid() == false)
+        {
+            ErrorCode = "Index couldn't be built.";
+            return false;
+        }
+
+        IFileManager::Get().MakeDirectory(*FPaths::GetPath(PersistPath), true);
+
+        if (Index->Save(PersistPath) == false)
+        {
+            UE_LOG(LogFileConverters, Warning, TEXT("Search index for %s couldn't be saved to %s"), *NormalizedRoot, *PersistPath);
+        }
+    }
+
+    OutStats = Index->GetStats();
+
+    UE_LOG(LogFileConverters, Log, TEXT("Search index for %s: %d entries, %d trigrams, %lld bytes (%.1f bytes per entry), built in %.2f seconds."), *OutStats.RootPath, OutStats.EntryCount, OutStats.TrigramCount, OutStats.MemoryBytes, OutStats.BytesPerEntry, OutStats.BuildSeconds);
+
+    bool bIsNewRoot = false;
+    {
+        FWriteScopeLock Lock(RootsLock);
+        bIsNewRoot = Roots.Contains(NormalizedRoot) == false;
+        Roots.Add(NormalizedRoot, MoveTemp(Index));
+    }
+
+    // Keep index correct without re-walking. Without a watcher, Rebuild is the only way to refresh it.
+    if (bIsNewRoot == true)
+    {
+        AsyncTask(ENamedThreads::GameThread, [NormalizedRoot]()
+            {
+                FString WatchError;
+                if (FFileConvertersWatcher::Get().WatchFolder(NormalizedRoot, WatchError) == false)
+                {
+                    UE_LOG(LogFileConverters, Log, TEXT("Search index for %s won't be updated automatically: %s"), *NormalizedRoot, *WatchError);
+                }
+            }
+        );
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+void FFileConvertersSearchIndex::UnregisterRoot(const FString& InRootPath, bool bDeletePersisted)
+{
+    const FString NormalizedRoot = NormalizeRoot(InRootPath);
+
+    bool bIsRemoved = false;
+    {
+        FWriteScopeLock Lock(RootsLock);
+        bIsRemoved = Roots.Remove(NormalizedRoot) > 0;
+    }
+
+    if (bIsRemoved == true)
+    {
+        FFileConvertersWatcher::Get().UnwatchFolder(NormalizedRoot);
+    }
+
+    if (bDeletePersisted == true)
+    {
+        IFileManager::Get().Delete(*GetPersistPath(NormalizedRoot), false, false, true);
+    }
+}
+
+bool FFileConvertersSearchIndex::Query(const FString& InPath, const FFileConvertersMatcher& Matcher, TArray<FFolderContent>& OutFounds)
+{
+    const FString NormalizedPath = NormalizeRoot(InPath);
+
+    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index;
+    {
+        FReadScopeLock Lock(RootsLock);
+
+        for (const TPair<FString, TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>>& EachRoot : Roots)
+        {
+            if (NormalizedPath.Equals(EachRoot.Key, ESearchCase::IgnoreCase) == true || FPaths::IsUnderDirectory(NormalizedPath, EachRoot.Key) == true)
+            {
+                Index = EachRoot.Value;
+                break;
+            }
+        }
+    }
+
+    if (Index.IsValid() == false)
+    {
+        return false;
+    }
+
+    FString RelativePrefix;
+    if (NormalizedPath.Len() > Index->RootPath.Len())
+    {
+        RelativePrefix = NormalizedPath.RightChop(Index->RootPath.Len() + 1) + TEXT("/");
+    }
+
+    Index->Query(RelativePrefix, Matcher, OutFounds);
+    Matcher.Finish(OutFounds);
+
+    return true;
+}
+
+void FFileConvertersSearchIndex::GetStats(TArray<FSearchIndexStats>& OutStats)
+{
+    FReadScopeLock Lock(RootsLock);
+
+    OutStats.Reset(Roots.Num());
+    for (const TPair<FString, TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>>& EachRoot : Roots)
+    {
+        OutStats.Add(EachRoot.Value->GetStats());
+    }
+}
+
+TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> FFileConvertersSearchIndex::FindRoot(const FString& NormalizedRoot)
+{
+    FReadScopeLock Lock(RootsLock);
+
+    const TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>* Index = Roots.Find(NormalizedRoot);
+    return Index ? *Index : nullptr;
+}
+
+void FFileConvertersSearchIndex::HandleFolderChanges(const FString& WatchedPath, const TArray<FFolderChange>& Changes)
+{
+    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index = FindRoot(WatchedPath);
+
+    if (Index.IsValid() == false)
+    {
+        return;
+    }
+
+    const int32 RootLength = Index->RootPath.Len() + 1;
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    for (const FFolderChange& EachChange : Changes)
+    {
+        if (EachChange.ChangeType == EFolderChangeType::RescanRequired)
+        {
+            StartRebuild(Index->RootPath);
+            return;
+        }
+
+        if (FPaths::IsUnderDirectory(EachChange.Path, Index->RootPath) == false || EachChange.Path.Len() <= RootLength)
+        {
+            continue;
+        }
+
+        const FStringView RelativePath = FStringView(EachChange.Path).RightChop(RootLength);
+
+        if (EachChange.ChangeType == EFolderChangeType::Added || EachChange.ChangeType == EFolderChangeType::Modified)
+        {
+            // One stat per changed entry. If it is already gone, its Removed change follows.
+            const FFileStatData StatData = PlatformFile.GetStatData(*EachChange.Path);
+
+            if (StatData.bIsValid == false)
+            {
+                continue;
+            }
+
+            Index->AddEntry(RelativePath, StatData);
+
+            if (EachChange.ChangeType == EFolderChangeType::Added && StatData.bIsDirectory == true)
+            {
+                AddFolderContents(Index->RootPath, EachChange.Path);
+            }
+        }
+
+        else if (EachChange.ChangeType == EFolderChangeType::Removed)
+        {
+            Index->RemoveEntry(RelativePath);
+        }
+    }
+
+    if (Index->bIsCompacting == false && Index->GetDeltaSize() > FMath::Max(1024, Index->Entries.Num() / 8))
+    {
+        StartCompaction(Index);
+    }
+}
+
+void FFileConvertersSearchIndex::AddFolderContents(const FString& NormalizedRoot, const FString& FolderPath)
+{
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [this, NormalizedRoot, FolderPath]()
+        {
+            const int32 WorkerCount = FFileConvertersWalker::GetDefaultWorkerCount();
+            const int32 RootLength = NormalizedRoot.Len() + 1;
+
+            TArray<TArray<TPair<FString, FFileStatData>>> Array_WorkerFounds;
+            Array_WorkerFounds.SetNum(WorkerCount);
+
+            FFileConvertersWalker::Walk(FolderPath, WorkerCount, [&Array_WorkerFounds, RootLength](int32 WorkerIndex, const TCHAR* CharPath, const FFileStatData& StatData)
+                {
+                    Array_WorkerFounds[WorkerIndex].Emplace(FString(CharPath + RootLength), StatData);
+                }
+            );
+
+            AsyncTask(ENamedThreads::GameThread, [this, NormalizedRoot, Array_WorkerFounds = MoveTemp(Array_WorkerFounds)]()
+                {
+                    TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index = FindRoot(NormalizedRoot);
+
+                    if (Index.IsValid() == false)
+                    {
+                        return;
+                    }
+
+                    for (const TArray<TPair<FString, FFileStatData>>& EachWorkerFounds : Array_WorkerFounds)
+                    {
+                        for (const TPair<FString, FFileStatData>& EachFound : EachWorkerFounds)
+                        {
+                            Index->AddEntry(EachFound.Key, EachFound.Value);
+                        }
+                    }
+                }
+            );
+        }
+    );
+}
+
+void FFileConvertersSearchIndex::StartCompaction(const TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>& Index)
+{
+    Index->bIsCompacting = true;
+
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [this, Index]()
+        {
+            TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> CompactIndex = Index->Compact();
+
+            AsyncTask(ENamedThreads::GameThread, [this, Index, CompactIndex]()
+                {
+                    Index->bIsCompacting = false;
+
+                    // Changes which came while copying are applied again. Adding or removing twice is harmless, adding again only refreshes stat.
+                    for (const FFileConvertersRootIndex::FDeltaOp& EachOp : Index->CompactionLog)
+                    {
+                        if (EachOp.bIsRemove == true)
+                        {
+                            CompactIndex->RemoveEntry(EachOp.RelativePath);
+                        }
+
+                        else
+                        {
+                            CompactIndex->AddEntry(EachOp.RelativePath, EachOp.StatData);
+                        }
+                    }
+
+                    Index->CompactionLog.Empty();
+
+                    {
+                        FWriteScopeLock Lock(RootsLock);
+                        TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>* CurrentIndex = Roots.Find(Index->RootPath);
+
+                        // Root was unregistered or rebuilt meanwhile.
+                        if (CurrentIndex == nullptr || *CurrentIndex != Index)
+                        {
+                            return;
+                        }
+
+                        *CurrentIndex = CompactIndex;
+                    }
+
+                    const FString PersistPath = GetPersistPath(CompactIndex->RootPath);
+                    AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [CompactIndex, PersistPath]()
+                        {
+                            CompactIndex->Save(PersistPath);
+                        }
+                    );
+                }
+            );
+        }
+    );
+}
+
+void FFileConvertersSearchIndex::StartRebuild(const FString& NormalizedRoot)
+{
+    AsyncTask(ENamedThreads::AnyNormalThreadNormalTask, [this, NormalizedRoot]()
+        {
+            TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Index = FFileConvertersRootIndex::Build(NormalizedRoot);
+
+            if (Index.IsValid() == false)
+            {
+                return;
+            }
+
+            Index->Save(GetPersistPath(NormalizedRoot));
+
+            FWriteScopeLock Lock(RootsLock);
+            if (TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>* CurrentIndex = Roots.Find(NormalizedRoot))
+            {
+                *CurrentIndex = Index;
+            }
+        }
+    );
+}
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "FileConvertersMatcher.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+#include <atomic>
+
+/*
+*	Trigram index of base names under one root folder.
+*	Relative paths live in one character arena, entries are fixed size records pointing into it.
+*	Trigram postings are kept in CSR form: sorted keys, offsets and one flat posting array.
+*	Size and timestamps are a separate column, name scans don't pull them into cache.
+*	Exact path lookups of watcher changes go through sorted path hashes, they don't scan entries.
+*/
+class FFileConvertersRootIndex
+{
+public:
+
+	struct FEntry
+	{
+		uint32 PathOffset = 0;
+		uint16 PathLength = 0;
+		uint16 NameStart = 0;
+		uint16 BaseLength = 0;
+		uint8 bIsDirectory = 0;
+	};
+
+	struct FEntryStat
+	{
+		int64 Size = 0;
+		int64 ModificationTicks = 0;
+		int64 CreationTicks = 0;
+	};
+
+	FString RootPath;
+	TArray<TCHAR> PathArena;
+	TArray<FEntry> Entries;
+	TArray<FEntryStat> EntryStats;
+	TArray<uint32> TrigramKeys;
+	TArray<uint32> PostingOffsets;
+	TArray<uint32> Postings;
+
+	/* Case folded path hash in upper half, entry index in lower half. Sorted. Not persisted, rebuilt after load. */
+	TArray<uint64> PathKeys;
+
+	double BuildSeconds = 0;
+	mutable std::atomic<double> LastQuerySeconds{ 0 };
+
+	/*
+	*	Changes after build. Postings are never touched after build, removed entries are only marked and added entries are scanned.
+	*	Compact() folds them into a new index once they grow.
+	*/
+	struct FDeltaOp
+	{
+		FString RelativePath;
+		bool bIsRemove = false;
+		FFileStatData StatData;
+	};
+
+	mutable FRWLock DeltaLock;
+	TBitArray<> RemovedEntries;
+	int32 RemovedCount = 0;
+	TArray<TCHAR> DeltaArena;
+	TArray<FEntry> DeltaEntries;
+	TArray<FEntryStat> DeltaStats;
+
+	/* Changes applied while a compaction copy was being built. They are replayed on the new index. */
+	bool bIsCompacting = false;
+	TArray<FDeltaOp> CompactionLog;
+
+	static TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Build(const FString& InRootPath);
+	/* Returns nullptr if file is missing, of another version or fails IsConsistent(). */
+	static TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Load(const FString& FilePath, const FString& InRootPath);
+	bool Save(const FString& FilePath) const;
+
+	/* Path ranges of entries stay inside arena, posting offsets are ascending and inside postings, postings point to entries. Loaded files are checked, queries trust them. */
+	bool IsConsistent() const;
+
+	/* Fills postings from entries. */
+	void BuildTrigrams();
+
+	/* Fills path keys from entries. */
+	void BuildPathKeys();
+
+	/* RelativePrefix is empty for root itself, otherwise it ends with "/". */
+	void Query(FStringView RelativePrefix, const FFileConvertersMatcher& Matcher, TArray<FFolderContent>& OutFounds) const;
+
+	/* Returns false if search is too short for trigrams, then every entry is a candidate. */
+	bool FindCandidates(FStringView InSearch, TArray<uint32>& OutCandidates) const;
+
+	/* Needs DeltaLock. Returns built entry with exactly this relative path. Binary search on path keys. */
+	int32 FindEntry(FStringView RelativePath) const;
+
+	/* Adds entry, or only refreshes its stat if it is already indexed. */
+	void AddEntry(FStringView RelativePath, const FFileStatData& StatData);
+
+	/* Removes entry and, if it is a folder, everything under it. */
+	void RemoveEntry(FStringView RelativePath);
+
+	int32 GetDeltaSize() const;
+
+	/* New index with removed entries dropped and added entries indexed. */
+	TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> Compact();
+
+	FORCEINLINE bool IsRemoved(int32 EntryIndex) const
+	{
+		return RemovedEntries.Num() == Entries.Num() && RemovedEntries[EntryIndex] == true;
+	}
+
+	int64 GetAllocatedBytes() const;
+	FSearchIndexStats GetStats() const;
+
+	FORCEINLINE static FStringView GetRelativePath(const TArray<TCHAR>& Arena, const FEntry& Entry)
+	{
+		return FStringView(Arena.GetData() + Entry.PathOffset, Entry.PathLength);
+	}
+
+	FORCEINLINE static FStringView GetBaseName(const TArray<TCHAR>& Arena, const FEntry& Entry)
+	{
+		return FStringView(Arena.GetData() + Entry.PathOffset + Entry.NameStart, Entry.BaseLength);
+	}
+
+	static FEntryStat MakeStat(const FFileStatData& StatData);
+
+	/* Case folded trigram key. Collisions only produce extra candidates, they are verified anyway. */
+	static uint32 MakeTrigram(TCHAR First, TCHAR Second, TCHAR Third);
+
+	/* Case folded, paths differing only in case hash the same. */
+	static uint32 HashPath(FStringView RelativePath);
+
+	/* Unique trigram keys of a base name. */
+	static void GetTrigrams(FStringView BaseName, TArray<uint32, TInlineAllocator<64>>& OutKeys);
+};
+
+/* Registered roots. Searches under a registered root are answered from memory. Changes are applied from watcher, without WITH_FILECONVERTERS_DIRECTORY_WATCHER they aren't tracked at all. */
+class FFileConvertersSearchIndex
+{
+public:
+
+	static FFileConvertersSearchIndex& Get();
+
+	static FString NormalizeRoot(const FString& InPath);
+
+	/* Blocking. Loads persisted index or walks the root, then publishes it. */
+	bool RegisterRoot(const FString& InRootPath, bool bRebuild, FSearchIndexStats& OutStats, FString& ErrorCode);
+	void UnregisterRoot(const FString& InRootPath, bool bDeletePersisted);
+
+	/* Returns false when InPath isn't under a registered root. Caller should walk the disk then. */
+	bool Query(const FString& InPath, const FFileConvertersMatcher& Matcher, TArray<FFolderContent>& OutFounds);
+
+	void GetStats(TArray<FSearchIndexStats>& OutStats);
+
+	/* Game thread. Applies watcher changes of a registered root. */
+	void HandleFolderChanges(const FString& WatchedPath, const TArray<FFolderChange>& Changes);
+
+private:
+
+	FFileConvertersSearchIndex();
+
+	FString GetPersistPath(const FString& NormalizedRoot) const;
+	TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe> FindRoot(const FString& NormalizedRoot);
+
+	/* Indexes contents of a folder which appeared as a whole, e.g. moved in. */
+	void AddFolderContents(const FString& NormalizedRoot, const FString& FolderPath);
+
+	void StartCompaction(const TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>& Index);
+	void StartRebuild(const FString& NormalizedRoot);
+
+	FRWLock RootsLock;
+	TMap<FString, TSharedPtr<FFileConvertersRootIndex, ESPMode::ThreadSafe>> Roots;
+};
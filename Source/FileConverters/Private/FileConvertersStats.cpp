@@ -0,0 +1,201 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersStats.h"
+#include "FileConverters.h"
+
+// UE Includes.
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_STAT(STAT_FileConverters_TransformSnapshot);
+DEFINE_STAT(STAT_FileConverters_ExportBuild);
+DEFINE_STAT(STAT_FileConverters_MeshOptimize);
+DEFINE_STAT(STAT_FileConverters_FileWrite);
+DEFINE_STAT(STAT_FileConverters_DirectoryWalk);
+DEFINE_STAT(STAT_FileConverters_Match);
+DEFINE_STAT(STAT_FileConverters_IndexQuery);
+DEFINE_STAT(STAT_FileConverters_Base64Encode);
+DEFINE_STAT(STAT_FileConverters_TemplateSplice);
+DEFINE_STAT(STAT_FileConverters_IFCScan);
+
+namespace FileConvertersStats
+{
+    static const TCHAR* PhaseNames[] = { TEXT("TransformSnapshot"), TEXT("ExportBuild"), TEXT("MeshOptimize"), TEXT("FileWrite"), TEXT("DirectoryWalk"), TEXT("Match"), TEXT("IndexQuery"), TEXT("Base64Encode"), TEXT("TemplateSplice"), TEXT("IFCScan") };
+    static_assert(UE_ARRAY_COUNT(PhaseNames) == int32(EFileConvertersPhase::Count), "Every phase needs a name.");
+
+    static FString GetDefaultCSVPath()
+    {
+        return FPaths::ProjectSavedDir() / TEXT("FileConverters/Metrics.csv");
+    }
+
+    static FAutoConsoleCommand MetricsDumpCommand(
+        TEXT("FileConverters.Metrics.Dump"),
+        TEXT("Appends phase metrics to a CSV file. Optional argument is file path, default is Saved/FileConverters/Metrics.csv."),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+            {
+                const FString FilePath = Args.Num() > 0 ? Args[0] : GetDefaultCSVPath();
+
+                FString ErrorCode;
+                FFileConvertersMetrics::Get().AppendCSV(FilePath, ErrorCode);
+                UE_LOG(LogFileConverters, Display, TEXT("Metrics dump to %s: %s"), *FilePath, *ErrorCode);
+            }
+        )
+    );
+
+    static FAutoConsoleCommand MetricsResetCommand(
+        TEXT("FileConverters.Metrics.Reset"),
+        TEXT("Clears counts and duration samples of all phases."),
+        FConsoleCommandDelegate::CreateLambda([]()
+            {
+                FFileConvertersMetrics::Get().Reset();
+            }
+        )
+    );
+}
+
+FFileConvertersMetrics& FFileConvertersMetrics::Get()
+{
+    static FFileConvertersMetrics Metrics;
+    return Metrics;
+}
+
+void FFileConvertersMetrics::Record(EFileConvertersPhase Phase, double Seconds, int64 Bytes, int64 Items)
+{
+    FScopeLock Lock(&Guard);
+
+    FPhase& Entry = Phases[int32(Phase)];
+    Entry.Count++;
+    Entry.Bytes += Bytes;
+    Entry.Items += Items;
+    Entry.TotalSeconds += Seconds;
+    Entry.MaxSeconds = FMath::Max(Entry.MaxSeconds, Seconds);
+
+    if (Entry.Samples.Num() < SampleCount)
+    {
+        Entry.Samples.Add(float(Seconds));
+    }
+
+    else
+    {
+        Entry.Samples[Entry.NextSample] = float(Seconds);
+        Entry.NextSample = (Entry.NextSample + 1) % SampleCount;
+    }
+}
+
+void FFileConvertersMetrics::RecordCycles(EFileConvertersPhase Phase, TConstArrayView<FFileConvertersWorkerCycles> WorkerCycles)
+{
+    uint64 TotalCycles = 0;
+    int64 TotalItems = 0;
+
+    for (const FFileConvertersWorkerCycles& EachWorker : WorkerCycles)
+    {
+        TotalCycles += EachWorker.Cycles;
+        TotalItems += EachWorker.Items;
+    }
+
+    Record(Phase, FPlatformTime::ToSeconds64(TotalCycles), 0, TotalItems);
+}
+
+void FFileConvertersMetrics::GetMetrics(TArray<FPluginPhaseMetrics>& OutMetrics)
+{
+    OutMetrics.Reset(int32(EFileConvertersPhase::Count));
+
+    TArray<float> Array_Sorted;
+
+    FScopeLock Lock(&Guard);
+
+    for (int32 PhaseIndex = 0; PhaseIndex < int32(EFileConvertersPhase::Count); PhaseIndex++)
+    {
+        const FPhase& Entry = Phases[PhaseIndex];
+
+        FPluginPhaseMetrics& EachMetrics = OutMetrics.AddDefaulted_GetRef();
+        EachMetrics.Phase = FileConvertersStats::PhaseNames[PhaseIndex];
+        EachMetrics.Count = Entry.Count;
+        EachMetrics.Bytes = Entry.Bytes;
+        EachMetrics.Items = Entry.Items;
+        EachMetrics.TotalMs = float(Entry.TotalSeconds * 1000.0);
+        EachMetrics.MeanMs = Entry.Count > 0 ? float(Entry.TotalSeconds * 1000.0 / Entry.Count) : 0.0f;
+        EachMetrics.MaxMs = float(Entry.MaxSeconds * 1000.0);
+
+        if (Entry.Samples.Num() > 0)
+        {
+            Array_Sorted = Entry.Samples;
+            Array_Sorted.Sort();
+
+            // Nearest rank.
+            EachMetrics.P50Ms = Array_Sorted[(Array_Sorted.Num() - 1) * 50 / 100] * 1000.0f;
+            EachMetrics.P99Ms = Array_Sorted[(Array_Sorted.Num() - 1) * 99 / 100] * 1000.0f;
+        }
+    }
+}
+
+void FFileConvertersMetrics::GetJsonValues(TArray<TSharedPtr<FJsonValue>>& OutValues)
+{
+    TArray<FPluginPhaseMetrics> Array_Metrics;
+    GetMetrics(Array_Metrics);
+
+    OutValues.Reset(Array_Metrics.Num());
+
+    for (const FPluginPhaseMetrics& EachMetrics : Array_Metrics)
+    {
+        const TSharedRef<FJsonObject> MetricObject = MakeShared<FJsonObject>();
+        MetricObject->SetStringField(TEXT("phase"), EachMetrics.Phase);
+        MetricObject->SetNumberField(TEXT("count"), double(EachMetrics.Count));
+        MetricObject->SetNumberField(TEXT("bytes"), double(EachMetrics.Bytes));
+        MetricObject->SetNumberField(TEXT("items"), double(EachMetrics.Items));
+        MetricObject->SetNumberField(TEXT("totalMs"), EachMetrics.TotalMs);
+        MetricObject->SetNumberField(TEXT("meanMs"), EachMetrics.MeanMs);
+        MetricObject->SetNumberField(TEXT("p50Ms"), EachMetrics.P50Ms);
+        MetricObject->SetNumberField(TEXT("p99Ms"), EachMetrics.P99Ms);
+        MetricObject->SetNumberField(TEXT("maxMs"), EachMetrics.MaxMs);
+
+        OutValues.Add(MakeShared<FJsonValueObject>(MetricObject));
+    }
+}
+
+void FFileConvertersMetrics::Reset()
+{
+    FScopeLock Lock(&Guard);
+
+    for (FPhase& EachPhase : Phases)
+    {
+        EachPhase = FPhase();
+    }
+}
+
+bool FFileConvertersMetrics::AppendCSV(const FString& FilePath, FString& ErrorCode)
+{
+    TArray<FPluginPhaseMetrics> Array_Metrics;
+    GetMetrics(Array_Metrics);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+    FString CSV;
+
+    if (PlatformFile.FileExists(*FilePath) == false)
+    {
+        CSV += TEXT("Timestamp,Phase,Count,Bytes,Items,TotalMs,MeanMs,P50Ms,P99Ms,MaxMs\n");
+    }
+
+    // One timestamp for all rows, so a dump can be grouped by it.
+    const FString Timestamp = FDateTime::UtcNow().ToIso8601();
+
+    for (const FPluginPhaseMetrics& EachMetrics : Array_Metrics)
+    {
+        CSV += FString::Printf(TEXT("%s,%s,%lld,%lld,%lld,%.3f,%.3f,%.3f,%.3f,%.3f\n"), *Timestamp, *EachMetrics.Phase, EachMetrics.Count, EachMetrics.Bytes, EachMetrics.Items, EachMetrics.TotalMs, EachMetrics.MeanMs, EachMetrics.P50Ms, EachMetrics.P99Ms, EachMetrics.MaxMs);
+    }
+
+    if (FFileHelper::SaveStringToFile(CSV, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append) == false)
+    {
+        ErrorCode = "Metrics file can't be written.";
+        return false;
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
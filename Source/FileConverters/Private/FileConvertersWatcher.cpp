@@ -0,0 +1,244 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersWatcher.h"
+#include "FileConverters.h"
+
+// UE Includes.
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
+
+FFileConvertersWatcher& FFileConvertersWatcher::Get()
+{
+    static FFileConvertersWatcher Watcher;
+    return Watcher;
+}
+
+bool FFileConvertersWatcher::IsAvailable()
+{
+    return Get().GetDirectoryWatcher() != nullptr;
+}
+
+FString FFileConvertersWatcher::NormalizePath(const FString& InPath)
+{
+    FString NormalizedPath = FPaths::ConvertRelativePathToFull(InPath);
+    FPaths::NormalizeDirectoryName(NormalizedPath);
+
+    return NormalizedPath;
+}
+
+IDirectoryWatcher* FFileConvertersWatcher::GetDirectoryWatcher() const
+{
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+    FDirectoryWatcherModule* WatcherModule = FModuleManager::LoadModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+    return WatcherModule ? WatcherModule->Get() : nullptr;
+#else
+    return nullptr;
+#endif
+}
+
+bool FFileConvertersWatcher::WatchFolder(const FString& InPath, FString& ErrorCode)
+{
+    check(IsInGameThread());
+
+    const FString NormalizedPath = NormalizePath(InPath);
+
+    if (FWatch* ExistingWatch = Watches.Find(NormalizedPath))
+    {
+        ExistingWatch->RefCount++;
+        ErrorCode = "Success";
+        return true;
+    }
+
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+    IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher();
+
+    if (DirectoryWatcher == nullptr)
+    {
+        ErrorCode = "Directory watcher isn't available.";
+        return false;
+    }
+
+    FWatch NewWatch;
+    const bool bIsRegistered = DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(NormalizedPath, IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FFileConvertersWatcher::HandleChanges, NormalizedPath), NewWatch.WatcherHandle, IDirectoryWatcher::WatchOptions::IncludeDirectoryChanges);
+
+    if (bIsRegistered == false)
+    {
+        ErrorCode = "Folder couldn't be watched.";
+        return false;
+    }
+
+    NewWatch.RefCount = 1;
+    Watches.Add(NormalizedPath, NewWatch);
+    OnWatchChanged.Broadcast(NormalizedPath, true);
+
+    // Editor ticks directory watcher itself. Games don't, so we do.
+    if (GIsEditor == false && TickerHandle.IsValid() == false)
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FFileConvertersWatcher::Tick));
+    }
+
+    ErrorCode = "Success";
+    return true;
+#else
+    ErrorCode = "Directory watcher isn't available in this build.";
+    return false;
+#endif
+}
+
+void FFileConvertersWatcher::UnwatchFolder(const FString& InPath)
+{
+    check(IsInGameThread());
+
+    const FString NormalizedPath = NormalizePath(InPath);
+    FWatch* ExistingWatch = Watches.Find(NormalizedPath);
+
+    if (ExistingWatch == nullptr || --ExistingWatch->RefCount > 0)
+    {
+        return;
+    }
+
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+    if (IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher())
+    {
+        DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(NormalizedPath, ExistingWatch->WatcherHandle);
+    }
+#endif
+
+    Watches.Remove(NormalizedPath);
+    OnWatchChanged.Broadcast(NormalizedPath, false);
+
+    if (Watches.IsEmpty() == true && TickerHandle.IsValid() == true)
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+}
+
+int32 FFileConvertersWatcher::Subscribe(FDelegateFolderChanges DelegateChanges, const FString& InPath, FString& ErrorCode)
+{
+    if (WatchFolder(InPath, ErrorCode) == false)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 WatchHandle = NextHandle++;
+    Subscribers.Add(WatchHandle, { NormalizePath(InPath), DelegateChanges });
+
+    return WatchHandle;
+}
+
+void FFileConvertersWatcher::Unsubscribe(int32 WatchHandle)
+{
+    FSubscriber Subscriber;
+    if (Subscribers.RemoveAndCopyValue(WatchHandle, Subscriber) == true)
+    {
+        UnwatchFolder(Subscriber.Path);
+    }
+}
+
+void FFileConvertersWatcher::Shutdown()
+{
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+    if (IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher())
+    {
+        for (const TPair<FString, FWatch>& EachWatch : Watches)
+        {
+            DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(EachWatch.Key, EachWatch.Value.WatcherHandle);
+        }
+    }
+#endif
+
+    if (TickerHandle.IsValid() == true)
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    // Listeners which trust watched folders have to know that no more changes will come.
+    for (const TPair<FString, FWatch>& EachWatch : Watches)
+    {
+        OnWatchChanged.Broadcast(EachWatch.Key, false);
+    }
+
+    Watches.Empty();
+    Subscribers.Empty();
+    OnFolderChanges.Clear();
+    OnWatchChanged.Clear();
+}
+
+bool FFileConvertersWatcher::Tick(float DeltaTime)
+{
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+    if (IDirectoryWatcher* DirectoryWatcher = GetDirectoryWatcher())
+    {
+        DirectoryWatcher->Tick(DeltaTime);
+    }
+#endif
+
+    return true;
+}
+
+void FFileConvertersWatcher::HandleChanges(const TArray<FFileChangeData>& FileChanges, FString WatchedPath)
+{
+#if WITH_FILECONVERTERS_DIRECTORY_WATCHER
+    TArray<FFolderChange> Array_Changes;
+    Array_Changes.Reserve(FileChanges.Num());
+
+    for (const FFileChangeData& EachFileChange : FileChanges)
+    {
+        FFolderChange& EachChange = Array_Changes.AddDefaulted_GetRef();
+        EachChange.Path = EachFileChange.Filename;
+        FPaths::NormalizeFilename(EachChange.Path);
+
+        switch (EachFileChange.Action)
+        {
+            case FFileChangeData::FCA_Added:
+                EachChange.ChangeType = EFolderChangeType::Added;
+                break;
+
+            case FFileChangeData::FCA_Modified:
+                EachChange.ChangeType = EFolderChangeType::Modified;
+                break;
+
+            case FFileChangeData::FCA_Removed:
+                EachChange.ChangeType = EFolderChangeType::Removed;
+                break;
+
+            default:
+                EachChange.ChangeType = EFolderChangeType::RescanRequired;
+                break;
+        }
+
+        // Removed entries can't be asked anymore. Listeners look them up by path.
+        if (EachChange.ChangeType == EFolderChangeType::Added || EachChange.ChangeType == EFolderChangeType::Modified)
+        {
+            EachChange.bIsFile = FPaths::DirectoryExists(EachChange.Path) == false;
+        }
+    }
+
+    OnFolderChanges.Broadcast(WatchedPath, Array_Changes);
+
+    FFolderChangeContainer ChangeContainer;
+    ChangeContainer.Changes = MoveTemp(Array_Changes);
+
+    // Copy, a subscriber may unsubscribe while it is notified.
+    TArray<FDelegateFolderChanges> Array_Delegates;
+    for (const TPair<int32, FSubscriber>& EachSubscriber : Subscribers)
+    {
+        if (EachSubscriber.Value.Path.Equals(WatchedPath, ESearchCase::IgnoreCase) == true)
+        {
+            Array_Delegates.Add(EachSubscriber.Value.Delegate);
+        }
+    }
+
+    for (const FDelegateFolderChanges& EachDelegate : Array_Delegates)
+    {
+        EachDelegate.ExecuteIfBound(WatchedPath, ChangeContainer);
+    }
+#endif
+}
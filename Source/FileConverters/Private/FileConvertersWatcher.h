@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "Containers/Ticker.h"
+
+class IDirectoryWatcher;
+struct FFileChangeData;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnFolderChanges, const FString& /* WatchedPath */, const TArray<FFolderChange>& /* Changes */);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWatchChanged, const FString& /* WatchedPath */, bool /* bIsWatched */);
+
+/*
+*	Folder change notifications on top of engine's directory watcher (ReadDirectoryChangesW on Windows, inotify on Linux).
+*	Watches are reference counted per folder. Native listeners (search index, listing caches) run before Blueprint subscribers.
+*	Everything here is game thread only.
+*/
+class FFileConvertersWatcher
+{
+public:
+
+	static FFileConvertersWatcher& Get();
+
+	/* Directory watcher is a developer module. Builds without developer tools can't watch. */
+	static bool IsAvailable();
+
+	static FString NormalizePath(const FString& InPath);
+
+	bool WatchFolder(const FString& InPath, FString& ErrorCode);
+	void UnwatchFolder(const FString& InPath);
+
+	/* Returns watch handle, or INDEX_NONE if folder can't be watched. */
+	int32 Subscribe(FDelegateFolderChanges DelegateChanges, const FString& InPath, FString& ErrorCode);
+	void Unsubscribe(int32 WatchHandle);
+
+	/* Called by module shutdown. Directory watcher may be gone after that. */
+	void Shutdown();
+
+	FOnFolderChanges OnFolderChanges;
+
+	/* Fired when first reference of a folder registers its watch and when last one removes it. Engine watches are recursive, so sub folders are covered too. */
+	FOnWatchChanged OnWatchChanged;
+
+private:
+
+	struct FWatch
+	{
+		FDelegateHandle WatcherHandle;
+		int32 RefCount = 0;
+	};
+
+	struct FSubscriber
+	{
+		FString Path;
+		FDelegateFolderChanges Delegate;
+	};
+
+	IDirectoryWatcher* GetDirectoryWatcher() const;
+	void HandleChanges(const TArray<FFileChangeData>& FileChanges, FString WatchedPath);
+	bool Tick(float DeltaTime);
+
+	TMap<FString, FWatch> Watches;
+	TMap<int32, FSubscriber> Subscribers;
+	int32 NextHandle = 1;
+	FTSTicker::FDelegateHandle TickerHandle;
+};
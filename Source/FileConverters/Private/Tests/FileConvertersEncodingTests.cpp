@@ -0,0 +1,326 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersMeshopt.h"
+#include "FileConvertersPDF.h"
+
+// UE Includes.
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Base64.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FileConvertersEncodingTests
+{
+    // Same block size as encoder, taken from EXT_meshopt_compression.
+    static int32 GetVertexBlockSize(int32 Stride)
+    {
+        return FMath::Min((8192 / Stride) & ~15, 256);
+    }
+
+    static uint8 UnZigZag8(uint8 Value)
+    {
+        return uint8((Value >> 1) ^ uint8(0 - (Value & 1)));
+    }
+
+    // Reference decoder of vertex codec version 0, written from the extension spec rather than from encoder.
+    static bool DecodeVertexBuffer(const TArray<uint8>& Encoded, int32 VertexCount, int32 Stride, TArray<uint8>& OutData)
+    {
+        const int32 TailSize = FMath::Max(Stride, 32);
+
+        if (Encoded.Num() < 1 + TailSize || Encoded[0] != 0xA0)
+        {
+            return false;
+        }
+
+        const uint8* Cursor = Encoded.GetData() + 1;
+        const uint8* TailBegin = Encoded.GetData() + Encoded.Num() - TailSize;
+
+        uint8 Last[256];
+        FMemory::Memcpy(Last, Encoded.GetData() + Encoded.Num() - Stride, Stride);
+
+        OutData.SetNumZeroed(VertexCount * Stride);
+
+        const int32 BlockSize = GetVertexBlockSize(Stride);
+        uint8 Buffer[256];
+
+        for (int32 BlockStart = 0; BlockStart < VertexCount; BlockStart += BlockSize)
+        {
+            const int32 BlockCount = FMath::Min(BlockSize, VertexCount - BlockStart);
+            const int32 GroupCount = Align(BlockCount, 16) / 16;
+
+            for (int32 ByteIndex = 0; ByteIndex < Stride; ByteIndex++)
+            {
+                if (TailBegin - Cursor < (GroupCount + 3) / 4)
+                {
+                    return false;
+                }
+
+                const uint8* Header = Cursor;
+                Cursor += (GroupCount + 3) / 4;
+
+                for (int32 GroupIndex = 0; GroupIndex < GroupCount; GroupIndex++)
+                {
+                    const int32 Mode = (Header[GroupIndex / 4] >> ((GroupIndex % 4) * 2)) & 3;
+                    uint8* Group = Buffer + GroupIndex * 16;
+
+                    if (Mode == 0)
+                    {
+                        FMemory::Memzero(Group, 16);
+                    }
+
+                    else if (Mode == 3)
+                    {
+                        if (TailBegin - Cursor < 16)
+                        {
+                            return false;
+                        }
+
+                        FMemory::Memcpy(Group, Cursor, 16);
+                        Cursor += 16;
+                    }
+
+                    else
+                    {
+                        const int32 Bits = 1 << Mode;
+                        const int32 ValuesPerByte = 8 / Bits;
+                        const uint8 Sentinel = uint8((1 << Bits) - 1);
+
+                        if (TailBegin - Cursor < 16 / ValuesPerByte)
+                        {
+                            return false;
+                        }
+
+                        // First value of a byte is in its high bits.
+                        for (int32 Index = 0; Index < 16; Index++)
+                        {
+                            const int32 Shift = 8 - Bits * (Index % ValuesPerByte + 1);
+                            Group[Index] = uint8((Cursor[Index / ValuesPerByte] >> Shift) & Sentinel);
+                        }
+
+                        Cursor += 16 / ValuesPerByte;
+
+                        for (int32 Index = 0; Index < 16; Index++)
+                        {
+                            if (Group[Index] == Sentinel)
+                            {
+                                if (Cursor >= TailBegin)
+                                {
+                                    return false;
+                                }
+
+                                Group[Index] = *Cursor++;
+                            }
+                        }
+                    }
+                }
+
+                for (int32 VertexIndex = 0; VertexIndex < BlockCount; VertexIndex++)
+                {
+                    Last[ByteIndex] = uint8(Last[ByteIndex] + UnZigZag8(Buffer[VertexIndex]));
+                    OutData[(BlockStart + VertexIndex) * Stride + ByteIndex] = Last[ByteIndex];
+                }
+            }
+        }
+
+        return Cursor == TailBegin;
+    }
+
+    // Reference decoder of index sequence codec version 1.
+    static bool DecodeIndexSequence(const TArray<uint8>& Encoded, int32 IndexCount, TArray<uint32>& OutIndices)
+    {
+        if (Encoded.Num() < 5 || Encoded[0] != 0xD1)
+        {
+            return false;
+        }
+
+        const uint8* Cursor = Encoded.GetData() + 1;
+        const uint8* End = Encoded.GetData() + Encoded.Num() - 4;
+        uint32 Last[2] = { 0, 0 };
+
+        OutIndices.Reset(IndexCount);
+
+        for (int32 Index = 0; Index < IndexCount; Index++)
+        {
+            uint32 Value = 0;
+
+            for (int32 Shift = 0; ; Shift += 7)
+            {
+                if (Cursor >= End || Shift > 28)
+                {
+                    return false;
+                }
+
+                const uint8 Byte = *Cursor++;
+                Value |= uint32(Byte & 127) << Shift;
+
+                if ((Byte & 128) == 0)
+                {
+                    break;
+                }
+            }
+
+            const uint32 Current = Value & 1;
+            const uint32 ZigZag = Value >> 1;
+            const uint32 Delta = (ZigZag >> 1) ^ (0u - (ZigZag & 1));
+
+            Last[Current] += Delta;
+            OutIndices.Add(Last[Current]);
+        }
+
+        return Cursor == End && Encoded[Encoded.Num() - 4] == 0 && Encoded[Encoded.Num() - 1] == 0;
+    }
+
+    // Mix of constant, slowly changing and random bytes, so every group width of the codec is used.
+    static void MakeVertices(int32 VertexCount, int32 Stride, TArray<uint8>& OutData)
+    {
+        FRandomStream Random(VertexCount * 31 + Stride);
+        OutData.SetNumUninitialized(VertexCount * Stride);
+
+        for (int32 VertexIndex = 0; VertexIndex < VertexCount; VertexIndex++)
+        {
+            for (int32 ByteIndex = 0; ByteIndex < Stride; ByteIndex++)
+            {
+                uint8 Value = 0;
+
+                switch (ByteIndex % 4)
+                {
+                    case 0: Value = uint8(VertexIndex); break;
+                    case 1: Value = uint8(VertexIndex / 3 + Random.RandRange(0, 2)); break;
+                    case 2: Value = uint8(Random.RandRange(0, 255)); break;
+                    default: Value = 0x3F; break;
+                }
+
+                OutData[VertexIndex * Stride + ByteIndex] = Value;
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersBase64Test, "FileConverters.Encoding.Base64", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersBase64Test::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(1234);
+
+    // Tails of 0, 1 and 2 bytes after the 12 byte loop and the 3 byte loop, and one file read chunk plus a tail.
+    const int64 Array_Sizes[] = { 0, 1, 2, 3, 4, 5, 11, 12, 13, 14, 15, 16, 100, FFileConvertersPDF::ChunkSize + 1 };
+
+    for (const int64 EachSize : Array_Sizes)
+    {
+        TArray<uint8> Array_Source;
+        Array_Source.SetNumUninitialized(int32(EachSize));
+
+        for (uint8& EachByte : Array_Source)
+        {
+            EachByte = uint8(Random.RandRange(0, 255));
+        }
+
+        const int64 EncodedLength = FFileConvertersPDF::GetEncodedLength(EachSize);
+        const FString Expected = FBase64::Encode(Array_Source);
+
+        if (TestEqual(FString::Printf(TEXT("Encoded length of %lld bytes"), EachSize), EncodedLength, int64(Expected.Len())) == false)
+        {
+            continue;
+        }
+
+        FString Wide;
+        Wide.GetCharArray().SetNumUninitialized(int32(EncodedLength) + 1);
+        FFileConvertersPDF::EncodeBase64(Array_Source.GetData(), EachSize, Wide.GetCharArray().GetData());
+        Wide.GetCharArray()[int32(EncodedLength)] = TEXT('\0');
+
+        TArray<ANSICHAR> Array_Narrow;
+        Array_Narrow.SetNumUninitialized(int32(EncodedLength) + 1);
+        FFileConvertersPDF::EncodeBase64(Array_Source.GetData(), EachSize, Array_Narrow.GetData());
+        Array_Narrow[int32(EncodedLength)] = '\0';
+
+        TestEqual(FString::Printf(TEXT("Wide Base64 of %lld bytes"), EachSize), Wide, Expected);
+        TestEqual(FString::Printf(TEXT("ANSI Base64 of %lld bytes"), EachSize), FString(ANSI_TO_TCHAR(Array_Narrow.GetData())), Expected);
+
+        TArray<uint8> Array_Decoded;
+        if (EachSize > 0 && TestTrue(FString::Printf(TEXT("Base64 of %lld bytes decodes"), EachSize), FBase64::Decode(Wide, Array_Decoded)) == true)
+        {
+            TestTrue(FString::Printf(TEXT("Base64 of %lld bytes round trips"), EachSize), Array_Decoded == Array_Source);
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMeshoptVertexTest, "FileConverters.Encoding.MeshoptVertices", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMeshoptVertexTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersEncodingTests;
+
+    // Strides with and without tail padding, counts inside one block, on block size and across blocks.
+    const int32 Array_Strides[] = { 4, 12, 16, 32, 64 };
+    const int32 Array_Counts[] = { 0, 1, 15, 16, 17, 256, 257, 1000 };
+
+    for (const int32 EachStride : Array_Strides)
+    {
+        for (const int32 EachCount : Array_Counts)
+        {
+            TArray<uint8> Array_Vertices;
+            MakeVertices(EachCount, EachStride, Array_Vertices);
+
+            TArray<uint8> Array_Encoded;
+            FFileConvertersMeshopt::EncodeVertexBuffer(Array_Vertices.GetData(), EachCount, EachStride, Array_Encoded);
+
+            TArray<uint8> Array_Decoded;
+            const FString What = FString::Printf(TEXT("%d vertices of stride %d"), EachCount, EachStride);
+
+            if (TestTrue(What + TEXT(" decode"), DecodeVertexBuffer(Array_Encoded, EachCount, EachStride, Array_Decoded)) == true)
+            {
+                TestTrue(What + TEXT(" round trip"), Array_Decoded == Array_Vertices);
+            }
+        }
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMeshoptIndexTest, "FileConverters.Encoding.MeshoptIndices", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMeshoptIndexTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersEncodingTests;
+
+    FRandomStream Random(4321);
+    TArray<TArray<uint32>> Array_Cases;
+
+    // Empty, a strip like grid, random jumps which switch baseline, and deltas which need four and five vbyte bytes.
+    Array_Cases.AddDefaulted();
+
+    TArray<uint32>& Grid = Array_Cases.AddDefaulted_GetRef();
+    for (uint32 Quad = 0; Quad < 500; Quad++)
+    {
+        Grid.Append({ Quad, Quad + 1, Quad + 501, Quad + 1, Quad + 502, Quad + 501 });
+    }
+
+    TArray<uint32>& Jumps = Array_Cases.AddDefaulted_GetRef();
+    for (int32 Index = 0; Index < 3000; Index++)
+    {
+        Jumps.Add(uint32(Random.RandRange(0, 100000)));
+    }
+
+    Array_Cases.Add({ 0, 1u << 28, 7, (1u << 28) + 5, 1u << 22, 3 });
+
+    for (const TArray<uint32>& EachCase : Array_Cases)
+    {
+        TArray<uint8> Array_Encoded;
+        FFileConvertersMeshopt::EncodeIndexSequence(EachCase.GetData(), EachCase.Num(), Array_Encoded);
+
+        TArray<uint32> Array_Decoded;
+        const FString What = FString::Printf(TEXT("%d indices"), EachCase.Num());
+
+        if (TestTrue(What + TEXT(" decode"), DecodeIndexSequence(Array_Encoded, EachCase.Num(), Array_Decoded)) == true)
+        {
+            TestTrue(What + TEXT(" round trip"), Array_Decoded == EachCase);
+        }
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,191 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersGLTF.h"
+
+// UE Includes.
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FileConvertersGLBWriterTests
+{
+    // One triangle: 3 float positions in view 0, 3 uint32 indices in view 1. NODE_NAME and NODE_X are replaced per part.
+    static const TCHAR* PartJsonTemplate = TEXT(R"({
+        "asset": { "version": "2.0" },
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0 ] } ],
+        "nodes": [ { "name": "NODE_NAME", "mesh": 0, "translation": [ NODE_X, 0, 0 ] } ],
+        "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 }, "indices": 1, "mode": 4 } ] } ],
+        "accessors": [
+            { "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3" },
+            { "bufferView": 1, "componentType": 5125, "count": 3, "type": "SCALAR" }
+        ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": 36, "target": 34962 },
+            { "buffer": 0, "byteOffset": 36, "byteLength": 12, "target": 34963 }
+        ],
+        "buffers": [ { "byteLength": 48 } ]
+    })");
+
+    static void MakeTriangle(TArray<uint8>& OutBinary)
+    {
+        const float Positions[] = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+        const uint32 Indices[] = { 0, 1, 2 };
+
+        OutBinary.Reset();
+        OutBinary.Append(reinterpret_cast<const uint8*>(Positions), sizeof(Positions));
+        OutBinary.Append(reinterpret_cast<const uint8*>(Indices), sizeof(Indices));
+    }
+
+    static bool WritePart(const FString& PartPath, const TCHAR* NodeName, int32 TranslationX, FString& ErrorCode)
+    {
+        const FString PartJson = FString(PartJsonTemplate).Replace(TEXT("NODE_NAME"), NodeName).Replace(TEXT("NODE_X"), *FString::FromInt(TranslationX));
+
+        TSharedPtr<FJsonObject> Json;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PartJson);
+
+        if (FJsonSerializer::Deserialize(Reader, Json) == false || Json.IsValid() == false)
+        {
+            ErrorCode = "Part JSON can't be parsed.";
+            return false;
+        }
+
+        TArray<uint8> Array_Binary;
+        MakeTriangle(Array_Binary);
+
+        return FFileConvertersGLTF::SaveFile(PartPath, Json.ToSharedRef(), Array_Binary, ErrorCode);
+    }
+
+    static int32 GetArrayNum(const TSharedPtr<FJsonObject>& Json, const TCHAR* Name)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Array_Values = nullptr;
+        return Json->TryGetArrayField(Name, Array_Values) == true ? Array_Values->Num() : 0;
+    }
+
+    // Bytes of a merged buffer view, read from binary chunk of merged file.
+    static TArray<uint8> GetViewBytes(const TSharedPtr<FJsonObject>& Json, const TArray<uint8>& Binary, int32 ViewIndex)
+    {
+        const TSharedPtr<FJsonObject> View = Json->GetArrayField(TEXT("bufferViews"))[ViewIndex]->AsObject();
+        const int32 ByteOffset = int32(View->GetNumberField(TEXT("byteOffset")));
+        const int32 ByteLength = int32(View->GetNumberField(TEXT("byteLength")));
+
+        return Binary.IsValidIndex(ByteOffset + ByteLength - 1) ? TArray<uint8>(Binary.GetData() + ByteOffset, ByteLength) : TArray<uint8>();
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersGLBWriterMergeTest, "FileConverters.GLBWriter.Merge", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersGLBWriterMergeTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersGLBWriterTests;
+
+    const FString TestDir = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FileConverters"), TEXT("GLBWriter"));
+    const FString PartPathA = FPaths::Combine(TestDir, TEXT("PartA.glb"));
+    const FString PartPathB = FPaths::Combine(TestDir, TEXT("PartB.glb"));
+    IFileManager::Get().MakeDirectory(*TestDir, true);
+
+    FString ErrorCode;
+    if (TestTrue(TEXT("Parts are written"), WritePart(PartPathA, TEXT("A"), 1, ErrorCode) && WritePart(PartPathB, TEXT("B"), 5, ErrorCode)) == false)
+    {
+        AddError(ErrorCode);
+        return false;
+    }
+
+    TArray<uint8> Array_Triangle;
+    MakeTriangle(Array_Triangle);
+    const TArray<uint8> Array_Positions(Array_Triangle.GetData(), 36);
+    const TArray<uint8> Array_Indices(Array_Triangle.GetData() + 36, 12);
+
+    // Plain merge: every part keeps its own objects, indices of second part are shifted.
+    {
+        const FString OutputPath = FPaths::Combine(TestDir, TEXT("Plain.glb"));
+        FFileConvertersGLBWriter Writer(OutputPath);
+
+        TestTrue(TEXT("Plain merge appends first part"), Writer.AppendPart(PartPathA, ErrorCode));
+        TestTrue(TEXT("Plain merge appends second part"), Writer.AppendPart(PartPathB, ErrorCode));
+        TestTrue(TEXT("Plain merge finishes"), Writer.Finish(ErrorCode));
+
+        TSharedPtr<FJsonObject> Json;
+        TArray<uint8> Array_Binary;
+
+        if (TestTrue(TEXT("Plain merge output loads"), FFileConvertersGLTF::LoadFile(OutputPath, Json, Array_Binary, ErrorCode)) == true)
+        {
+            TestEqual(TEXT("Plain merge nodes"), GetArrayNum(Json, TEXT("nodes")), 2);
+            TestEqual(TEXT("Plain merge meshes"), GetArrayNum(Json, TEXT("meshes")), 2);
+            TestEqual(TEXT("Plain merge accessors"), GetArrayNum(Json, TEXT("accessors")), 4);
+            TestEqual(TEXT("Plain merge buffer views"), GetArrayNum(Json, TEXT("bufferViews")), 4);
+            TestEqual(TEXT("Plain merge scene roots"), GetArrayNum(Json->GetArrayField(TEXT("scenes"))[0]->AsObject(), TEXT("nodes")), 2);
+
+            const TSharedPtr<FJsonObject> SecondNode = Json->GetArrayField(TEXT("nodes"))[1]->AsObject();
+            const TSharedPtr<FJsonObject> SecondPrimitive = Json->GetArrayField(TEXT("meshes"))[1]->AsObject()->GetArrayField(TEXT("primitives"))[0]->AsObject();
+
+            TestEqual(TEXT("Second node points to second mesh"), int32(SecondNode->GetNumberField(TEXT("mesh"))), 1);
+            TestEqual(TEXT("Second mesh positions are remapped"), int32(SecondPrimitive->GetObjectField(TEXT("attributes"))->GetNumberField(TEXT("POSITION"))), 2);
+            TestEqual(TEXT("Second mesh indices are remapped"), int32(SecondPrimitive->GetNumberField(TEXT("indices"))), 3);
+
+            for (int32 ViewIndex = 0; ViewIndex < 4; ViewIndex++)
+            {
+                TestTrue(FString::Printf(TEXT("Plain merge view %d bytes"), ViewIndex), GetViewBytes(Json, Array_Binary, ViewIndex) == (ViewIndex % 2 == 0 ? Array_Positions : Array_Indices));
+            }
+        }
+
+        TestEqual(TEXT("Plain merge source nodes"), Writer.GetStats().SourceNodeCount, 2);
+        TestEqual(TEXT("Plain merge has no instances"), Writer.GetStats().InstanceGroupCount, 0);
+    }
+
+    // Optimized merge: equal views and objects are written once and both nodes become one instanced node.
+    {
+        const FString OutputPath = FPaths::Combine(TestDir, TEXT("Optimized.glb"));
+        FFileConvertersGLBWriter Writer(OutputPath);
+        Writer.SetOptimize(true);
+
+        TestTrue(TEXT("Optimized merge appends first part"), Writer.AppendPart(PartPathA, ErrorCode));
+        TestTrue(TEXT("Optimized merge appends second part"), Writer.AppendPart(PartPathB, ErrorCode));
+        TestTrue(TEXT("Optimized merge finishes"), Writer.Finish(ErrorCode));
+
+        TSharedPtr<FJsonObject> Json;
+        TArray<uint8> Array_Binary;
+
+        if (TestTrue(TEXT("Optimized merge output loads"), FFileConvertersGLTF::LoadFile(OutputPath, Json, Array_Binary, ErrorCode)) == true)
+        {
+            TestEqual(TEXT("Optimized merge meshes"), GetArrayNum(Json, TEXT("meshes")), 1);
+            TestEqual(TEXT("Optimized merge nodes"), GetArrayNum(Json, TEXT("nodes")), 1);
+            TestTrue(TEXT("Shared positions are kept"), GetViewBytes(Json, Array_Binary, 0) == Array_Positions);
+            TestTrue(TEXT("Shared indices are kept"), GetViewBytes(Json, Array_Binary, 1) == Array_Indices);
+
+            // Views after the shared ones hold instance attributes only.
+            TestEqual(TEXT("Optimized merge buffer views"), GetArrayNum(Json, TEXT("bufferViews")), 3);
+
+            const TSharedPtr<FJsonObject> InstancedNode = Json->GetArrayField(TEXT("nodes"))[0]->AsObject();
+            const TSharedPtr<FJsonObject>* Extensions = nullptr;
+            const TSharedPtr<FJsonObject>* Instancing = nullptr;
+
+            if (TestTrue(TEXT("Node is instanced"), InstancedNode->TryGetObjectField(TEXT("extensions"), Extensions) && (*Extensions)->TryGetObjectField(TEXT("EXT_mesh_gpu_instancing"), Instancing)) == true)
+            {
+                const int32 TranslationAccessor = int32((*Instancing)->GetObjectField(TEXT("attributes"))->GetNumberField(TEXT("TRANSLATION")));
+                const int32 TranslationView = int32(Json->GetArrayField(TEXT("accessors"))[TranslationAccessor]->AsObject()->GetNumberField(TEXT("bufferView")));
+                const TArray<uint8> Array_TranslationBytes = GetViewBytes(Json, Array_Binary, TranslationView);
+
+                const float ExpectedTranslations[] = { 1.0f, 0.0f, 0.0f, 5.0f, 0.0f, 0.0f };
+                TestTrue(TEXT("Instance translations"), Array_TranslationBytes == TArray<uint8>(reinterpret_cast<const uint8*>(ExpectedTranslations), sizeof(ExpectedTranslations)));
+            }
+
+            TArray<FString> Array_Required;
+            Json->TryGetStringArrayField(TEXT("extensionsRequired"), Array_Required);
+            TestTrue(TEXT("Instancing is required"), Array_Required.Contains(TEXT("EXT_mesh_gpu_instancing")));
+        }
+
+        TestEqual(TEXT("Optimized merge instance groups"), Writer.GetStats().InstanceGroupCount, 1);
+        TestEqual(TEXT("Optimized merge instanced nodes"), Writer.GetStats().InstancedNodeCount, 2);
+    }
+
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    return true;
+}
+
+#endif
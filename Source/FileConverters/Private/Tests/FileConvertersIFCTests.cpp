@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersIFC.h"
+
+// UE Includes.
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FileConvertersIFCTests
+{
+    static int64 GetTypeCount(const FIFCScanResult& Result, const TCHAR* Type)
+    {
+        const FIFCEntityCount* EntityCount = Result.EntityTypes.FindByPredicate([Type](const FIFCEntityCount& Each) { return Each.Type == Type; });
+        return EntityCount != nullptr ? EntityCount->Count : 0;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersIFCScanChunksTest, "FileConverters.IFC.ScanChunks", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersIFCScanChunksTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersIFCTests;
+
+    const FString TestDir = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FileConverters"), TEXT("IFC"));
+    const FString FilePath = FPaths::Combine(TestDir, TEXT("Chunks.ifc"));
+
+    // DATA section of a few MinChunkSize, so it is split into several chunks.
+    const int64 TargetSize = FFileConvertersIFCScanner::MinChunkSize * 3 + FFileConvertersIFCScanner::MinChunkSize / 2;
+
+    FString Content;
+    Content.Reserve(int32(TargetSize + TargetSize / 8));
+
+    Content += TEXT("ISO-10303-21;\nHEADER;\n");
+    Content += TEXT("FILE_DESCRIPTION(('ViewDefinition [CoordinationView]'),'2;1');\n");
+    Content += TEXT("FILE_NAME('Chunks.ifc','2024-01-01T00:00:00',('Author'),('Office'),'Preprocessor','Chunk Test Writer','');\n");
+    Content += TEXT("FILE_SCHEMA(('IFC4'));\nENDSEC;\nDATA;\n");
+    Content += TEXT("#1=IFCPROJECT('0YvctVUKr0kugbFTf53O9L',$,'Chunk Project',$,$,$,$,$,$);\n");
+
+    int64 PointCount = 0;
+    int64 WallCount = 0;
+    int64 PropertyCount = 0;
+    int32 EntityId = 2;
+
+    // Long multi line strings hold semicolons and lines which start with '#' but aren't records, most nominal chunk offsets land inside them.
+    // Their padding line makes records far longer than the 16 byte steps of the scanner.
+    const FString Padding = FString::ChrN(40000, TEXT('x'));
+
+    while (Content.Len() < TargetSize)
+    {
+        for (int32 PointIndex = 0; PointIndex < 200; PointIndex++)
+        {
+            Content += FString::Printf(TEXT("#%d=IFCCARTESIANPOINT((%d.,%d.,0.));\n"), EntityId, PointIndex, EntityId);
+            EntityId++;
+            PointCount++;
+        }
+
+        Content += FString::Printf(TEXT("#%d= IFCWALL('2O2Fr$t4X7Zf8NOew3FLOH',$,'Wall; %lld',$,$,$,$,$,$);\n"), EntityId, WallCount);
+        EntityId++;
+        WallCount++;
+
+        Content += FString::Printf(TEXT("#%d =IFCPROPERTYSINGLEVALUE('Note',$,IFCTEXT('first line;\n#12 is referenced here;\n#notanid=\n%s\n#\nit''s done;'),$);\n"), EntityId, *Padding);
+        EntityId++;
+        PropertyCount++;
+    }
+
+    Content += TEXT("ENDSEC;\nEND-ISO-10303-21;\n");
+
+    IFileManager::Get().MakeDirectory(*TestDir, true);
+
+    if (TestTrue(TEXT("STEP file is written"), FFileHelper::SaveStringToFile(Content, *FilePath, FFileHelper::EEncodingOptions::ForceAnsi)) == false)
+    {
+        return false;
+    }
+
+    const int64 ExpectedCount = 1 + PointCount + WallCount + PropertyCount;
+    Content.Empty();
+
+    FIFCScanResult Result;
+    FString ErrorCode;
+
+    if (TestTrue(TEXT("STEP file is scanned"), FFileConvertersIFCScanner::Scan(FilePath, Result, ErrorCode)) == true)
+    {
+        TestEqual(TEXT("Schema"), Result.Schema, FString(TEXT("IFC4")));
+        TestEqual(TEXT("File name"), Result.FileName, FString(TEXT("Chunks.ifc")));
+        TestEqual(TEXT("Originating system"), Result.OriginatingSystem, FString(TEXT("Chunk Test Writer")));
+        TestEqual(TEXT("Project name"), Result.ProjectName, FString(TEXT("Chunk Project")));
+
+        // Every record is counted once, whichever chunk it starts in.
+        TestEqual(TEXT("Entity count"), Result.EntityCount, ExpectedCount);
+        TestEqual(TEXT("Point count"), GetTypeCount(Result, TEXT("IFCCARTESIANPOINT")), PointCount);
+        TestEqual(TEXT("Wall count"), GetTypeCount(Result, TEXT("IFCWALL")), WallCount);
+        TestEqual(TEXT("Property count"), GetTypeCount(Result, TEXT("IFCPROPERTYSINGLEVALUE")), PropertyCount);
+        TestEqual(TEXT("Project count"), GetTypeCount(Result, TEXT("IFCPROJECT")), int64(1));
+        TestEqual(TEXT("Type count"), Result.EntityTypes.Num(), 4);
+    }
+
+    IFileManager::Get().DeleteDirectory(*TestDir, false, true);
+    return true;
+}
+
+#endif
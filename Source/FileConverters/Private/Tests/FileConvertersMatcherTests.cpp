@@ -0,0 +1,188 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersMatcher.h"
+
+// UE Includes.
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace FileConvertersMatcherTests
+{
+    struct FCase
+    {
+        const TCHAR* Name;
+        bool bIsDirectory;
+        bool bExpected;
+    };
+
+    static FFileSearchQuery MakeQuery(const TCHAR* Pattern, EFileSearchMode Mode, bool bCaseSensitive = false, TArray<FString> Extensions = TArray<FString>())
+    {
+        FFileSearchQuery Query;
+        Query.Pattern = Pattern;
+        Query.Mode = Mode;
+        Query.bCaseSensitive = bCaseSensitive;
+        Query.Extensions = MoveTemp(Extensions);
+        return Query;
+    }
+
+    static void TestCases(FAutomationTestBase& Test, const FFileSearchQuery& Query, std::initializer_list<FCase> Cases)
+    {
+        const FFileConvertersMatcher Matcher(Query);
+
+        for (const FCase& EachCase : Cases)
+        {
+            int32 Score = 0;
+            const bool bIsMatch = Matcher.Matches(EachCase.Name, EachCase.bIsDirectory, Score);
+            Test.TestTrue(FString::Printf(TEXT("'%s' %s '%s'"), *Query.Pattern, EachCase.bExpected ? TEXT("matches") : TEXT("doesn't match"), EachCase.Name), bIsMatch == EachCase.bExpected);
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMatcherSubstringTest, "FileConverters.Matcher.Substring", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMatcherSubstringTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersMatcherTests;
+
+    // Names longer than 8 characters go through SSE2 prefilter, matches at the very end check the last block.
+    TestCases(*this, MakeQuery(TEXT("wall"), EFileSearchMode::Substring), {
+        { TEXT("Wall.ifc"), false, true },
+        { TEXT("ExteriorWALLs.ifc"), false, true },
+        { TEXT("a_very_long_building_name_with_a_wall"), false, true },
+        { TEXT("a_very_long_building_name_with_a_wal.wall"), false, false },
+        { TEXT("wal"), false, false },
+        { TEXT("Walls"), true, true },
+    });
+
+    TestCases(*this, MakeQuery(TEXT("Wall"), EFileSearchMode::Substring, true), {
+        { TEXT("ExteriorWall.ifc"), false, true },
+        { TEXT("exteriorwall.ifc"), false, false },
+    });
+
+    TestCases(*this, MakeQuery(TEXT("x"), EFileSearchMode::Substring), {
+        { TEXT("aaaaaaaaaaaaaaaaaaaaaaaX"), false, true },
+        { TEXT("aaaaaaaaaaaaaaaaaaaaaaaa.x"), false, false },
+    });
+
+    TestCases(*this, MakeQuery(TEXT(""), EFileSearchMode::Substring), {
+        { TEXT("Anything.txt"), false, true },
+        { TEXT("Folder"), true, true },
+    });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMatcherExactTest, "FileConverters.Matcher.Exact", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMatcherExactTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersMatcherTests;
+
+    TestCases(*this, MakeQuery(TEXT("model"), EFileSearchMode::Exact), {
+        { TEXT("Model.ifc"), false, true },
+        { TEXT("model"), true, true },
+        { TEXT("model.backup.ifc"), false, false },
+        { TEXT("models.ifc"), false, false },
+        { TEXT("mode.ifc"), false, false },
+    });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMatcherGlobTest, "FileConverters.Matcher.Glob", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMatcherGlobTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersMatcherTests;
+
+    TestCases(*this, MakeQuery(TEXT("*.ifc"), EFileSearchMode::Glob), {
+        { TEXT("Model.IFC"), false, true },
+        { TEXT(".ifc"), false, true },
+        { TEXT("Model.ifc.bak"), false, false },
+        { TEXT("Model.ifcx"), false, false },
+    });
+
+    TestCases(*this, MakeQuery(TEXT("level_??_*.umap"), EFileSearchMode::Glob), {
+        { TEXT("Level_01_Main.umap"), false, true },
+        { TEXT("level_01_.umap"), false, true },
+        { TEXT("level_1_Main.umap"), false, false },
+    });
+
+    // Star has to give characters back when a later literal fails.
+    TestCases(*this, MakeQuery(TEXT("*ab*ab"), EFileSearchMode::Glob), {
+        { TEXT("xabyabab"), false, true },
+        { TEXT("abab"), false, true },
+        { TEXT("abxab_"), false, false },
+    });
+
+    TestCases(*this, MakeQuery(TEXT("*"), EFileSearchMode::Glob), {
+        { TEXT("Anything"), false, true },
+    });
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMatcherFuzzyTest, "FileConverters.Matcher.Fuzzy", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMatcherFuzzyTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersMatcherTests;
+
+    const FFileSearchQuery Query = MakeQuery(TEXT("sm"), EFileSearchMode::Fuzzy);
+
+    TestCases(*this, Query, {
+        { TEXT("StaticMesh.uasset"), false, true },
+        { TEXT("Somethingm.uasset"), false, true },
+        { TEXT("MeshStatic.uasset"), false, false },
+        { TEXT("Static.sm"), false, false },
+    });
+
+    // Word starts and runs rank above scattered characters.
+    const FFileConvertersMatcher Matcher(Query);
+    int32 CamelScore = 0;
+    int32 RunScore = 0;
+    int32 ScatteredScore = 0;
+
+    Matcher.Matches(TEXT("StaticMesh"), false, CamelScore);
+    Matcher.Matches(TEXT("sm_Rock"), false, RunScore);
+    Matcher.Matches(TEXT("Somethingm"), false, ScatteredScore);
+
+    TestTrue(TEXT("Camel case boundary ranks above a gap"), CamelScore > ScatteredScore);
+    TestTrue(TEXT("Leading run ranks above a gap"), RunScore > ScatteredScore);
+
+    // Shortest window is scored, so an early stray character doesn't hide a tight match.
+    int32 TightScore = 0;
+    int32 WideScore = 0;
+    Matcher.Matches(TEXT("s_____________sm"), false, TightScore);
+    Matcher.Matches(TEXT("s______________m"), false, WideScore);
+    TestTrue(TEXT("Tight window after stray character ranks above a wide window"), TightScore > WideScore);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFileConvertersMatcherExtensionTest, "FileConverters.Matcher.Extensions", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFileConvertersMatcherExtensionTest::RunTest(const FString& Parameters)
+{
+    using namespace FileConvertersMatcherTests;
+
+    // All three spellings are accepted. Folders never pass an extension filter.
+    TestCases(*this, MakeQuery(TEXT(""), EFileSearchMode::Substring, false, { TEXT("ifc"), TEXT(".glb"), TEXT("*.pdf") }), {
+        { TEXT("Model.IFC"), false, true },
+        { TEXT("Model.glb"), false, true },
+        { TEXT("Manual.pdf"), false, true },
+        { TEXT("Model.gltf"), false, false },
+        { TEXT("ifc"), false, false },
+        { TEXT("Folder.ifc"), true, false },
+    });
+
+    TestCases(*this, MakeQuery(TEXT("model"), EFileSearchMode::Substring, true, { TEXT("ifc") }), {
+        { TEXT("model.ifc"), false, true },
+        { TEXT("model.IFC"), false, false },
+    });
+
+    return true;
+}
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogFileConverters, Log, All);
+
 class FFileConvertersModule : public IModuleInterface
 {
 public:
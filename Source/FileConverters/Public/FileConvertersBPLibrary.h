@@ -41,6 +41,15 @@ public:
 	TArray<FString> Strings;
 };
 
+UENUM(BlueprintType)
+enum class EAdditionalAssetRoot : uint8
+{
+	Content				UMETA(ToolTip = "Project Content folder."),
+	Saved				UMETA(ToolTip = "Project Saved folder."),
+	Project				UMETA(ToolTip = "Project root folder."),
+	Absolute			UMETA(ToolTip = "Path is used as it is."),
+};
+
 USTRUCT(BlueprintType)
 struct FFolderContent
 {
@@ -56,6 +65,60 @@ public:
 
 	UPROPERTY(BlueprintReadOnly)
 	bool bIsFile = false;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 Size = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	FDateTime ModificationTime;
+
+	UPROPERTY(BlueprintReadOnly)
+	FDateTime CreationTime;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Score = 0;
+};
+
+UENUM(BlueprintType)
+enum class EFileSearchMode : uint8
+{
+	Exact				UMETA(ToolTip = "Whole name without extension."),
+	Substring			UMETA(ToolTip = "Name without extension contains pattern."),
+	Glob				UMETA(ToolTip = "* and ? wildcards, matched against name with extension. For example *.ifc"),
+	Fuzzy				UMETA(ToolTip = "Pattern characters in order with gaps allowed. Results are ranked by score, best first."),
+};
+
+USTRUCT(BlueprintType)
+struct FFileSearchQuery
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FString Pattern = "";
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	EFileSearchMode Mode = EFileSearchMode::Substring;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bCaseSensitive = false;
+
+	/* Only files with one of these extensions. "ifc", ".ifc" and "*.ifc" are all accepted. Empty means no filter. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FString> Extensions;
+
+	/* Zero means unlimited. Fuzzy keeps best scores, other modes keep first paths. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int32 MaxResults = 0;
+};
+
+UENUM(BlueprintType)
+enum class EFolderSortMode : uint8
+{
+	NaturalName			UMETA(ToolTip = "Case insensitive, numbers inside names are compared by value."),
+	Size,
+	ModificationTime,
 };
 
 USTRUCT(BlueprintType)
@@ -69,9 +132,552 @@ public:
 	TArray<FFolderContent> OutContents;
 };
 
+UENUM(BlueprintType)
+enum class EFolderChangeType : uint8
+{
+	Added,
+	Modified,
+	Removed,
+	RescanRequired		UMETA(ToolTip = "Watcher lost track of changes. Folder should be listed again."),
+};
+
+USTRUCT(BlueprintType)
+struct FFolderChange
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	FString Path = "";
+
+	UPROPERTY(BlueprintReadOnly)
+	EFolderChangeType ChangeType = EFolderChangeType::Modified;
+
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsFile = true;
+};
+
+USTRUCT(BlueprintType)
+struct FFolderChangeContainer
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FFolderChange> Changes;
+};
+
+USTRUCT(BlueprintType)
+struct FSearchIndexStats
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	FString RootPath = "";
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 EntryCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 TrigramCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PostingCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 MemoryBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float BytesPerEntry = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float BuildSeconds = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float LastQueryMicroseconds = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FListingCacheStats
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 FolderCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 EntryCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 MemoryBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 HitCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 MissCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 InvalidationCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 EvictionCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float HitRate = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FAssetCacheStats
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 EntryCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 UsedBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 BudgetBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 HitCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 MissCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 InvalidationCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 EvictionCount = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FGLBExportStats
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 PartCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 CachedPartCount = 0;
+
+	/* Sum of binary chunks of exported parts. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 SourceBytes = 0;
+
+	/* Size of written GLB. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 OutputBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SourceNodeCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 OutputNodeCount = 0;
+
+	/* Nodes replaced by instanced nodes. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 InstancedNodeCount = 0;
+
+	/* Instanced nodes written. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 InstanceGroupCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SourceMeshCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 OutputMeshCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SourceMaterialCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 OutputMaterialCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SourceImageCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 OutputImageCount = 0;
+
+	/* Primitives whose indices and vertices were reordered for vertex cache and fetch. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 OptimizedPrimitiveCount = 0;
+
+	/* Buffer views written with EXT_meshopt_compression. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 CompressedViewCount = 0;
+
+	/* Export queue only. Time between queueing and start of the job. */
+	UPROPERTY(BlueprintReadOnly)
+	float QueueSeconds = 0;
+
+	/* Export queue only. Game thread time of the job, mostly exporter. */
+	UPROPERTY(BlueprintReadOnly)
+	float GameThreadSeconds = 0;
+
+	/* Export queue only. Worker time of merging and writing. */
+	UPROPERTY(BlueprintReadOnly)
+	float WorkerSeconds = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Seconds = 0;
+};
+
+UENUM(BlueprintType)
+enum class EGLBExportJobState : uint8
+{
+	Queued				UMETA(ToolTip = "Waiting for a free job slot."),
+	Running				UMETA(ToolTip = "Parts are exported or merged."),
+	Succeeded			UMETA(ToolTip = "Output file is written."),
+	Failed				UMETA(ToolTip = "Export failed, see delegate messages."),
+	Cancelled			UMETA(ToolTip = "Job was cancelled, no output is written."),
+	Unknown				UMETA(ToolTip = "Handle isn't valid or job record was dropped."),
+};
+
+/* Descriptor of a queued streamed GLB export. Options are same as Export Level As GLB Streamed. */
+USTRUCT(BlueprintType)
+struct FGLBExportJob
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadWrite)
+	TSet<AActor*> TargetActors;
+
+	UPROPERTY(BlueprintReadWrite)
+	FString ExportPath;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bEnableQuantization = false;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bResetLocation = false;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bResetRotation = false;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bResetScale = false;
+
+	UPROPERTY(BlueprintReadWrite)
+	int32 ActorsPerPart = 64;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bUseExportCache = false;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bInstanceAndDedupe = true;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bOptimizeVertexCache = true;
+
+	UPROPERTY(BlueprintReadWrite)
+	bool bMeshoptCompression = false;
+};
+
+USTRUCT(BlueprintType)
+struct FExportQueueStats
+{
+	GENERATED_BODY()
+
+public:
+
+	/* Jobs waiting for a slot. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 QueuedJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 RunningJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SucceededJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 FailedJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 CancelledJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 MaxRunningJobs = 0;
+};
+
+UENUM(BlueprintType)
+enum class EIFCConversionState : uint8
+{
+	Queued				UMETA(ToolTip = "Waiting for a free converter process."),
+	Running				UMETA(ToolTip = "Converter process is running."),
+	Succeeded			UMETA(ToolTip = "Output file is written."),
+	Failed				UMETA(ToolTip = "Converter couldn't start or exited with an error, see result output."),
+	Cancelled			UMETA(ToolTip = "Job was cancelled, converter process is terminated."),
+	TimedOut			UMETA(ToolTip = "Converter ran longer than job timeout and was terminated."),
+	Unknown				UMETA(ToolTip = "Handle isn't valid or job record was dropped."),
+};
+
+/*
+*	Descriptor of a queued IFC conversion.
+*	Converter is started as "<Converter Path> <Arguments> <Input Path> <Output Path>" in its own folder. Any executable with that command line works, IfcConvert is the default.
+*/
+USTRUCT(BlueprintType)
+struct FIFCConversionJob
+{
+	GENERATED_BODY()
+
+public:
+
+	/* Full path of converter executable. */
+	UPROPERTY(BlueprintReadWrite)
+	FString ConverterPath;
+
+	UPROPERTY(BlueprintReadWrite)
+	FString InputPath;
+
+	/* Empty writes a .dae next to input file. Format follows extension. */
+	UPROPERTY(BlueprintReadWrite)
+	FString OutputPath;
+
+	UPROPERTY(BlueprintReadWrite)
+	FString Arguments = "--use-element-hierarchy --generate-uvs --center-model --center-model-geometry";
+
+	/* Zero means no timeout. */
+	UPROPERTY(BlueprintReadWrite)
+	float TimeoutSeconds = 0;
+
+	/* Output of an earlier conversion with same input content, arguments, output format and converter version is copied from cache instead. */
+	UPROPERTY(BlueprintReadWrite)
+	bool bUseCache = true;
+
+	/* Part of cache key. Empty uses size and timestamp of converter executable, so an updated converter doesn't get old results. */
+	UPROPERTY(BlueprintReadWrite)
+	FString ConverterVersion;
+};
+
+USTRUCT(BlueprintType)
+struct FIFCConversionResult
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 JobHandle = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	FString InputPath;
+
+	UPROPERTY(BlueprintReadOnly)
+	FString OutputPath;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 ExitCode = -1;
+
+	/* Last lines of converter's stdout and stderr. */
+	UPROPERTY(BlueprintReadOnly)
+	FString Output;
+
+	UPROPERTY(BlueprintReadOnly)
+	float QueueSeconds = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Seconds = 0;
+
+	/* Output is copied from conversion cache, converter didn't run. */
+	UPROPERTY(BlueprintReadOnly)
+	bool bIsCacheHit = false;
+};
+
+USTRUCT(BlueprintType)
+struct FIFCConversionStats
+{
+	GENERATED_BODY()
+
+public:
+
+	/* Jobs waiting for a converter process. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 QueuedJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 RunningJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 SucceededJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 FailedJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 CancelledJobCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 TimedOutJobCount = 0;
+
+	/* Process limit from core count, memory may hold it lower. */
+	UPROPERTY(BlueprintReadOnly)
+	int32 MaxProcesses = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FIFCCacheStats
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 EntryCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 UsedBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 BudgetBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 HitCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 MissCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float HitRate = 0;
+
+	/* Output bytes served from cache instead of a converter run. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 BytesSaved = 0;
+
+	/* Converter run time of served entries, measured when they were stored. */
+	UPROPERTY(BlueprintReadOnly)
+	float SecondsSaved = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FIFCEntityCount
+{
+	GENERATED_BODY()
+
+public:
+
+	/* Entity type as written in file, like IFCWALL or IFCCARTESIANPOINT. */
+	UPROPERTY(BlueprintReadOnly)
+	FString Type;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 Count = 0;
+
+	/* Bytes of all records of this type. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 Bytes = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FIFCScanResult
+{
+	GENERATED_BODY()
+
+public:
+
+	/* First schema of FILE_SCHEMA, like IFC2X3 or IFC4. */
+	UPROPERTY(BlueprintReadOnly)
+	FString Schema;
+
+	/* Name field of FILE_NAME, usually original file name. */
+	UPROPERTY(BlueprintReadOnly)
+	FString FileName;
+
+	UPROPERTY(BlueprintReadOnly)
+	FString TimeStamp;
+
+	/* Application which wrote the file. */
+	UPROPERTY(BlueprintReadOnly)
+	FString OriginatingSystem;
+
+	/* Name of IFCPROJECT entity. */
+	UPROPERTY(BlueprintReadOnly)
+	FString ProjectName;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 FileSize = 0;
+
+	/* Instances in DATA section. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 EntityCount = 0;
+
+	/* Points, loops, faces, face sets and solids. Their bytes are a rough measure of converter memory and output size. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 GeometryEntityCount = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 GeometryBytes = 0;
+
+	/* Sorted by count, most frequent first. */
+	UPROPERTY(BlueprintReadOnly)
+	TArray<FIFCEntityCount> EntityTypes;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Seconds = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FPluginPhaseMetrics
+{
+	GENERATED_BODY()
+
+public:
+
+	UPROPERTY(BlueprintReadOnly)
+	FString Phase;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 Count = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	int64 Bytes = 0;
+
+	/* Phase specific: entries walked, names matched, parts merged. */
+	UPROPERTY(BlueprintReadOnly)
+	int64 Items = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float TotalMs = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float MeanMs = 0;
+
+	/* Percentiles of recent calls. */
+	UPROPERTY(BlueprintReadOnly)
+	float P50Ms = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float P99Ms = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float MaxMs = 0;
+};
+
 UDELEGATE(BlueprintAuthorityOnly)
 DECLARE_DYNAMIC_DELEGATE_TwoParams(FDelegateGLTFExport, bool, bIsSuccessfull, FGLTFExportMessages, OutMessages);
 
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegateGLBExport, bool, bIsSuccessfull, FGLTFExportMessages, OutMessages, FGLBExportStats, OutStats);
+
 UDELEGATE(BlueprintAuthorityOnly)
 DECLARE_DYNAMIC_DELEGATE_OneParam(FDelegateOpenFile, FSelectedFiles, OutFileNames);
 
@@ -81,25 +687,157 @@ DECLARE_DYNAMIC_DELEGATE_TwoParams(FDelegateSaveFile, bool, bIsSaveSuccessful, F
 UDELEGATE(BlueprintAuthorityOnly)
 DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegateSearch, bool, bIsSearchSuccessful, FString, ErrorCode, FContentArrayContainer, Out);
 
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_OneParam(FDelegateSearchProgress, FContentArrayContainer, OutBatch);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegateSearchIndex, bool, bIsSuccessful, FString, ErrorCode, FSearchIndexStats, OutStats);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_FourParams(FDelegateFolderListing, bool, bIsSuccessful, FString, ErrorCode, int32, ListingHandle, int32, EntryCount);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FDelegateFolderChanges, FString, WatchedPath, FFolderChangeContainer, Out);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegateAssetLoaded, bool, bIsLoaded, FString, AssetRelativePath, const TArray<uint8>&, OutAssetBytes);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_FourParams(FDelegateAssetBatch, bool, bIsAllLoaded, int32, LoadedCount, int32, FailedCount, float, Seconds);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegateIFCConversion, bool, bIsSuccessful, FString, ErrorCode, FIFCConversionResult, OutResult);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FDelegateIFCProgress, int32, JobHandle, float, Progress);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegateIFCScan, bool, bIsSuccessful, FString, ErrorCode, FIFCScanResult, OutResult);
+
+UDELEGATE(BlueprintAuthorityOnly)
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FDelegatePDFViewer, bool, bIsSuccessful, FString, ErrorCode, FString, Out_HTML_Content);
+
 UCLASS()
-class UFileConvertersBPLibrary : public UBlueprintFunctionLibrary
+class FILECONVERTERS_API UFileConvertersBPLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_UCLASS_BODY()
 
-	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Additional Asset String", ToolTip = "Write relative file path after Content.", Keywords = "load, asset, additional, non-coocked, string"), Category = "File Converters|Load")
-	static void LoadAdditionalAssetString(const FString AssetRelativePath, FString& OutAssetString);
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Additional Asset String", ToolTip = "Write file path relative to Asset Root. Default root is Content.", Keywords = "load, asset, additional, non-coocked, string"), Category = "File Converters|Load")
+	static void LoadAdditionalAssetString(const FString AssetRelativePath, FString& OutAssetString, EAdditionalAssetRoot AssetRoot = EAdditionalAssetRoot::Content);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Additional Asset Bytes", ToolTip = "Write file path relative to Asset Root. Default root is Saved.", Keywords = "load, asset, additional, non-coocked, bytes"), Category = "File Converters|Load")
+	static void LoadAdditionalAssetBytes(const FString AssetRelativePath, TArray<uint8>& OutAssetBytes, EAdditionalAssetRoot AssetRoot = EAdditionalAssetRoot::Saved);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Additional Assets Batch", ToolTip = "Reads all files concurrently on background threads. Higher priority batches are read first. \nDelegate File is called for each file, Delegate Batch once after the last one. Duplicate paths are read once.", Keywords = "load, asset, additional, non-coocked, bytes, batch, async"), Category = "File Converters|Load")
+	static int32 LoadAdditionalAssetsBatch(FDelegateAssetLoaded DelegateFile, FDelegateAssetBatch DelegateBatch, TArray<FString> AssetRelativePaths, EAdditionalAssetRoot AssetRoot = EAdditionalAssetRoot::Saved, int32 Priority = 0);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Asset Load Concurrency", ToolTip = "Maximum number of batch reads in flight. Default is 8.", Keywords = "load, asset, additional, batch, async, concurrency"), Category = "File Converters|Load")
+	static void SetAssetLoadConcurrency(int32 MaxConcurrentReads = 8);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Asset Cache Budget", ToolTip = "Load Additional Asset String, Bytes and Batch keep file contents in memory and read them again only when file changes. \nLeast recently used files are dropped when cache exceeds the budget. Zero disables the cache. Default is 64 MB.", Keywords = "load, asset, additional, cache, budget, memory"), Category = "File Converters|Load")
+	static void SetAssetCacheBudget(int64 MaxBytes = 67108864);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Asset Cache", Keywords = "load, asset, additional, cache, clear"), Category = "File Converters|Load")
+	static void ClearAssetCache();
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Asset Cache Stats", ToolTip = "Also available with FileConverters.AssetCache.Stats console command.", Keywords = "load, asset, additional, cache, stats"), Category = "File Converters|Load")
+	static FAssetCacheStats GetAssetCacheStats();
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Open Mapped Asset", ToolTip = "Memory maps the file without copying it. Read parts of it with Read Mapped Asset Bytes or Read Mapped Asset Lines. \nMapping stays open until Close Mapped Asset is called.", Keywords = "load, asset, additional, mapped, mmap, stream"), Category = "File Converters|Load")
+	static bool OpenMappedAsset(const FString AssetRelativePath, EAdditionalAssetRoot AssetRoot, int32& OutMappedHandle, int64& OutSize, FString& ErrorCode);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Read Mapped Asset Bytes", ToolTip = "Copies only Count bytes starting from Offset.", Keywords = "load, asset, additional, mapped, bytes, chunk"), Category = "File Converters|Load")
+	static bool ReadMappedAssetBytes(int32 MappedHandle, int64 Offset, int32 Count, TArray<uint8>& OutBytes);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Read Mapped Asset Lines", ToolTip = "Reads up to Max Lines UTF-8 lines from Cursor and moves Cursor after them. Start with Cursor 0. \nReturns false when there is nothing left to read.", Keywords = "load, asset, additional, mapped, string, line, text"), Category = "File Converters|Load")
+	static bool ReadMappedAssetLines(int32 MappedHandle, UPARAM(ref) int64& Cursor, int32 MaxLines, TArray<FString>& OutLines);
 
-	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Load Additional Asset Bytes", ToolTip = "Write relative file path after Content.", Keywords = "load, asset, additional, non-coocked, bytes"), Category = "File Converters|Load")
-	static void LoadAdditionalAssetBytes(const FString AssetRelativePath, TArray<uint8>& OutAssetBytes);
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Close Mapped Asset", Keywords = "load, asset, additional, mapped"), Category = "File Converters|Load")
+	static void CloseMappedAsset(int32 MappedHandle);
 
-	UFUNCTION(BlueprintPure, meta = (DisplayName = "Helper IFC Converter", Keywords = "cmd, helper, converter, ifc"), Category = "File Converters|CMD")
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Helper IFC Converter", Keywords = "cmd, helper, converter, ifc", DeprecatedFunction, DeprecationMessage = "Windows shell only and converts one file at a time. Use Queue IFC Conversion."), Category = "File Converters|CMD")
 	static FString HelperIFCConverter(const FString IFC_Converter_Path, const FString IFC_EXE_Name, const FString IFC_Path);
 
-	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create PDF Viewer", ToolTip = "Default DummyText is ff_base64. If you use path for PDFs, you should attach an MakeArray node to In PDF Bytes. Because that input requires an attachment and it is about unreal blueprint limitations.", Keywords = "create, view, show, pdf, pdfjs, viewer"), Category = "File Converters|HTML")
-	static FString CreatePDFViewer(const FString In_HTML_Content, const FString In_PDF_Path, TArray<uint8> In_PDF_Bytes, const FString DummyText, bool bUseBytes);
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Queue IFC Conversion", ToolTip = "Queues a conversion and returns its job handle. Converter processes run in parallel up to the limit of Set IFC Conversion Concurrency, others wait in order. \nOutput is written to a temporary file and renamed when converter succeeds, so a failed or cancelled job never leaves a partial output. \nIf \"Use Cache\" is enabled, input is hashed on a worker first and an earlier result is copied instead of converting again. \nDelegate Progress fires on game thread when converter prints a new \"NN%\" value. Delegate Conversion fires on game thread when job finishes.", Keywords = "cmd, converter, ifc, ifcconvert, process, queue, async, batch"), Category = "File Converters|CMD")
+	static int32 QueueIFCConversion(FIFCConversionJob Job, FDelegateIFCConversion DelegateConversion, FDelegateIFCProgress DelegateProgress);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Cancel IFC Conversion", ToolTip = "Returns false if job is unknown or already finished. Running converter is terminated with its child processes.", Keywords = "cmd, converter, ifc, process, cancel, stop"), Category = "File Converters|CMD")
+	static bool CancelIFCConversion(int32 JobHandle);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get IFC Conversion Progress", ToolTip = "Progress is between 0 and 1, parsed from converter output. Finished jobs are kept for a while, so their last state can still be read.", Keywords = "cmd, converter, ifc, process, progress, state"), Category = "File Converters|CMD")
+	static EIFCConversionState GetIFCConversionProgress(int32 JobHandle, float& OutProgress);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set IFC Conversion Concurrency", ToolTip = "\"Max Processes\" limits converters running at once, zero uses physical core count. \nA new converter is started only if available memory is at least \"Memory Per Process MB\", one converter always runs.", Keywords = "cmd, converter, ifc, process, concurrency, memory"), Category = "File Converters|CMD")
+	static void SetIFCConversionConcurrency(int32 MaxProcesses = 0, int32 MemoryPerProcessMB = 2048);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get IFC Conversion Stats", Keywords = "cmd, converter, ifc, process, stats, queue"), Category = "File Converters|CMD")
+	static FIFCConversionStats GetIFCConversionStats();
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set IFC Cache Budget", ToolTip = "Disk budget of converted outputs in Saved/FileConverters/IFCCache. Least recently used entries are removed first. Default is 8 GB.", Keywords = "cmd, converter, ifc, cache, budget"), Category = "File Converters|CMD")
+	static void SetIFCCacheBudget(int64 MaxBytes = 8589934592);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear IFC Cache", Keywords = "cmd, converter, ifc, cache, clear"), Category = "File Converters|CMD")
+	static void ClearIFCCache();
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get IFC Cache Stats", ToolTip = "Entries, disk usage, hit rate and output bytes and converter time saved by IFC conversion cache.", Keywords = "cmd, converter, ifc, cache, stats, hit"), Category = "File Converters|CMD")
+	static FIFCCacheStats GetIFCCacheStats();
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Scan IFC File", ToolTip = "Reads schema, file and project names, entity type counts and geometry size of an IFC (STEP) file without converting it. \nFile is memory mapped and scanned in parallel on workers, delegate runs on game thread.", Keywords = "cmd, converter, ifc, step, scan, schema, entity, metadata"), Category = "File Converters|CMD")
+	static void ScanIFCFile(FDelegateIFCScan DelegateScan, const FString IFC_Path);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create PDF Viewer", ToolTip = "Default DummyText is ff_base64. If you use path for PDFs, you can leave In PDF Bytes unconnected. \nPDF is read in chunks and encoded directly into the output HTML.", Keywords = "create, view, show, pdf, pdfjs, viewer", AutoCreateRefTerm = "In_PDF_Bytes"), Category = "File Converters|HTML")
+	static FString CreatePDFViewer(const FString& In_HTML_Content, const FString In_PDF_Path, const TArray<uint8>& In_PDF_Bytes, const FString DummyText, bool bUseBytes);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Create PDF Viewer Async", ToolTip = "Default DummyText is ff_base64. \nPDF is read and encoded on a worker thread. \nIf cache is enabled, encoded PDF is kept on disk (Saved/FileConverters/PDFCache) and repeated opens only read it back.", Keywords = "create, view, show, pdf, pdfjs, viewer, async, cache"), Category = "File Converters|HTML")
+	static void CreatePDFViewerAsync(FDelegatePDFViewer DelegatePDFViewer, const FString& In_HTML_Content, const FString In_PDF_Path, const FString DummyText, bool bUseCache = true);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set PDF Cache Budget", ToolTip = "Maximum disk size of PDF viewer cache in bytes. Least recently used entries are removed when it is exceeded. Default is 1 GB.", Keywords = "pdf, cache, budget, disk"), Category = "File Converters|HTML")
+	static void SetPDFCacheBudget(int64 MaxBytes = 1073741824);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear PDF Cache", Keywords = "pdf, cache, clear, delete"), Category = "File Converters|HTML")
+	static void ClearPDFCache();
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get PDF Cache Size", ToolTip = "Current disk usage of PDF viewer cache in bytes.", Keywords = "pdf, cache, size, disk"), Category = "File Converters|HTML")
+	static int64 GetPDFCacheSize();
 
-	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLTF", ToolTip = "Description.", Keywords = "level, export, gltf, glb"), Category = "File Converters|GLTF")
-	static void ExportLevelGLTF(bool bEnableQuantization, bool bResetLocation, bool bResetRotation, bool bResetScale, const FString ExportPath, TSet<AActor*> TargetActors, FDelegateGLTFExport DelegateGLTFExport);
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLTF", ToolTip = "Reset options export actors at origin, with identity rotation or unit scale. \nBy default actors are moved for the export and restored right after it. \nIf \"Keep Actors Untouched\" is enabled, level isn't modified. Reset is written to root nodes of exported file instead, so attached actors keep their offset to their parent.", Keywords = "level, export, gltf, glb"), Category = "File Converters|GLTF")
+	static void ExportLevelGLTF(bool bEnableQuantization, bool bResetLocation, bool bResetRotation, bool bResetScale, const FString ExportPath, TSet<AActor*> TargetActors, FDelegateGLTFExport DelegateGLTFExport, bool bKeepActorsUntouched = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLB Streamed", ToolTip = "Same as Export Level As GLTF, for big levels. \nActors are exported in parts of about \"Actors Per Part\", attached actors stay with their parents. Binary data of parts is streamed into output file, so memory use depends on part size instead of level size. \nOutput has to be a .glb file. \nIf \"Use Export Cache\" is enabled, parts whose actors and referenced assets didn't change since an earlier export are copied from cache instead of being exported again. Parts with unsaved assets, landscapes or other generated geometry are always exported. Off by default. \nIf \"Instance And Dedupe\" is enabled, equal meshes, materials and images are written once and repeated meshes become EXT_mesh_gpu_instancing nodes. Savings are in the delegate stats. \nIf \"Optimize Vertex Cache\" is enabled, triangles and vertices of each primitive are reordered for GPU vertex cache and fetch. \nIf \"Meshopt Compression\" is enabled, vertex and index data is written with EXT_meshopt_compression. Viewers without that extension can't open the file.", Keywords = "level, export, gltf, glb, stream, big, large, cache, incremental, instancing, dedupe, meshopt, compression, vertex cache"), Category = "File Converters|GLTF")
+	static void ExportLevelGLBStreamed(bool bEnableQuantization, bool bResetLocation, bool bResetRotation, bool bResetScale, const FString ExportPath, TSet<AActor*> TargetActors, FDelegateGLBExport DelegateGLBExport, int32 ActorsPerPart = 64, bool bKeepActorsUntouched = false, bool bUseExportCache = false, bool bInstanceAndDedupe = true, bool bOptimizeVertexCache = true, bool bMeshoptCompression = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Export Level As GLB Tiles", ToolTip = "Splits actors into an octree of tiles with at most \"Max Triangles Per Tile\" (LOD 0 of static meshes) and exports each tile to its own GLB in \"Export Folder\". \nA 3D Tiles 1.1 tileset.json with bounding box of each tile is written next to them, so clients can stream only visible tiles. \nActors keep their level transforms, attached actors stay with their parents. Tiles are exported one by one on game thread, their optimization runs on all cores. \nStats are totals of all tiles, \"Part Count\" is tile count.", Keywords = "level, export, gltf, glb, tile, tiles, 3d tiles, tileset, octree, stream, big, large"), Category = "File Converters|GLTF")
+	static void ExportLevelGLBTiled(bool bEnableQuantization, const FString ExportFolder, TSet<AActor*> TargetActors, FDelegateGLBExport DelegateGLBExport, int64 MaxTrianglesPerTile = 250000, bool bInstanceAndDedupe = true, bool bOptimizeVertexCache = true, bool bMeshoptCompression = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Queue Level GLB Export", ToolTip = "Queues a streamed GLB export and returns its job handle. \nAt most \"Max Running Jobs\" exports run at once, others wait in order. Game thread work is time sliced, one exported part at a time within the frame budget, merging runs on workers. \nActors are never moved, reset options are written to root nodes. Actors destroyed before their part is exported are skipped. \nDelegate fires on game thread when job succeeds, fails or is cancelled.", Keywords = "level, export, gltf, glb, queue, job, async, background"), Category = "File Converters|GLTF")
+	static int32 QueueLevelGLBExport(FGLBExportJob Job, FDelegateGLBExport DelegateGLBExport);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Cancel Export Job", ToolTip = "Returns false if job is unknown, already finished or its file is already written. A running merge step finishes first, then job stops and its temporary files are removed.", Keywords = "export, gltf, glb, queue, job, cancel, stop"), Category = "File Converters|GLTF")
+	static bool CancelExportJob(int32 JobHandle);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Export Job Progress", ToolTip = "Progress is between 0 and 1. Finished jobs are kept for a while, so their last state can still be read.", Keywords = "export, gltf, glb, queue, job, progress, state"), Category = "File Converters|GLTF")
+	static EGLBExportJobState GetExportJobProgress(int32 JobHandle, float& OutProgress);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Export Queue Concurrency", ToolTip = "\"Max Running Jobs\" limits exports running at once. \nGame thread exports parts while \"Game Thread Budget Ms\" isn't used up in a frame, at least one part per frame.", Keywords = "export, gltf, glb, queue, job, concurrency, budget"), Category = "File Converters|GLTF")
+	static void SetExportQueueConcurrency(int32 MaxRunningJobs = 2, float GameThreadBudgetMs = 8.0f);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Export Queue Stats", Keywords = "export, gltf, glb, queue, job, stats, depth"), Category = "File Converters|GLTF")
+	static FExportQueueStats GetExportQueueStats();
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Export Cache Budget", ToolTip = "Disk budget of exported parts in Saved/FileConverters/ExportCache. Least recently used parts are removed first. Default is 4 GB.", Keywords = "export, gltf, glb, cache, budget"), Category = "File Converters|GLTF")
+	static void SetExportCacheBudget(int64 MaxBytes = 4294967296);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Export Cache", Keywords = "export, gltf, glb, cache, clear"), Category = "File Converters|GLTF")
+	static void ClearExportCache();
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Plugin Metrics", ToolTip = "Counts, bytes and durations of plugin phases: transform snapshot, export build, mesh optimize, file write, directory walk, match, index query, Base64 encode, template splice and IFC scan. \nSame phases are Unreal Insights trace scopes and \"stat FileConverters\" counters.", Keywords = "metrics, stats, profiling, timing, performance"), Category = "File Converters|Metrics")
+	static void GetPluginMetrics(TArray<FPluginPhaseMetrics>& OutMetrics);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Plugin Metrics", Keywords = "metrics, stats, profiling, reset"), Category = "File Converters|Metrics")
+	static void ResetPluginMetrics();
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Dump Plugin Metrics To CSV", ToolTip = "Appends one row per phase with a shared UTC timestamp. Header is written if file is new.", Keywords = "metrics, stats, profiling, csv, dump, export"), Category = "File Converters|Metrics")
+	static bool DumpPluginMetricsToCSV(const FString FilePath, FString& ErrorCode);
 
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Select File From Dialog", ToolTip = "If you enable \"Allow Folder Selection\", extension filtering will be disabled. \nExtension filtering uses a String to String MAP variable. \nKey is description and value is extension's itself. You need to write like this without quotes \"*.extension\". \nIf one extension group has multiple extensions, you need to use \";\" after each one.", Keywords = "select, file, folder, dialog, windows, explorer"), Category = "File Converters|File Dialog")
 	static void SelectFileFromDialog(FDelegateOpenFile DelegateFileNames, const FString InDialogName, const FString InOkLabel, const FString InDefaultPath, TMap<FString, FString> InExtensions, int32 DefaultExtensionIndex, bool bIsNormalizeOutputs = true, bool bAllowFolderSelection = false);
@@ -110,7 +848,49 @@ class UFileConvertersBPLibrary : public UBlueprintFunctionLibrary
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Folder Contents", ToolTip = "Description.", Keywords = "explorer, load, file, folder, content"), Category = "File Converters|File Dialog")
 	static bool GetFolderContents(TArray<FFolderContent>& OutContents, FString& ErrorCode, FString InPath);
 
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Open Folder Listing", ToolTip = "Lists and sorts folder on a worker thread. Folders come first. \nDelegate gives a listing handle and entry count. Read visible rows with Get Folder Listing Page and close the listing when widget is done with it.", Keywords = "explorer, load, file, folder, content, listing, async, page, sort"), Category = "File Converters|File Dialog")
+	static void OpenFolderListing(FDelegateFolderListing DelegateListing, FString InPath, EFolderSortMode SortMode = EFolderSortMode::NaturalName, bool bDescending = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Folder Listing Page", ToolTip = "Copies only Count entries starting from Offset. Returns false if listing handle isn't valid.", Keywords = "explorer, file, folder, content, listing, page"), Category = "File Converters|File Dialog")
+	static bool GetFolderListingPage(int32 ListingHandle, int32 Offset, int32 Count, TArray<FFolderContent>& OutContents);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Close Folder Listing", Keywords = "explorer, file, folder, content, listing"), Category = "File Converters|File Dialog")
+	static void CloseFolderListing(int32 ListingHandle);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Listing Cache Budget", ToolTip = "Get Folder Contents and Open Folder Listing keep names, sizes and times of recently visited folders in memory. Watched folders are kept up to date by watcher changes. \nLeast recently used folders are dropped when entry count or memory exceeds the budget. Zero disables the cache.", Keywords = "explorer, folder, listing, cache, budget, memory"), Category = "File Converters|File Dialog")
+	static void SetListingCacheBudget(int32 MaxEntries = 1000000, int64 MaxBytes = 268435456);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Listing Cache Revalidation", ToolTip = "Writing a file doesn't change its folder's time, so cached sizes and times of an unwatched folder may be old. \nIf enabled, children of unwatched folders are read again on every visit. It costs one disk access per child. Disabled by default.", Keywords = "explorer, folder, listing, cache, revalidate, stat, watch"), Category = "File Converters|File Dialog")
+	static void SetListingCacheRevalidation(bool bRevalidateUnwatched = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Clear Listing Cache", Keywords = "explorer, folder, listing, cache, clear"), Category = "File Converters|File Dialog")
+	static void ClearListingCache();
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Listing Cache Stats", ToolTip = "Cached folders, memory usage, hits, misses and invalidations of folder listing cache.", Keywords = "explorer, folder, listing, cache, stats"), Category = "File Converters|File Dialog")
+	static FListingCacheStats GetListingCacheStats();
+
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Search In Folder", ToolTip = "Description.", Keywords = "explorer, load, file, folder, content"), Category = "File Converters|File Dialog")
 	static void SearchInFolder(FDelegateSearch DelegateSearch, FString InPath, FString InSearch, bool bSearchExact);
 
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Search In Folder With Query", ToolTip = "Exact, substring, glob or fuzzy search with extension filter and result limit. \nFuzzy results come best score first, others are sorted by path.", Keywords = "explorer, load, file, folder, content, search, glob, fuzzy, extension"), Category = "File Converters|File Dialog")
+	static void SearchInFolderWithQuery(FDelegateSearch DelegateSearch, FString InPath, FFileSearchQuery Query);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Search In Folder Streamed", ToolTip = "Matches are delivered in batches with Delegate Progress while folders are still being walked. \nDelegate Search only signals completion, its container is empty.", Keywords = "explorer, load, file, folder, content, search, stream"), Category = "File Converters|File Dialog")
+	static void SearchInFolderStreamed(FDelegateSearch DelegateSearch, FDelegateSearchProgress DelegateProgress, FString InPath, FString InSearch, bool bSearchExact);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Register Search Index Root", ToolTip = "Builds a file name index of the folder (or loads it from Saved/FileConverters/SearchIndex) on a worker thread. \nSearches under that folder are answered from memory afterwards and kept up to date with the engine directory watcher. \nBuilds without developer tools (WITH_FILECONVERTERS_DIRECTORY_WATCHER=0) have no watcher, there the index has no change tracking and stays as built until it is registered again with Rebuild. \nEnable Rebuild if folder changed while application was closed.", Keywords = "explorer, search, index, folder, root"), Category = "File Converters|Search Index")
+	static void RegisterSearchIndexRoot(FDelegateSearchIndex DelegateIndex, FString InRootPath, bool bRebuild = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Unregister Search Index Root", Keywords = "explorer, search, index, folder, root"), Category = "File Converters|Search Index")
+	static void UnregisterSearchIndexRoot(FString InRootPath, bool bDeletePersisted = false);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Watch Folder", ToolTip = "Delegate Changes is called on game thread with created, modified and removed entries of the folder and its sub folders. \nRenames are reported as removed + added. \nNeeds engine directory watcher, so it isn't available in builds without developer tools.", Keywords = "explorer, folder, watch, change, notify"), Category = "File Converters|File Dialog")
+	static bool WatchFolder(FDelegateFolderChanges DelegateChanges, FString InPath, int32& OutWatchHandle, FString& ErrorCode);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Unwatch Folder", Keywords = "explorer, folder, watch, change, notify"), Category = "File Converters|File Dialog")
+	static void UnwatchFolder(int32 WatchHandle);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Get Search Index Stats", ToolTip = "Entry count, memory usage and last query latency of each registered root.", Keywords = "explorer, search, index, stats, memory"), Category = "File Converters|Search Index")
+	static void GetSearchIndexStats(TArray<FSearchIndexStats>& OutStats);
+
 };
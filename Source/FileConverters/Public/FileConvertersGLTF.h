@@ -0,0 +1,251 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+
+class AActor;
+class USceneComponent;
+class UGLTFExportOptions;
+class IFileHandle;
+class FJsonObject;
+class FJsonValue;
+
+/*
+*	Root transforms of export actors, kept as parallel arrays.
+*	Game thread only. Buffers are sized once on capture, reset and restore don't allocate.
+*	Restore writes relative transforms, so result doesn't depend on actor order even when actors are attached to each other.
+*/
+class FFileConvertersTransformSnapshot
+{
+public:
+
+	/* Actors without root component are skipped. */
+	void Capture(const TSet<AActor*>& Actors);
+
+	/* Parents are moved before their children, so an attached child ends up at its own reset transform. */
+	void Reset(bool bResetLocation, bool bResetRotation, bool bResetScale) const;
+
+	void Restore() const;
+
+	int32 Num() const { return Components.Num(); }
+
+private:
+
+	TArray<USceneComponent*> Components;
+	TArray<int32> AttachDepths;
+	TArray<FVector> RelativeLocations;
+	TArray<FRotator> RelativeRotations;
+	TArray<FVector> RelativeScales;
+	int32 MaxAttachDepth = 0;
+};
+
+/* Actors of one tile of a tiled export. Bounds are in world space. */
+struct FFileConvertersTile
+{
+	TSet<AActor*> Actors;
+	FBox Bounds = FBox(ForceInit);
+	int64 TriangleCount = 0;
+};
+
+/* Export options and post processing of exported glTF and GLB files. */
+class FILECONVERTERS_API FFileConvertersGLTF
+{
+public:
+
+	/* Options every export of this plugin uses. */
+	static UGLTFExportOptions* MakeExportOptions(bool bEnableQuantization);
+
+	/* Splits actors into parts of about ActorsPerPart. An attach hierarchy always stays in one part, so relative transforms are kept. */
+	static void SplitByAttachRoot(const TSet<AActor*>& Actors, int32 ActorsPerPart, TArray<TSet<AActor*>>& OutParts);
+
+	/*
+	*	Splits actors into an octree until each tile has at most MaxTrianglesPerTile (LOD 0 of static meshes) or can't be split further.
+	*	Attach hierarchies stay together and go to the cell of their bounds center. Empty cells don't make tiles.
+	*/
+	static void SplitBySpace(const TSet<AActor*>& Actors, int64 MaxTrianglesPerTile, TArray<FFileConvertersTile>& OutTiles);
+
+	/*
+	*	Writes a 3D Tiles 1.1 tileset with one additive root and a child for each tile. TileUris are relative to tileset file.
+	*	Bounding boxes are converted like exporter converts geometry, then from glTF Y up to tileset Z up.
+	*/
+	static bool WriteTileset(const FString& FilePath, const TArray<FFileConvertersTile>& Tiles, const TArray<FString>& TileUris, float ExportScale, FString& ErrorCode);
+
+	/* Adds counts, bytes and time of one export to a total. */
+	static void AccumulateStats(FGLBExportStats& Total, const FGLBExportStats& Stats);
+
+	/* Splits a GLB into its JSON and binary chunks. Binary is empty if file has none. */
+	static bool ParseGLB(const TArray<uint8>& FileBytes, TSharedPtr<FJsonObject>& OutJson, TArray<uint8>& OutBinary, FString& ErrorCode);
+
+	/* Writes JSON and binary chunks with required padding. */
+	static void WriteGLB(const TSharedRef<FJsonObject>& Json, const TArray<uint8>& Binary, TArray<uint8>& OutFileBytes);
+
+	/* Loads .glb or .gltf file as JSON plus binary chunk. */
+	static bool LoadFile(const FString& FilePath, TSharedPtr<FJsonObject>& OutJson, TArray<uint8>& OutBinary, FString& ErrorCode);
+	static bool SaveFile(const FString& FilePath, const TSharedRef<FJsonObject>& Json, const TArray<uint8>& Binary, FString& ErrorCode);
+
+	/* Resets translation, rotation or scale of scene root nodes in parsed JSON. */
+	static void ResetRootNodes(const TSharedRef<FJsonObject>& Json, bool bResetLocation, bool bResetRotation, bool bResetScale);
+
+	/*
+	*	Same for a file on disk. Exporter writes one root node for each actor without an exported parent.
+	*	Only those root nodes are reset. Resetting actors before export also resets attached target actors, here they keep their offset to the parent.
+	*/
+	static bool OverrideRootTransforms(const FString& FilePath, bool bResetLocation, bool bResetRotation, bool bResetScale, FString& ErrorCode);
+};
+
+/*
+*	Merges GLB files into one GLB without holding their binary chunks in memory.
+*	Buffer views of each part are copied one by one into a spool file next to the output, only JSON of parts is kept.
+*	When optimizing, views with equal bytes and JSON objects which become equal after remapping (accessors, images, textures, materials, meshes) are written once,
+*	and sibling leaf nodes sharing a mesh are merged into one EXT_mesh_gpu_instancing node.
+*	With mesh optimization, vertex and index views of a part are loaded together, reordered and encoded with EXT_meshopt_compression on workers, then merged.
+*	Finish writes header and merged JSON, then copies the spool behind them. Peak memory is merged JSON plus the largest buffer view, or the mesh data of one part with mesh optimization.
+*/
+class FFileConvertersGLBWriter
+{
+public:
+
+	static constexpr int64 CopyChunkSize = 4 * 1024 * 1024;
+
+	explicit FFileConvertersGLBWriter(const FString& InOutputPath);
+
+	/* Removes spool file. */
+	~FFileConvertersGLBWriter();
+
+	/* Applied to root nodes of each part while merging. */
+	void SetRootReset(bool bInResetLocation, bool bInResetRotation, bool bInResetScale);
+
+	/* Shares equal content between parts and instances repeated meshes. */
+	void SetOptimize(bool bInOptimize);
+
+	/* Reorders triangle list primitives for vertex cache and fetch, and writes vertex and index views with EXT_meshopt_compression. */
+	void SetMeshOptimization(bool bInReorderVertices, bool bInCompressMeshes);
+
+	/* Part has to be a GLB with at most one embedded buffer. If a part can't be read, writer is unchanged and part can be appended from another file. */
+	bool AppendPart(const FString& PartPath, FString& ErrorCode);
+
+	bool Finish(FString& ErrorCode);
+
+	/* Complete after Finish. Part counts and time are up to caller. */
+	const FGLBExportStats& GetStats() const { return Stats; }
+
+private:
+
+	/* Part buffer view which is optimized in memory before it is merged. */
+	struct FPreparedView
+	{
+		TArray<uint8> Bytes;
+
+		/* EXT_meshopt_compression stream. Empty if view isn't compressed or compression doesn't make it smaller. */
+		TArray<uint8> Encoded;
+
+		int32 ElementSize = 0;
+		int32 Count = 0;
+		bool bIsIndices = false;
+		bool bCanCompress = false;
+	};
+
+	/* Reads header and JSON chunk. Leaves handle at the start of binary chunk data. */
+	static bool ReadPartHeader(IFileHandle& PartHandle, TSharedPtr<FJsonObject>& OutJson, int64& OutBinaryLength, FString& ErrorCode);
+
+	bool OpenSpool(FString& ErrorCode);
+
+	/* Rewrites part indices to merged indices and merges part JSON and views. */
+	bool MergePart(const TSharedRef<FJsonObject>& PartJson, IFileHandle& PartHandle, int64 PartBinaryStart, int64 PartBinaryLength, FString& ErrorCode);
+
+	/* Loads views holding exactly one tightly packed vertex or index accessor, reorders and encodes them in parallel. */
+	bool PrepareBufferViews(const TSharedRef<FJsonObject>& PartJson, IFileHandle& PartHandle, int64 PartBinaryStart, int64 PartBinaryLength, TMap<int32, FPreparedView>& OutViews, FString& ErrorCode);
+
+	bool MergeBufferViews(const TSharedRef<FJsonObject>& PartJson, IFileHandle& PartHandle, int64 PartBinaryStart, int64 PartBinaryLength, TArray<int32>& OutRemap, FString& ErrorCode);
+
+	/* Appends part objects of a kind to merged array. OutRemap maps part index to merged index. */
+	void MergeObjects(const TSharedRef<FJsonObject>& PartJson, const TCHAR* Name, bool bCanShare, TArray<int32>& OutRemap);
+
+	/* Returns merged view index, INDEX_NONE on write failure. Encoded data of a prepared view is written instead of Data, Data then only sizes the fallback buffer. */
+	int32 AppendBufferView(const uint8* Data, int64 Length, int32 ByteStride, int32 Target, const FPreparedView* Prepared, FString& ErrorCode);
+	int32 AppendFloatAccessor(const TArray<float>& Values, int32 ComponentCount, FString& ErrorCode);
+
+	bool InstanceNodes(FString& ErrorCode);
+
+	TArray<TSharedPtr<FJsonValue>>& GetArray(const TCHAR* Name);
+
+	FString OutputPath;
+	FString SpoolPath;
+	TUniquePtr<IFileHandle> Spool;
+	int64 BinaryLength = 0;
+
+	/* Size of EXT_meshopt_compression fallback buffer. It has no data, decoders fill it. */
+	int64 FallbackLength = 0;
+
+	TArray<uint8> CopyBuffer;
+	bool bIsFailed = false;
+
+	TMap<FString, TArray<TSharedPtr<FJsonValue>>> MergedArrays;
+	TArray<TSharedPtr<FJsonValue>> SceneNodes;
+	TArray<TSharedPtr<FJsonValue>> Lights;
+	TSharedPtr<FJsonObject> Asset;
+	TSet<FString> ExtensionsUsed;
+	TSet<FString> ExtensionsRequired;
+
+	/* Content keys to merged indices, only filled when optimizing. */
+	TMap<FString, int32> SharedBufferViews;
+	TMap<FString, TMap<FString, int32>> SharedObjects;
+
+	FGLBExportStats Stats;
+
+	bool bResetLocation = false;
+	bool bResetRotation = false;
+	bool bResetScale = false;
+	bool bOptimize = false;
+	bool bReorderVertices = false;
+	bool bCompressMeshes = false;
+};
+
+/*
+*	Persistent cache of exported parts for incremental streamed exports.
+*	Entries are part GLBs under Saved/FileConverters/ExportCache. Key covers export options, editable properties and world transforms of every component,
+*	saved package versions of every asset a component references and of materials, parent materials and textures they use.
+*	A part with any unsaved or transient asset, or with a primitive other than static and skinned meshes, isn't cached.
+*	Hits refresh the entry timestamp, eviction removes the least recently used entries until the disk budget fits.
+*/
+class FFileConvertersExportCache
+{
+public:
+
+	static FFileConvertersExportCache& Get();
+
+	/* Game thread, after transforms are reset for export. Returns false if part can't be cached. */
+	static bool MakePartKey(const TSet<AActor*>& PartActors, bool bEnableQuantization, uint64& OutKey);
+
+	/* Returns entry path and refreshes its timestamp, or empty if there is no entry. */
+	FString Find(uint64 Key);
+
+	/* Moves an exported part into cache. Returns entry path, or empty if part stays where it is. */
+	FString Store(uint64 Key, const FString& PartPath);
+
+	void SetBudget(int64 InBudgetBytes);
+	void Clear();
+
+private:
+
+	FString GetCacheDir() const;
+	FString GetEntryPath(uint64 Key) const;
+
+	/* False for primitives whose exported geometry the key can't describe. */
+	static bool IsCoveredByKey(const USceneComponent* Component);
+
+	/* Appends saved version of asset package. False for unsaved or transient assets. */
+	static bool AppendAssetVersion(const UObject* Asset, FString& KeySource);
+
+	/* Needs Guard. Scans cache folder once to learn used bytes. */
+	void ScanUsedBytes();
+
+	/* Needs Guard. Removes oldest entries until used bytes fit into budget. */
+	void EvictToBudget();
+
+	FCriticalSection Guard;
+	int64 BudgetBytes = 4LL * 1024LL * 1024LL * 1024LL;
+	int64 UsedBytes = INDEX_NONE;
+};
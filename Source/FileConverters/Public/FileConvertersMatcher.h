@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+
+/*
+*	Name matcher of folder search and search index.
+*	Works on name views and doesn't allocate. Substring and fuzzy modes first look for the leading pair or character of the pattern with SSE2, full comparison only runs at those positions.
+*	A matcher is immutable after construction, walker workers share one.
+*/
+class FILECONVERTERS_API FFileConvertersMatcher
+{
+public:
+
+	explicit FFileConvertersMatcher(const FFileSearchQuery& InQuery);
+
+	/* CleanName is name with extension. Exact, substring and fuzzy modes look at name without extension, glob looks at whole name. */
+	bool Matches(FStringView CleanName, bool bIsDirectory, int32& OutScore) const;
+
+	/* Every match contains this in its base name, so index can take trigram candidates from it. Empty if there is no such literal. */
+	const FString& GetRequiredLiteral() const { return RequiredLiteral; }
+
+	bool IsRanked() const { return Mode == EFileSearchMode::Fuzzy; }
+
+	/* Fuzzy: higher score first. Others: path order. */
+	bool IsBetter(const FFolderContent& A, const FFolderContent& B) const;
+
+	/* False if a bounded result set is full and this candidate can't get in. Lets callers skip building the result. */
+	bool ShouldCollect(const TArray<FFolderContent>& Results, FStringView Path, int32 Score) const;
+
+	/* Results are a heap with the worst result on top while MaxResults is set. */
+	void Collect(TArray<FFolderContent>& Results, FFolderContent&& Content) const;
+
+	/* Sorts best first and cuts to MaxResults. */
+	void Finish(TArray<FFolderContent>& Results) const;
+
+	/* First index of Lower or Upper from StartIndex. */
+	static int32 FindChar(FStringView Text, int32 StartIndex, TCHAR Lower, TCHAR Upper);
+
+	/* First index where a First variant is followed by a Second variant. */
+	static int32 FindPair(FStringView Text, int32 StartIndex, TCHAR FirstLower, TCHAR FirstUpper, TCHAR SecondLower, TCHAR SecondUpper);
+
+private:
+
+	FORCEINLINE TCHAR Fold(TCHAR Char) const
+	{
+		return bCaseSensitive ? Char : FChar::ToLower(Char);
+	}
+
+	bool MatchesExtension(FStringView CleanName) const;
+	bool MatchesSubstring(FStringView BaseName) const;
+	bool MatchesGlob(FStringView CleanName) const;
+	bool MatchesFuzzy(FStringView BaseName, int32& OutScore) const;
+
+	EFileSearchMode Mode = EFileSearchMode::Substring;
+	bool bCaseSensitive = false;
+	int32 MaxResults = 0;
+
+	/* Folded when search is case insensitive. */
+	FString Pattern;
+	FString RequiredLiteral;
+	TArray<FString> Extensions;
+
+	/* Both case variants of first two pattern characters for prefilters. */
+	TCHAR FirstLower = 0;
+	TCHAR FirstUpper = 0;
+	TCHAR SecondLower = 0;
+	TCHAR SecondUpper = 0;
+};
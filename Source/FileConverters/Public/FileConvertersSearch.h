@@ -0,0 +1,41 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+struct FFolderContent;
+
+/*
+*	Parallel directory walker.
+*	Every worker owns a stack of folders. Owner pops its newest folder (depth first, so frontier stays small) and idle workers steal the oldest half of another worker's stack.
+*	Walker doesn't collect anything. Visitor decides what to keep, so memory scales with kept entries instead of tree size.
+*/
+class FILECONVERTERS_API FFileConvertersWalker
+{
+public:
+
+	/* WorkerIndex is stable during a walk, so visitors can keep per worker state without locking. Stat data comes from the folder iteration itself. */
+	using FVisitor = TFunctionRef<void(int32 WorkerIndex, const TCHAR* CharPath, const FFileStatData& StatData)>;
+
+	static int32 GetDefaultWorkerCount();
+
+	/* Blocks until whole tree is visited. Root itself is not visited. */
+	static void Walk(const FString& RootPath, int32 WorkerCount, FVisitor Visitor);
+};
+
+/* Name helpers for search. They work on views and don't allocate. */
+class FILECONVERTERS_API FFileConvertersSearch
+{
+public:
+
+	/* Same as FPaths::GetCleanFilename. */
+	static FStringView GetCleanName(FStringView Path);
+
+	/* Same as FPaths::GetBaseFilename. */
+	static FStringView GetBaseName(FStringView Path);
+
+	/* Size and timestamps from stat data of the walk. Folders have zero size. */
+	static void SetStat(FFolderContent& Content, const FFileStatData& StatData);
+};
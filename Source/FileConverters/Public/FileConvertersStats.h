@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileConvertersBPLibrary.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+class FJsonValue;
+
+DECLARE_STATS_GROUP(TEXT("File Converters"), STATGROUP_FileConverters, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Transform Snapshot"), STAT_FileConverters_TransformSnapshot, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Export Build"), STAT_FileConverters_ExportBuild, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mesh Optimize"), STAT_FileConverters_MeshOptimize, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("File Write"), STAT_FileConverters_FileWrite, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Directory Walk"), STAT_FileConverters_DirectoryWalk, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Match"), STAT_FileConverters_Match, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Index Query"), STAT_FileConverters_IndexQuery, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Base64 Encode"), STAT_FileConverters_Base64Encode, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Template Splice"), STAT_FileConverters_TemplateSplice, STATGROUP_FileConverters, FILECONVERTERS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("IFC Scan"), STAT_FileConverters_IFCScan, STATGROUP_FileConverters, FILECONVERTERS_API);
+
+/* Order and names have to match FileConvertersStats::PhaseNames. */
+enum class EFileConvertersPhase : uint8
+{
+	TransformSnapshot,
+	ExportBuild,
+	MeshOptimize,
+	FileWrite,
+	DirectoryWalk,
+	Match,
+	IndexQuery,
+	Base64Encode,
+	TemplateSplice,
+	IFCScan,
+	Count,
+};
+
+/* Match time and name count of one walker worker. Padded to a cache line, so workers counting side by side don't share one. */
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FFileConvertersWorkerCycles
+{
+	uint64 Cycles = 0;
+	int64 Items = 0;
+};
+
+/*
+*	In process metrics of plugin phases, readable from Blueprint and dumpable to CSV.
+*	Each phase keeps counts, bytes, items and its last SampleCount durations. Percentiles are taken from those samples when metrics are read.
+*	Phases can nest, splice time includes encode time of its payload. Thread safe.
+*/
+class FILECONVERTERS_API FFileConvertersMetrics
+{
+public:
+
+	static constexpr int32 SampleCount = 1024;
+
+	static FFileConvertersMetrics& Get();
+
+	/* Items are phase specific: entries walked, names matched, parts merged, entities scanned. */
+	void Record(EFileConvertersPhase Phase, double Seconds, int64 Bytes = 0, int64 Items = 0);
+
+	/* Records one sample from cycles and items which workers summed themselves, for phases too fine grained for a scope per call. Sample is CPU time of all workers, not wall time. */
+	void RecordCycles(EFileConvertersPhase Phase, TConstArrayView<FFileConvertersWorkerCycles> WorkerCycles);
+
+	void GetMetrics(TArray<FPluginPhaseMetrics>& OutMetrics);
+
+	/* One object per phase, as commandlet reports write them. */
+	void GetJsonValues(TArray<TSharedPtr<FJsonValue>>& OutValues);
+	void Reset();
+
+	/* Appends one row per phase, writes header if file is new. */
+	bool AppendCSV(const FString& FilePath, FString& ErrorCode);
+
+private:
+
+	struct FPhase
+	{
+		int64 Count = 0;
+		int64 Bytes = 0;
+		int64 Items = 0;
+		double TotalSeconds = 0;
+		double MaxSeconds = 0;
+
+		/* Ring buffer of recent durations. */
+		TArray<float> Samples;
+		int32 NextSample = 0;
+	};
+
+	FCriticalSection Guard;
+	FPhase Phases[int32(EFileConvertersPhase::Count)];
+};
+
+/* Times a phase into metrics. Bytes and items can be added before scope ends. */
+class FFileConvertersPhaseScope
+{
+public:
+
+	explicit FFileConvertersPhaseScope(EFileConvertersPhase InPhase)
+		: Phase(InPhase)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FFileConvertersPhaseScope()
+	{
+		FFileConvertersMetrics::Get().Record(Phase, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles), Bytes, Items);
+	}
+
+	void AddBytes(int64 InBytes) { Bytes += InBytes; }
+	void AddItems(int64 InItems) { Items += InItems; }
+
+private:
+
+	EFileConvertersPhase Phase;
+	uint64 StartCycles = 0;
+	int64 Bytes = 0;
+	int64 Items = 0;
+};
+
+/* Insights trace event, stat cycle counter and metrics of one phase. Scope variable is PhaseScope_<Name>. */
+#define FILECONVERTERS_PHASE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE(FileConverters_##Name); \
+	SCOPE_CYCLE_COUNTER(STAT_FileConverters_##Name); \
+	FFileConvertersPhaseScope PhaseScope_##Name(EFileConvertersPhase::Name)
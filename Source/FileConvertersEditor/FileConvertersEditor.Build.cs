@@ -0,0 +1,32 @@
+// Some copyright should be here...
+
+using UnrealBuildTool;
+
+public class FileConvertersEditor : ModuleRules
+{
+	public FileConvertersEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+			
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"CoreUObject",
+				"Engine",
+				"UnrealEd",
+				"FileConverters",
+				"GLTFExporter",
+				"Json",
+				"Projects",
+			}
+			);
+	}
+}
@@ -0,0 +1,747 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersBenchmarkCommandlet.h"
+#include "FileConverters.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "HAL/PlatformFileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+#include <atomic>
+
+namespace FileConvertersBenchmark
+{
+    // Every NeedleEvery'th generated file carries the search term, so searches find a known number of entries.
+    static constexpr int64 NeedleEvery = 1000;
+    static const TCHAR* NeedleText = TEXT("Needle");
+    static const TCHAR* DummyText = TEXT("ff_base64");
+
+    static constexpr double CallbackTimeout = 3600.0;
+    static constexpr double BytesPerMegabyte = 1024.0 * 1024.0;
+
+    static const TCHAR* Extensions[] = { TEXT("txt"), TEXT("pdf"), TEXT("ifc"), TEXT("glb") };
+
+    static const TCHAR* MeshPaths[] =
+    {
+        TEXT("/Engine/BasicShapes/Cube.Cube"),
+        TEXT("/Engine/BasicShapes/Sphere.Sphere"),
+        TEXT("/Engine/BasicShapes/Cylinder.Cylinder"),
+        TEXT("/Engine/BasicShapes/Cone.Cone"),
+    };
+
+    // Nearest rank, same as plugin metrics.
+    static double GetPercentile(const TArray<double>& Sorted, int32 Percent)
+    {
+        return Sorted.Num() > 0 ? Sorted[(Sorted.Num() - 1) * Percent / 100] : 0.0;
+    }
+
+    static void ParseNumbers(const FString& List, TArray<int64>& OutNumbers)
+    {
+        TArray<FString> Array_Items;
+        List.ParseIntoArray(Array_Items, TEXT(","), true);
+
+        for (const FString& EachItem : Array_Items)
+        {
+            const int64 Number = FCString::Atoi64(*EachItem.TrimStartAndEnd());
+            if (Number > 0)
+            {
+                OutNumbers.Add(Number);
+            }
+        }
+    }
+}
+
+UFileConvertersBenchmarkCommandlet::UFileConvertersBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UFileConvertersBenchmarkCommandlet::Main(const FString& Params)
+{
+    using namespace FileConvertersBenchmark;
+
+    FString WorkDir = FPaths::ProjectSavedDir() / TEXT("FileConverters/Benchmark");
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("FileConverters/BenchmarkResults.json");
+    int32 Iterations = 5;
+    int64 FlatFiles = 300000;
+    int64 DeepFiles = 2000000;
+    int32 DeepFanout = 8;
+    int32 DeepDepth = 4;
+    FString PDFSizes = TEXT("1,16,128");
+    FString SceneActors = TEXT("500,5000");
+    FString ScenarioList = TEXT("Search,Listing,PDF,Export");
+
+    FParse::Value(*Params, TEXT("WorkDir="), WorkDir);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FParse::Value(*Params, TEXT("Iterations="), Iterations);
+    FParse::Value(*Params, TEXT("FlatFiles="), FlatFiles);
+    FParse::Value(*Params, TEXT("DeepFiles="), DeepFiles);
+    FParse::Value(*Params, TEXT("DeepFanout="), DeepFanout);
+    FParse::Value(*Params, TEXT("DeepDepth="), DeepDepth);
+    FParse::Value(*Params, TEXT("PDFSizesMB="), PDFSizes, false);
+    FParse::Value(*Params, TEXT("SceneActors="), SceneActors, false);
+    FParse::Value(*Params, TEXT("Scenarios="), ScenarioList, false);
+
+    const bool bCleanData = FParse::Param(*Params, TEXT("CleanData"));
+
+    Iterations = FMath::Max(Iterations, 1);
+    DeepFanout = FMath::Max(DeepFanout, 1);
+    DeepDepth = FMath::Max(DeepDepth, 0);
+
+    TArray<FString> Array_Enabled;
+    ScenarioList.ParseIntoArray(Array_Enabled, TEXT(","), true);
+
+    TArray<int64> Array_PDFSizes;
+    ParseNumbers(PDFSizes, Array_PDFSizes);
+
+    TArray<int64> Array_SceneActors;
+    ParseNumbers(SceneActors, Array_SceneActors);
+
+    TMap<FString, FString> Config;
+    Config.Add(TEXT("workDir"), WorkDir);
+    Config.Add(TEXT("iterations"), FString::FromInt(Iterations));
+    Config.Add(TEXT("flatFiles"), LexToString(FlatFiles));
+    Config.Add(TEXT("deepFiles"), LexToString(DeepFiles));
+    Config.Add(TEXT("deepFanout"), FString::FromInt(DeepFanout));
+    Config.Add(TEXT("deepDepth"), FString::FromInt(DeepDepth));
+    Config.Add(TEXT("pdfSizesMB"), PDFSizes);
+    Config.Add(TEXT("sceneActors"), SceneActors);
+    Config.Add(TEXT("scenarios"), ScenarioList);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*WorkDir);
+
+    // Phase metrics in the report cover only this run.
+    FFileConvertersMetrics::Get().Reset();
+
+    const FString FlatRoot = WorkDir / TEXT("Flat");
+    const FString DeepRoot = WorkDir / TEXT("Deep");
+
+    const bool bRunSearch = Array_Enabled.Contains(TEXT("Search"));
+    const bool bRunListing = Array_Enabled.Contains(TEXT("Listing"));
+
+    if ((bRunSearch == true || bRunListing == true) && FlatFiles > 0)
+    {
+        RunGenerate(TEXT("Generate.Flat"), [&FlatRoot, FlatFiles]() { return GenerateTree(FlatRoot, FlatFiles, 1, 0); }, FlatFiles);
+
+        if (Scenarios.Last().bIsSuccessful == true)
+        {
+            if (bRunSearch == true)
+            {
+                RunSearch(FlatRoot, TEXT("SearchInFolder.Flat"), FlatFiles, Iterations);
+            }
+
+            if (bRunListing == true)
+            {
+                RunListing(FlatRoot, TEXT("GetFolderContents.Flat"), Iterations);
+            }
+        }
+    }
+
+    if (bRunSearch == true && DeepFiles > 0)
+    {
+        RunGenerate(TEXT("Generate.Deep"), [&DeepRoot, DeepFiles, DeepFanout, DeepDepth]() { return GenerateTree(DeepRoot, DeepFiles, DeepFanout, DeepDepth); }, DeepFiles);
+
+        if (Scenarios.Last().bIsSuccessful == true)
+        {
+            RunSearch(DeepRoot, TEXT("SearchInFolder.Deep"), DeepFiles, Iterations);
+        }
+    }
+
+    if (Array_Enabled.Contains(TEXT("PDF")) == true)
+    {
+        for (const int64 EachSizeMB : Array_PDFSizes)
+        {
+            const int64 Size = EachSizeMB * 1024 * 1024;
+            const FString PDFPath = WorkDir / FString::Printf(TEXT("PDF/Synthetic_%lldMB.pdf"), EachSizeMB);
+
+            RunGenerate(FString::Printf(TEXT("Generate.PDF.%lldMB"), EachSizeMB), [&PDFPath, Size]() { return GeneratePDF(PDFPath, Size); }, 1);
+
+            if (Scenarios.Last().bIsSuccessful == true)
+            {
+                RunPDF(PDFPath, Size, Iterations);
+            }
+        }
+    }
+
+    if (Array_Enabled.Contains(TEXT("Export")) == true)
+    {
+        for (const int64 EachActorCount : Array_SceneActors)
+        {
+            RunExport(WorkDir, int32(EachActorCount), Iterations);
+        }
+    }
+
+    const TSharedRef<FJsonObject> Report = MakeReport(Config);
+
+    FString ReportText;
+    const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ReportText);
+    FJsonSerializer::Serialize(Report, JsonWriter);
+
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(OutputPath));
+
+    bool bIsAllSuccessful = FFileHelper::SaveStringToFile(ReportText, *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+    if (bIsAllSuccessful == false)
+    {
+        UE_LOG(LogFileConverters, Error, TEXT("Benchmark results can't be written to %s"), *OutputPath);
+    }
+
+    else
+    {
+        UE_LOG(LogFileConverters, Display, TEXT("Benchmark results are written to %s"), *OutputPath);
+    }
+
+    for (const FScenario& EachScenario : Scenarios)
+    {
+        bIsAllSuccessful &= EachScenario.bIsSuccessful;
+    }
+
+    if (bCleanData == true)
+    {
+        PlatformFile.DeleteDirectoryRecursively(*WorkDir);
+    }
+
+    return bIsAllSuccessful == true ? 0 : 1;
+}
+
+bool UFileConvertersBenchmarkCommandlet::GenerateTree(const FString& RootPath, int64 FileCount, int32 Fanout, int32 Depth)
+{
+    using namespace FileConvertersBenchmark;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // Marker sits next to the tree, so it isn't counted by searches.
+    const FString MarkerPath = RootPath + TEXT(".marker");
+    const FString MarkerText = FString::Printf(TEXT("%lld,%d,%d"), FileCount, Fanout, Depth);
+
+    FString ExistingMarker;
+    if (FFileHelper::LoadFileToString(ExistingMarker, *MarkerPath) == true && ExistingMarker == MarkerText && PlatformFile.DirectoryExists(*RootPath) == true)
+    {
+        return true;
+    }
+
+    PlatformFile.DeleteFile(*MarkerPath);
+    PlatformFile.DeleteDirectoryRecursively(*RootPath);
+
+    TArray<FString> Array_Leaves;
+    Array_Leaves.Add(RootPath);
+
+    for (int32 Level = 0; Level < Depth; Level++)
+    {
+        TArray<FString> Array_Next;
+        Array_Next.Reserve(Array_Leaves.Num() * Fanout);
+
+        for (const FString& EachLeaf : Array_Leaves)
+        {
+            for (int32 ChildIndex = 0; ChildIndex < Fanout; ChildIndex++)
+            {
+                Array_Next.Add(EachLeaf / FString::Printf(TEXT("Folder_%02d"), ChildIndex));
+            }
+        }
+
+        Array_Leaves = MoveTemp(Array_Next);
+    }
+
+    for (const FString& EachLeaf : Array_Leaves)
+    {
+        if (PlatformFile.CreateDirectoryTree(*EachLeaf) == false)
+        {
+            return false;
+        }
+    }
+
+    // Files are spread over leaves round robin, chunks keep all cores busy even for a single flat folder.
+    const int32 ChunkCount = int32(FMath::Min<int64>(FileCount, 1024));
+    std::atomic<bool> bIsFailed{ false };
+
+    ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+        {
+            const int64 First = FileCount * ChunkIndex / ChunkCount;
+            const int64 Last = FileCount * (ChunkIndex + 1) / ChunkCount;
+
+            for (int64 FileIndex = First; FileIndex < Last && bIsFailed.load(std::memory_order_relaxed) == false; FileIndex++)
+            {
+                const FString& Leaf = Array_Leaves[FileIndex % Array_Leaves.Num()];
+                const TCHAR* Extension = Extensions[FileIndex % UE_ARRAY_COUNT(Extensions)];
+                const TCHAR* Prefix = FileIndex % NeedleEvery == 0 ? NeedleText : TEXT("File");
+
+                IFileHandle* FileHandle = PlatformFile.OpenWrite(*(Leaf / FString::Printf(TEXT("%s_%09lld.%s"), Prefix, FileIndex, Extension)));
+
+                if (FileHandle == nullptr)
+                {
+                    bIsFailed = true;
+                    return;
+                }
+
+                delete FileHandle;
+            }
+        }
+    );
+
+    if (bIsFailed == true)
+    {
+        return false;
+    }
+
+    return FFileHelper::SaveStringToFile(MarkerText, *MarkerPath);
+}
+
+bool UFileConvertersBenchmarkCommandlet::GeneratePDF(const FString& FilePath, int64 Size)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    if (PlatformFile.FileSize(*FilePath) == Size)
+    {
+        return true;
+    }
+
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+    TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*FilePath));
+
+    if (FileHandle.IsValid() == false)
+    {
+        return false;
+    }
+
+    // Only header and trailer are real PDF, Base64 cost depends on size alone. Seeded noise keeps files equal between runs.
+    static const ANSICHAR Header[] = "%PDF-1.4\n";
+    static const ANSICHAR Trailer[] = "\n%%EOF\n";
+
+    const int64 HeaderSize = UE_ARRAY_COUNT(Header) - 1;
+    const int64 TrailerSize = UE_ARRAY_COUNT(Trailer) - 1;
+
+    if (FileHandle->Write(reinterpret_cast<const uint8*>(Header), HeaderSize) == false)
+    {
+        return false;
+    }
+
+    FRandomStream RandomStream(int32(Size));
+    TArray<uint8> Chunk;
+    Chunk.SetNumUninitialized(1024 * 1024);
+
+    for (int64 Remaining = FMath::Max<int64>(Size - HeaderSize - TrailerSize, 0); Remaining > 0;)
+    {
+        const int32 ChunkSize = int32(FMath::Min<int64>(Remaining, Chunk.Num()));
+
+        for (int32 ByteIndex = 0; ByteIndex < ChunkSize; ByteIndex++)
+        {
+            Chunk[ByteIndex] = uint8(RandomStream.GetUnsignedInt());
+        }
+
+        if (FileHandle->Write(Chunk.GetData(), ChunkSize) == false)
+        {
+            return false;
+        }
+
+        Remaining -= ChunkSize;
+    }
+
+    return FileHandle->Write(reinterpret_cast<const uint8*>(Trailer), TrailerSize);
+}
+
+void UFileConvertersBenchmarkCommandlet::SpawnScene(UWorld* World, int32 ActorCount, TSet<AActor*>& OutActors)
+{
+    using namespace FileConvertersBenchmark;
+
+    TArray<UStaticMesh*> Array_Meshes;
+    for (const TCHAR* EachPath : MeshPaths)
+    {
+        if (UStaticMesh* Mesh = LoadObject<UStaticMesh>(nullptr, EachPath))
+        {
+            Array_Meshes.Add(Mesh);
+        }
+    }
+
+    const int32 GridSize = FMath::Max(FMath::CeilToInt(FMath::Sqrt(float(ActorCount))), 1);
+    constexpr float Spacing = 200.0f;
+
+    FRandomStream RandomStream(ActorCount);
+    AActor* LastRoot = nullptr;
+
+    OutActors.Reset();
+    OutActors.Reserve(ActorCount);
+
+    for (int32 ActorIndex = 0; ActorIndex < ActorCount; ActorIndex++)
+    {
+        const FVector Location((ActorIndex % GridSize) * Spacing, (ActorIndex / GridSize) * Spacing, RandomStream.FRandRange(0.0f, 100.0f));
+        const FRotator Rotation(0.0f, RandomStream.FRandRange(0.0f, 360.0f), 0.0f);
+
+        AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, Rotation);
+
+        if (Actor == nullptr)
+        {
+            continue;
+        }
+
+        UStaticMeshComponent* MeshComponent = Actor->GetStaticMeshComponent();
+        MeshComponent->SetMobility(EComponentMobility::Movable);
+
+        if (Array_Meshes.Num() > 0)
+        {
+            MeshComponent->SetStaticMesh(Array_Meshes[ActorIndex % Array_Meshes.Num()]);
+        }
+
+        Actor->SetActorScale3D(FVector(RandomStream.FRandRange(0.5f, 2.0f)));
+
+        // Every fourth actor is a child, so attach roots and nested transforms are exercised.
+        if (ActorIndex % 4 != 0 && LastRoot != nullptr)
+        {
+            Actor->AttachToActor(LastRoot, FAttachmentTransformRules::KeepWorldTransform);
+        }
+
+        else
+        {
+            LastRoot = Actor;
+        }
+
+        OutActors.Add(Actor);
+    }
+}
+
+void UFileConvertersBenchmarkCommandlet::RunGenerate(const FString& Label, TFunctionRef<bool()> Generate, int64 Items)
+{
+    UE_LOG(LogFileConverters, Display, TEXT("Benchmark: %s"), *Label);
+
+    FScenario& Scenario = BeginScenario(Label);
+    Scenario.Items = Items;
+
+    const double StartTime = FPlatformTime::Seconds();
+    Scenario.bIsSuccessful = Generate();
+    Scenario.Samples.Add(FPlatformTime::Seconds() - StartTime);
+
+    if (Scenario.bIsSuccessful == false)
+    {
+        Scenario.ErrorCode = "Synthetic data can't be generated.";
+        UE_LOG(LogFileConverters, Error, TEXT("Benchmark: %s failed."), *Label);
+    }
+
+    EndScenario(Scenario);
+}
+
+void UFileConvertersBenchmarkCommandlet::RunSearch(const FString& RootPath, const FString& Label, int64 FileCount, int32 Iterations)
+{
+    using namespace FileConvertersBenchmark;
+
+    UE_LOG(LogFileConverters, Display, TEXT("Benchmark: %s"), *Label);
+
+    FScenario& Scenario = BeginScenario(Label);
+    Scenario.Items = FileCount;
+
+    FDelegateSearch DelegateSearch;
+    DelegateSearch.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UFileConvertersBenchmarkCommandlet, OnSearchDone));
+
+    for (int32 Iteration = 0; Iteration < Iterations && Scenario.bIsSuccessful == true; Iteration++)
+    {
+        bIsCallbackDone = false;
+
+        const double StartTime = FPlatformTime::Seconds();
+        UFileConvertersBPLibrary::SearchInFolder(DelegateSearch, RootPath, NeedleText, false);
+
+        if (WaitFor(bIsCallbackDone, CallbackTimeout) == false || bIsCallbackSuccessful == false)
+        {
+            Scenario.bIsSuccessful = false;
+            Scenario.ErrorCode = bIsCallbackDone == true ? CallbackError : TEXT("Search timed out.");
+            break;
+        }
+
+        Scenario.Samples.Add(FPlatformTime::Seconds() - StartTime);
+        Scenario.ResultCount = CallbackItemCount;
+    }
+
+    EndScenario(Scenario);
+}
+
+void UFileConvertersBenchmarkCommandlet::RunListing(const FString& FolderPath, const FString& Label, int32 Iterations)
+{
+    UE_LOG(LogFileConverters, Display, TEXT("Benchmark: %s"), *Label);
+
+    // Cold listings ask the disk every time, warm ones are served from listing cache.
+    for (const bool bIsWarm : { false, true })
+    {
+        FScenario& Scenario = BeginScenario(Label + (bIsWarm == true ? TEXT(".Warm") : TEXT(".Cold")));
+
+        TArray<FFolderContent> Array_Contents;
+        FString ErrorCode;
+
+        UFileConvertersBPLibrary::ClearListingCache();
+
+        if (bIsWarm == true)
+        {
+            UFileConvertersBPLibrary::GetFolderContents(Array_Contents, ErrorCode, FolderPath);
+        }
+
+        for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+        {
+            if (bIsWarm == false)
+            {
+                UFileConvertersBPLibrary::ClearListingCache();
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+
+            if (UFileConvertersBPLibrary::GetFolderContents(Array_Contents, ErrorCode, FolderPath) == false)
+            {
+                Scenario.bIsSuccessful = false;
+                Scenario.ErrorCode = ErrorCode;
+                break;
+            }
+
+            Scenario.Samples.Add(FPlatformTime::Seconds() - StartTime);
+            Scenario.Items = Array_Contents.Num();
+            Scenario.ResultCount = Array_Contents.Num();
+        }
+
+        EndScenario(Scenario);
+    }
+}
+
+void UFileConvertersBenchmarkCommandlet::RunPDF(const FString& PDFPath, int64 Size, int32 Iterations)
+{
+    using namespace FileConvertersBenchmark;
+
+    const FString HTML_Template = FString::Printf(TEXT("<!DOCTYPE html><html><body><script>const pdfData = atob(\"%s\");</script></body></html>"), DummyText);
+    const FString SizeLabel = FString::Printf(TEXT("%lldMB"), Size / (1024 * 1024));
+
+    TArray<uint8> Array_PDFBytes;
+
+    // File mode streams from disk, bytes mode encodes a buffer already in memory.
+    for (const bool bUseBytes : { false, true })
+    {
+        const FString Label = FString::Printf(TEXT("CreatePDFViewer.%s.%s"), bUseBytes == true ? TEXT("Bytes") : TEXT("File"), *SizeLabel);
+        UE_LOG(LogFileConverters, Display, TEXT("Benchmark: %s"), *Label);
+
+        if (bUseBytes == true && FFileHelper::LoadFileToArray(Array_PDFBytes, *PDFPath) == false)
+        {
+            FScenario& Scenario = BeginScenario(Label);
+            Scenario.bIsSuccessful = false;
+            Scenario.ErrorCode = "PDF can't be read.";
+            EndScenario(Scenario);
+            continue;
+        }
+
+        FScenario& Scenario = BeginScenario(Label);
+        Scenario.Items = 1;
+        Scenario.Bytes = Size;
+
+        for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+        {
+            const double StartTime = FPlatformTime::Seconds();
+            const FString HTML_Content = UFileConvertersBPLibrary::CreatePDFViewer(HTML_Template, PDFPath, Array_PDFBytes, DummyText, bUseBytes);
+            Scenario.Samples.Add(FPlatformTime::Seconds() - StartTime);
+
+            if (HTML_Content.Len() <= HTML_Template.Len())
+            {
+                Scenario.bIsSuccessful = false;
+                Scenario.ErrorCode = "PDF isn't embedded.";
+                break;
+            }
+
+            Scenario.ResultCount = HTML_Content.Len();
+        }
+
+        EndScenario(Scenario);
+        Array_PDFBytes.Empty();
+    }
+}
+
+void UFileConvertersBenchmarkCommandlet::RunExport(const FString& WorkDir, int32 ActorCount, int32 Iterations)
+{
+    using namespace FileConvertersBenchmark;
+
+    const FString Label = FString::Printf(TEXT("ExportLevelGLTF.%dActors"), ActorCount);
+    UE_LOG(LogFileConverters, Display, TEXT("Benchmark: %s"), *Label);
+
+    // Exporter takes the current play world, commandlets don't have one until a game world context is added.
+    UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("FileConvertersBenchmark"));
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    TSet<AActor*> Set_Actors;
+    SpawnScene(World, ActorCount, Set_Actors);
+
+    const FString ExportPath = WorkDir / FString::Printf(TEXT("Export/Scene_%d.glb"), ActorCount);
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(ExportPath));
+
+    FScenario& Scenario = BeginScenario(Label);
+    Scenario.Items = Set_Actors.Num();
+
+    FDelegateGLTFExport DelegateGLTFExport;
+    DelegateGLTFExport.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UFileConvertersBenchmarkCommandlet, OnExportDone));
+
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+    {
+        bIsCallbackDone = false;
+
+        const double StartTime = FPlatformTime::Seconds();
+        UFileConvertersBPLibrary::ExportLevelGLTF(false, false, false, false, ExportPath, Set_Actors, DelegateGLTFExport, true);
+
+        if (WaitFor(bIsCallbackDone, CallbackTimeout) == false || bIsCallbackSuccessful == false)
+        {
+            Scenario.bIsSuccessful = false;
+            Scenario.ErrorCode = bIsCallbackDone == true ? CallbackError : TEXT("Export timed out.");
+            break;
+        }
+
+        Scenario.Samples.Add(FPlatformTime::Seconds() - StartTime);
+        Scenario.Bytes = FPlatformFileManager::Get().GetPlatformFile().FileSize(*ExportPath);
+        Scenario.ResultCount = Scenario.Bytes;
+
+        // Export options and builder leftovers of an iteration shouldn't count against the next one.
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    EndScenario(Scenario);
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+bool UFileConvertersBenchmarkCommandlet::WaitFor(const bool& bIsDone, double TimeoutSeconds)
+{
+    const double StartTime = FPlatformTime::Seconds();
+
+    while (bIsDone == false)
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+        if (bIsDone == true)
+        {
+            break;
+        }
+
+        if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+        {
+            return false;
+        }
+
+        FPlatformProcess::Sleep(0.0f);
+    }
+
+    return true;
+}
+
+UFileConvertersBenchmarkCommandlet::FScenario& UFileConvertersBenchmarkCommandlet::BeginScenario(const FString& Name)
+{
+    FScenario& Scenario = Scenarios.AddDefaulted_GetRef();
+    Scenario.Name = Name;
+    Scenario.UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+    return Scenario;
+}
+
+void UFileConvertersBenchmarkCommandlet::EndScenario(FScenario& Scenario)
+{
+    const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+    Scenario.UsedPhysicalAfter = MemoryStats.UsedPhysical;
+    Scenario.PeakUsedPhysical = MemoryStats.PeakUsedPhysical;
+}
+
+TSharedRef<FJsonObject> UFileConvertersBenchmarkCommandlet::MakeReport(const TMap<FString, FString>& Config) const
+{
+    using namespace FileConvertersBenchmark;
+
+    const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("schemaVersion"), 1);
+
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("FileConverters"));
+    Report->SetStringField(TEXT("pluginVersion"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString());
+    Report->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+    Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+    Report->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Report->SetNumberField(TEXT("logicalCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    Report->SetNumberField(TEXT("totalPhysicalMB"), double(FPlatformMemory::GetConstants().TotalPhysical) / BytesPerMegabyte);
+    Report->SetStringField(TEXT("timestampUtc"), FDateTime::UtcNow().ToIso8601());
+
+    const TSharedRef<FJsonObject> ConfigObject = MakeShared<FJsonObject>();
+    for (const TPair<FString, FString>& EachPair : Config)
+    {
+        ConfigObject->SetStringField(EachPair.Key, EachPair.Value);
+    }
+
+    Report->SetObjectField(TEXT("config"), ConfigObject);
+
+    TArray<TSharedPtr<FJsonValue>> Array_ScenarioValues;
+    for (const FScenario& EachScenario : Scenarios)
+    {
+        TArray<double> Array_Sorted = EachScenario.Samples;
+        Array_Sorted.Sort();
+
+        double TotalSeconds = 0;
+        for (const double EachSample : Array_Sorted)
+        {
+            TotalSeconds += EachSample;
+        }
+
+        const double MeanSeconds = Array_Sorted.Num() > 0 ? TotalSeconds / Array_Sorted.Num() : 0.0;
+
+        const TSharedRef<FJsonObject> ScenarioObject = MakeShared<FJsonObject>();
+        ScenarioObject->SetStringField(TEXT("name"), EachScenario.Name);
+        ScenarioObject->SetBoolField(TEXT("successful"), EachScenario.bIsSuccessful);
+        ScenarioObject->SetStringField(TEXT("errorCode"), EachScenario.ErrorCode);
+        ScenarioObject->SetNumberField(TEXT("iterations"), Array_Sorted.Num());
+        ScenarioObject->SetNumberField(TEXT("items"), double(EachScenario.Items));
+        ScenarioObject->SetNumberField(TEXT("bytes"), double(EachScenario.Bytes));
+        ScenarioObject->SetNumberField(TEXT("resultCount"), double(EachScenario.ResultCount));
+        ScenarioObject->SetNumberField(TEXT("minMs"), Array_Sorted.Num() > 0 ? Array_Sorted[0] * 1000.0 : 0.0);
+        ScenarioObject->SetNumberField(TEXT("meanMs"), MeanSeconds * 1000.0);
+        ScenarioObject->SetNumberField(TEXT("p50Ms"), GetPercentile(Array_Sorted, 50) * 1000.0);
+        ScenarioObject->SetNumberField(TEXT("p90Ms"), GetPercentile(Array_Sorted, 90) * 1000.0);
+        ScenarioObject->SetNumberField(TEXT("p99Ms"), GetPercentile(Array_Sorted, 99) * 1000.0);
+        ScenarioObject->SetNumberField(TEXT("maxMs"), Array_Sorted.Num() > 0 ? Array_Sorted.Last() * 1000.0 : 0.0);
+        ScenarioObject->SetNumberField(TEXT("itemsPerSecond"), MeanSeconds > 0 ? double(EachScenario.Items) / MeanSeconds : 0.0);
+        ScenarioObject->SetNumberField(TEXT("megabytesPerSecond"), MeanSeconds > 0 ? double(EachScenario.Bytes) / BytesPerMegabyte / MeanSeconds : 0.0);
+        ScenarioObject->SetNumberField(TEXT("usedPhysicalBeforeMB"), double(EachScenario.UsedPhysicalBefore) / BytesPerMegabyte);
+        ScenarioObject->SetNumberField(TEXT("usedPhysicalAfterMB"), double(EachScenario.UsedPhysicalAfter) / BytesPerMegabyte);
+
+        // Process high water mark, it only grows. A scenario raised the peak if it is above the previous one.
+        ScenarioObject->SetNumberField(TEXT("processPeakUsedPhysicalMB"), double(EachScenario.PeakUsedPhysical) / BytesPerMegabyte);
+
+        Array_ScenarioValues.Add(MakeShared<FJsonValueObject>(ScenarioObject));
+    }
+
+    Report->SetArrayField(TEXT("scenarios"), Array_ScenarioValues);
+
+    TArray<TSharedPtr<FJsonValue>> Array_MetricValues;
+    FFileConvertersMetrics::Get().GetJsonValues(Array_MetricValues);
+
+    Report->SetArrayField(TEXT("phaseMetrics"), Array_MetricValues);
+
+    return Report;
+}
+
+void UFileConvertersBenchmarkCommandlet::OnSearchDone(bool bIsSearchSuccessful, FString ErrorCode, FContentArrayContainer Out)
+{
+    bIsCallbackDone = true;
+    bIsCallbackSuccessful = bIsSearchSuccessful;
+    CallbackItemCount = Out.OutContents.Num();
+    CallbackError = ErrorCode;
+}
+
+void UFileConvertersBenchmarkCommandlet::OnExportDone(bool bIsSuccessfull, FGLTFExportMessages OutMessages)
+{
+    bIsCallbackDone = true;
+    bIsCallbackSuccessful = bIsSuccessfull;
+    CallbackItemCount = 0;
+    CallbackError = OutMessages.Errors.Num() > 0 ? OutMessages.Errors[0] : FString("Export failed.");
+}
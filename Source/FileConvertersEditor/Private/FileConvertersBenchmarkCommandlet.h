@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "FileConvertersBPLibrary.h"
+
+#include "FileConvertersBenchmarkCommandlet.generated.h"
+
+class FJsonObject;
+
+/*
+*	Headless benchmark of plugin hot paths. Runs without a viewport, so it works on Linux build machines.
+*	Generates synthetic folder trees, PDFs and actor scenes under WorkDir, then measures Search In Folder, Get Folder Contents, Create PDF Viewer and Export Level As GLTF.
+*	Results are written as JSON, so runs of different plugin versions can be diffed.
+*
+*	UnrealEditor-Cmd <Project> -run=FileConvertersBenchmark [-Output=<json>] [-WorkDir=<folder>] [-Iterations=5] [-FlatFiles=300000] [-DeepFiles=2000000]
+*	[-DeepFanout=8] [-DeepDepth=4] [-PDFSizesMB=1,16,128] [-SceneActors=500,5000] [-Scenarios=Search,Listing,PDF,Export] [-CleanData]
+*
+*	Generated trees are reused by later runs if their file count matches. -CleanData removes WorkDir after the run.
+*	Returns 0 if every scenario succeeded.
+*/
+UCLASS()
+class UFileConvertersBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UFileConvertersBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	struct FScenario
+	{
+		FString Name;
+		TArray<double> Samples;
+
+		/* Per iteration. Throughput is derived from these and mean duration. */
+		int64 Items = 0;
+		int64 Bytes = 0;
+
+		/* Found entries or output size of last iteration, to check that versions did the same work. */
+		int64 ResultCount = 0;
+
+		int64 UsedPhysicalBefore = 0;
+		int64 UsedPhysicalAfter = 0;
+		int64 PeakUsedPhysical = 0;
+
+		bool bIsSuccessful = true;
+		FString ErrorCode = "Success";
+	};
+
+	/* Returns false if tree can't be created. Existing tree with same file count is kept. */
+	static bool GenerateTree(const FString& RootPath, int64 FileCount, int32 Fanout, int32 Depth);
+
+	static bool GeneratePDF(const FString& FilePath, int64 Size);
+
+	/* Spawns static mesh actors in a grid with attached children, meshes repeat so instancing and dedupe have work. */
+	static void SpawnScene(UWorld* World, int32 ActorCount, TSet<AActor*>& OutActors);
+
+	void RunGenerate(const FString& Label, TFunctionRef<bool()> Generate, int64 Items);
+	void RunSearch(const FString& RootPath, const FString& Label, int64 FileCount, int32 Iterations);
+	void RunListing(const FString& FolderPath, const FString& Label, int32 Iterations);
+	void RunPDF(const FString& PDFPath, int64 Size, int32 Iterations);
+	void RunExport(const FString& WorkDir, int32 ActorCount, int32 Iterations);
+
+	/* Processes game thread tasks until flag is set. Returns false on timeout. */
+	static bool WaitFor(const bool& bIsDone, double TimeoutSeconds);
+
+	FScenario& BeginScenario(const FString& Name);
+	static void EndScenario(FScenario& Scenario);
+
+	TSharedRef<FJsonObject> MakeReport(const TMap<FString, FString>& Config) const;
+
+	UFUNCTION()
+	void OnSearchDone(bool bIsSearchSuccessful, FString ErrorCode, FContentArrayContainer Out);
+
+	UFUNCTION()
+	void OnExportDone(bool bIsSuccessfull, FGLTFExportMessages OutMessages);
+
+	TArray<FScenario> Scenarios;
+
+	bool bIsCallbackDone = false;
+	bool bIsCallbackSuccessful = false;
+	int64 CallbackItemCount = 0;
+	FString CallbackError;
+};
@@ -0,0 +1,602 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "FileConvertersConvertFolderCommandlet.h"
+#include "FileConverters.h"
+#include "FileConvertersGLTF.h"
+#include "FileConvertersMatcher.h"
+#include "FileConvertersSearch.h"
+#include "FileConvertersStats.h"
+
+// UE Includes.
+#include "Async/TaskGraphInterfaces.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/PlatformFileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace FileConvertersConvertFolder
+{
+    static constexpr double BytesPerMegabyte = 1024.0 * 1024.0;
+
+    // Without async loading thread, loads only advance in these slices between exports.
+    static constexpr float LoadSliceSeconds = 0.005f;
+
+    // Read ahead block of one file. Bytes are dropped after each block.
+    static constexpr int64 PrefetchBlockSize = 4 * 1024 * 1024;
+
+    // Meshes leave little behind, they are collected in batches. Worlds are collected after each export.
+    static constexpr int32 CollectInterval = 16;
+
+    // Cooked and editor packages may split into these next to the package file.
+    static const TCHAR* CompanionExtensions[] = { TEXT("uexp"), TEXT("ubulk"), TEXT("uptnl") };
+
+    static const TCHAR* GetStateName(uint8 State)
+    {
+        static const TCHAR* StateNames[] = { TEXT("Pending"), TEXT("Loading"), TEXT("Loaded"), TEXT("Succeeded"), TEXT("Failed"), TEXT("Skipped") };
+        return State < UE_ARRAY_COUNT(StateNames) ? StateNames[State] : TEXT("Unknown");
+    }
+}
+
+UFileConvertersConvertFolderCommandlet::UFileConvertersConvertFolderCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UFileConvertersConvertFolderCommandlet::Main(const FString& Params)
+{
+    using namespace FileConvertersConvertFolder;
+
+    FString InputPath;
+    FString OutputPath;
+    FString ReportPath;
+    FString ExtensionList = TEXT("umap,uasset");
+    FString Pattern;
+    int32 MaxInFlightMB = 2048;
+
+    FParse::Value(*Params, TEXT("Input="), InputPath);
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+    FParse::Value(*Params, TEXT("Report="), ReportPath);
+    FParse::Value(*Params, TEXT("Extensions="), ExtensionList, false);
+    FParse::Value(*Params, TEXT("Pattern="), Pattern);
+    FParse::Value(*Params, TEXT("MaxInFlight="), MaxInFlight);
+    FParse::Value(*Params, TEXT("MaxInFlightMB="), MaxInFlightMB);
+
+    bEnableQuantization = FParse::Param(*Params, TEXT("Quantize"));
+
+    if (InputPath.IsEmpty() == true || OutputPath.IsEmpty() == true)
+    {
+        UE_LOG(LogFileConverters, Error, TEXT("Convert folder needs -Input=<folder> and -Output=<folder>."));
+        return 1;
+    }
+
+    // Long package paths like /Game/Models are accepted too. On Linux a disk path starts with a slash as well, so an existing folder wins.
+    FString InputFolder = InputPath;
+    if (FPaths::DirectoryExists(InputPath) == false)
+    {
+        FPackageName::TryConvertLongPackageNameToFilename(InputPath / TEXT(""), InputFolder);
+    }
+
+    InputFolder = FPaths::ConvertRelativePathToFull(InputFolder);
+    const FString OutputFolder = FPaths::ConvertRelativePathToFull(OutputPath);
+    ReportPath = ReportPath.IsEmpty() ? OutputFolder / TEXT("ConversionReport.json") : FPaths::ConvertRelativePathToFull(ReportPath);
+
+    MaxInFlight = FMath::Max(MaxInFlight, 1);
+    MaxInFlightBytes = int64(FMath::Max(MaxInFlightMB, 1)) * 1024 * 1024;
+
+    TArray<FString> Array_Extensions;
+    ExtensionList.ParseIntoArray(Array_Extensions, TEXT(","), true);
+
+    TMap<FString, FString> Config;
+    Config.Add(TEXT("input"), InputFolder);
+    Config.Add(TEXT("output"), OutputFolder);
+    Config.Add(TEXT("extensions"), ExtensionList);
+    Config.Add(TEXT("pattern"), Pattern);
+    Config.Add(TEXT("maxInFlight"), FString::FromInt(MaxInFlight));
+    Config.Add(TEXT("maxInFlightMB"), FString::FromInt(MaxInFlightMB));
+    Config.Add(TEXT("quantize"), bEnableQuantization ? TEXT("true") : TEXT("false"));
+
+    FFileConvertersMetrics::Get().Reset();
+
+    const double SearchStartTime = FPlatformTime::Seconds();
+
+    FString ErrorCode;
+    if (FindItems(InputFolder, OutputFolder, Pattern, Array_Extensions, ErrorCode) == false)
+    {
+        UE_LOG(LogFileConverters, Error, TEXT("Convert folder: %s"), *ErrorCode);
+        return 1;
+    }
+
+    const double PipelineStartTime = FPlatformTime::Seconds();
+    const double SearchSeconds = PipelineStartTime - SearchStartTime;
+
+    UE_LOG(LogFileConverters, Display, TEXT("Convert folder: %d assets found in %s"), Items.Num(), *InputFolder);
+
+    bIsAsyncLoadingThreaded = IsAsyncLoadingMultithreaded();
+
+    if (bIsAsyncLoadingThreaded == false)
+    {
+        UE_LOG(LogFileConverters, Display, TEXT("Convert folder: async loading thread is off, loads advance only between exports. Package files are read ahead while exporting."));
+    }
+
+    while (true)
+    {
+        StartLoads();
+        StartPrefetches();
+        PollPrefetches(false);
+
+        ProcessAsyncLoading(true, false, LoadSliceSeconds);
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+
+        // Exporting keeps game thread busy while requested loads go on.
+        if (LoadedItems.IsEmpty() == false)
+        {
+            const int32 ItemIndex = LoadedItems[0];
+            LoadedItems.RemoveAt(0);
+
+            Export(ItemIndex);
+            continue;
+        }
+
+        if (InFlightCount == 0 && NextItem >= Items.Num())
+        {
+            break;
+        }
+
+        FPlatformProcess::Sleep(0.0f);
+    }
+
+    PollPrefetches(true);
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+    const TSharedRef<FJsonObject> Report = MakeReport(Config, SearchSeconds, FPlatformTime::Seconds() - PipelineStartTime);
+
+    FString ReportText;
+    const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&ReportText);
+    FJsonSerializer::Serialize(Report, JsonWriter);
+
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(ReportPath));
+
+    bool bIsAllSuccessful = FFileHelper::SaveStringToFile(ReportText, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+
+    if (bIsAllSuccessful == false)
+    {
+        UE_LOG(LogFileConverters, Error, TEXT("Conversion report can't be written to %s"), *ReportPath);
+    }
+
+    else
+    {
+        UE_LOG(LogFileConverters, Display, TEXT("Conversion report is written to %s"), *ReportPath);
+    }
+
+    for (const FItem& EachItem : Items)
+    {
+        bIsAllSuccessful &= EachItem.State != EItemState::Failed;
+    }
+
+    return bIsAllSuccessful == true ? 0 : 1;
+}
+
+bool UFileConvertersConvertFolderCommandlet::FindItems(const FString& InputFolder, const FString& OutputFolder, const FString& Pattern, const TArray<FString>& Extensions, FString& ErrorCode)
+{
+    using namespace FileConvertersConvertFolder;
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    if (PlatformFile.DirectoryExists(*InputFolder) == false)
+    {
+        ErrorCode = "Input folder doesn't exist.";
+        return false;
+    }
+
+    FFileSearchQuery Query;
+    Query.Pattern = Pattern;
+    Query.Extensions = Extensions;
+
+    const FFileConvertersMatcher Matcher(Query);
+    const int32 WorkerCount = FFileConvertersWalker::GetDefaultWorkerCount();
+
+    TArray<TArray<FFolderContent>> Array_WorkerFounds;
+    Array_WorkerFounds.SetNum(WorkerCount);
+
+    FFileConvertersWalker::Walk(InputFolder, WorkerCount, [&Array_WorkerFounds, &Matcher](int32 WorkerIndex, const TCHAR* CharPath, const FFileStatData& StatData)
+        {
+            const FStringView PathView(CharPath);
+            const FStringView CleanName = FFileConvertersSearch::GetCleanName(PathView);
+
+            int32 Score = 0;
+            if (Matcher.Matches(CleanName, StatData.bIsDirectory, Score) == false)
+            {
+                return;
+            }
+
+            FFolderContent& EachContent = Array_WorkerFounds[WorkerIndex].AddDefaulted_GetRef();
+            EachContent.Name = FString(CleanName.Len(), CleanName.GetData());
+            EachContent.Path = FString(PathView.Len(), PathView.GetData());
+            FFileConvertersSearch::SetStat(EachContent, StatData);
+        }
+    );
+
+    TArray<FFolderContent> Array_Founds;
+    for (TArray<FFolderContent>& EachWorkerFounds : Array_WorkerFounds)
+    {
+        Array_Founds.Append(MoveTemp(EachWorkerFounds));
+    }
+
+    // Walk order depends on workers, reports of two runs should list files the same way.
+    Array_Founds.Sort([](const FFolderContent& A, const FFolderContent& B) { return A.Path < B.Path; });
+
+    const FString InputRoot = InputFolder / TEXT("");
+
+    Items.Reset(Array_Founds.Num());
+
+    for (const FFolderContent& EachFound : Array_Founds)
+    {
+        FItem& Item = Items.AddDefaulted_GetRef();
+        Item.FilePath = EachFound.Path;
+        Item.InputBytes = EachFound.Size;
+
+        for (const TCHAR* EachExtension : CompanionExtensions)
+        {
+            Item.InputBytes += FMath::Max<int64>(PlatformFile.FileSize(*FPaths::ChangeExtension(EachFound.Path, EachExtension)), 0);
+        }
+
+        FString RelativePath = EachFound.Path;
+        FPaths::MakePathRelativeTo(RelativePath, *InputRoot);
+        Item.OutputPath = FPaths::ChangeExtension(OutputFolder / RelativePath, TEXT("glb"));
+
+        if (FPackageName::TryConvertFilenameToLongPackageName(EachFound.Path, Item.PackageName) == false)
+        {
+            Item.State = EItemState::Failed;
+            Item.ErrorCode = "File isn't under a mounted content folder.";
+        }
+    }
+
+    ErrorCode = "Success";
+    return true;
+}
+
+void UFileConvertersConvertFolderCommandlet::StartLoads()
+{
+    while (NextItem < Items.Num() && InFlightCount < MaxInFlight)
+    {
+        FItem& Item = Items[NextItem];
+
+        if (Item.State != EItemState::Pending)
+        {
+            NextItem++;
+            continue;
+        }
+
+        if (InFlightCount > 0 && InFlightBytes + Item.InputBytes > MaxInFlightBytes)
+        {
+            break;
+        }
+
+        const int32 ItemIndex = NextItem++;
+
+        Item.State = EItemState::Loading;
+        Item.LoadStartTime = FPlatformTime::Seconds();
+
+        InFlightCount++;
+        InFlightBytes += Item.InputBytes;
+        PeakInFlightCount = FMath::Max(PeakInFlightCount, InFlightCount);
+        PeakInFlightBytes = FMath::Max(PeakInFlightBytes, InFlightBytes);
+
+        LoadPackageAsync(Item.PackageName, FLoadPackageAsyncDelegate::CreateLambda([this, ItemIndex](const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+            {
+                OnLoaded(ItemIndex, LoadedPackage, Result == EAsyncLoadingResult::Succeeded);
+            }
+        ));
+    }
+}
+
+void UFileConvertersConvertFolderCommandlet::StartPrefetches()
+{
+    using namespace FileConvertersConvertFolder;
+
+    // Async loading thread reads packages itself while game thread exports.
+    if (bIsAsyncLoadingThreaded == true)
+    {
+        return;
+    }
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    // One load window ahead, so bytes are in file cache when loads of these items advance.
+    while (NextPrefetchItem < Items.Num() && NextPrefetchItem < NextItem + MaxInFlight)
+    {
+        const FItem& Item = Items[NextPrefetchItem++];
+
+        if (Item.State != EItemState::Pending && Item.State != EItemState::Loading)
+        {
+            continue;
+        }
+
+        TArray<FString> Array_Paths = { Item.FilePath };
+        for (const TCHAR* EachExtension : CompanionExtensions)
+        {
+            Array_Paths.Add(FPaths::ChangeExtension(Item.FilePath, EachExtension));
+        }
+
+        for (const FString& EachPath : Array_Paths)
+        {
+            const int64 FileSize = PlatformFile.FileSize(*EachPath);
+
+            if (FileSize <= 0)
+            {
+                continue;
+            }
+
+            IAsyncReadFileHandle* Handle = PlatformFile.OpenAsyncRead(*EachPath);
+
+            if (Handle == nullptr)
+            {
+                continue;
+            }
+
+            FPrefetch& Prefetch = Prefetches.AddDefaulted_GetRef();
+            Prefetch.Handle.Reset(Handle);
+            Prefetch.Size = FileSize;
+        }
+    }
+}
+
+void UFileConvertersConvertFolderCommandlet::PollPrefetches(bool bWait)
+{
+    using namespace FileConvertersConvertFolder;
+
+    for (int32 Index = Prefetches.Num() - 1; Index >= 0; Index--)
+    {
+        FPrefetch& Prefetch = Prefetches[Index];
+
+        if (Prefetch.Request != nullptr)
+        {
+            if (bWait == false && Prefetch.Request->PollCompletion() == false)
+            {
+                continue;
+            }
+
+            // Deleting request frees its block.
+            Prefetch.Request->WaitCompletion();
+            delete Prefetch.Request;
+            Prefetch.Request = nullptr;
+        }
+
+        // Handle is closed after its last request is deleted.
+        if (bWait == true || Prefetch.Offset >= Prefetch.Size)
+        {
+            Prefetches.RemoveAtSwap(Index);
+            continue;
+        }
+
+        const int64 BlockSize = FMath::Min(PrefetchBlockSize, Prefetch.Size - Prefetch.Offset);
+        Prefetch.Request = Prefetch.Handle->ReadRequest(Prefetch.Offset, BlockSize, AIOP_Low);
+        Prefetch.Offset += BlockSize;
+        PrefetchedBytes += BlockSize;
+    }
+}
+
+void UFileConvertersConvertFolderCommandlet::OnLoaded(int32 ItemIndex, UPackage* LoadedPackage, bool bIsLoaded)
+{
+    FItem& Item = Items[ItemIndex];
+    Item.LoadSeconds = FPlatformTime::Seconds() - Item.LoadStartTime;
+
+    UObject* Asset = nullptr;
+
+    if (bIsLoaded == true && LoadedPackage != nullptr)
+    {
+        // Map packages hold their world next to other objects, asset packages have one main asset.
+        Asset = UWorld::FindWorldInPackage(LoadedPackage);
+        Asset = Asset != nullptr ? Asset : LoadedPackage->FindAssetInPackage();
+    }
+
+    if (Asset == nullptr)
+    {
+        Release(Item, EItemState::Failed, TEXT("Package can't be loaded."));
+        return;
+    }
+
+    Item.AssetClass = Asset->GetClass()->GetName();
+
+    if (Asset->IsA<UWorld>() == false && Asset->IsA<UStaticMesh>() == false && Asset->IsA<USkeletalMesh>() == false)
+    {
+        Release(Item, EItemState::Skipped, TEXT("Asset type isn't converted."));
+        return;
+    }
+
+    Item.Asset.Reset(Asset);
+    Item.State = EItemState::Loaded;
+    LoadedItems.Add(ItemIndex);
+}
+
+void UFileConvertersConvertFolderCommandlet::Export(int32 ItemIndex)
+{
+    using namespace FileConvertersConvertFolder;
+
+    FItem& Item = Items[ItemIndex];
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    PlatformFile.CreateDirectoryTree(*FPaths::GetPath(Item.OutputPath));
+
+    const double StartTime = FPlatformTime::Seconds();
+    UWorld* World = Cast<UWorld>(Item.Asset.Get());
+
+    FString ErrorCode;
+    bool bIsExported = false;
+
+    if (World != nullptr)
+    {
+        bIsExported = ExportWorld(World, Item.OutputPath, ErrorCode);
+    }
+
+    else
+    {
+        FGLTFExportMessages ExportMessages;
+
+        {
+            FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+            bIsExported = UGLTFExporter::ExportToGLTF(Item.Asset.Get(), Item.OutputPath, FFileConvertersGLTF::MakeExportOptions(bEnableQuantization), TSet<AActor*>(), ExportMessages);
+        }
+
+        ErrorCode = bIsExported == true ? TEXT("Success") : (ExportMessages.Errors.IsEmpty() == true ? TEXT("Export failed.") : ExportMessages.Errors[0]);
+    }
+
+    Item.ExportSeconds = FPlatformTime::Seconds() - StartTime;
+    Item.OutputBytes = bIsExported == true ? PlatformFile.FileSize(*Item.OutputPath) : 0;
+
+    Release(Item, bIsExported == true ? EItemState::Succeeded : EItemState::Failed, ErrorCode);
+
+    UE_LOG(LogFileConverters, Display, TEXT("Convert folder: %s %s (%.1f ms load, %.1f ms export)"), *Item.PackageName, GetStateName(uint8(Item.State)), Item.LoadSeconds * 1000.0, Item.ExportSeconds * 1000.0);
+
+    if (World != nullptr || ++ExportsSinceCollect >= CollectInterval)
+    {
+        ExportsSinceCollect = 0;
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+}
+
+bool UFileConvertersConvertFolderCommandlet::ExportWorld(UWorld* World, const FString& ExportPath, FString& ErrorCode) const
+{
+    // Loaded levels aren't initialized. Component transforms are only valid after components are registered.
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+    WorldContext.SetCurrentWorld(World);
+
+    World->WorldType = EWorldType::Editor;
+    World->InitWorld(UWorld::InitializationValues()
+        .AllowAudioPlayback(false)
+        .CreatePhysicsScene(false)
+        .RequiresHitProxies(false)
+        .CreateNavigation(false)
+        .CreateAISystem(false)
+        .ShouldSimulatePhysics(false)
+        .SetTransactional(false)
+    );
+    World->UpdateWorldComponents(true, false);
+
+    FGLTFExportMessages ExportMessages;
+    bool bIsExported = false;
+
+    {
+        FILECONVERTERS_PHASE_SCOPE(ExportBuild);
+
+        // No selected actors means whole level.
+        bIsExported = UGLTFExporter::ExportToGLTF(World, ExportPath, FFileConvertersGLTF::MakeExportOptions(bEnableQuantization), TSet<AActor*>(), ExportMessages);
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+
+    ErrorCode = bIsExported == true ? TEXT("Success") : (ExportMessages.Errors.IsEmpty() == true ? TEXT("Export failed.") : ExportMessages.Errors[0]);
+    return bIsExported;
+}
+
+void UFileConvertersConvertFolderCommandlet::Release(FItem& Item, EItemState FinalState, const FString& ErrorCode)
+{
+    Item.State = FinalState;
+    Item.ErrorCode = ErrorCode;
+    Item.Asset.Reset();
+
+    InFlightCount--;
+    InFlightBytes -= Item.InputBytes;
+}
+
+TSharedRef<FJsonObject> UFileConvertersConvertFolderCommandlet::MakeReport(const TMap<FString, FString>& Config, double SearchSeconds, double PipelineSeconds) const
+{
+    using namespace FileConvertersConvertFolder;
+
+    const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetNumberField(TEXT("schemaVersion"), 1);
+
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("FileConverters"));
+    Report->SetStringField(TEXT("pluginVersion"), Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString());
+    Report->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+    Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+    Report->SetStringField(TEXT("timestampUtc"), FDateTime::UtcNow().ToIso8601());
+
+    const TSharedRef<FJsonObject> ConfigObject = MakeShared<FJsonObject>();
+    for (const TPair<FString, FString>& EachPair : Config)
+    {
+        ConfigObject->SetStringField(EachPair.Key, EachPair.Value);
+    }
+
+    Report->SetObjectField(TEXT("config"), ConfigObject);
+
+    int32 SucceededCount = 0;
+    int32 FailedCount = 0;
+    int32 SkippedCount = 0;
+    int64 InputBytes = 0;
+    int64 OutputBytes = 0;
+    double LoadSeconds = 0;
+    double ExportSeconds = 0;
+
+    TArray<TSharedPtr<FJsonValue>> Array_FileValues;
+    for (const FItem& EachItem : Items)
+    {
+        SucceededCount += EachItem.State == EItemState::Succeeded ? 1 : 0;
+        FailedCount += EachItem.State == EItemState::Failed ? 1 : 0;
+        SkippedCount += EachItem.State == EItemState::Skipped ? 1 : 0;
+        InputBytes += EachItem.InputBytes;
+        OutputBytes += EachItem.OutputBytes;
+        LoadSeconds += EachItem.LoadSeconds;
+        ExportSeconds += EachItem.ExportSeconds;
+
+        const TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+        FileObject->SetStringField(TEXT("path"), EachItem.FilePath);
+        FileObject->SetStringField(TEXT("package"), EachItem.PackageName);
+        FileObject->SetStringField(TEXT("assetClass"), EachItem.AssetClass);
+        FileObject->SetStringField(TEXT("outputPath"), EachItem.State == EItemState::Succeeded ? EachItem.OutputPath : FString());
+        FileObject->SetStringField(TEXT("state"), GetStateName(uint8(EachItem.State)));
+        FileObject->SetStringField(TEXT("errorCode"), EachItem.ErrorCode);
+        FileObject->SetNumberField(TEXT("inputBytes"), double(EachItem.InputBytes));
+        FileObject->SetNumberField(TEXT("outputBytes"), double(EachItem.OutputBytes));
+
+        // Load time runs from request to completion, so it includes waiting behind earlier loads.
+        FileObject->SetNumberField(TEXT("loadMs"), EachItem.LoadSeconds * 1000.0);
+        FileObject->SetNumberField(TEXT("exportMs"), EachItem.ExportSeconds * 1000.0);
+
+        Array_FileValues.Add(MakeShared<FJsonValueObject>(FileObject));
+    }
+
+    const TSharedRef<FJsonObject> SummaryObject = MakeShared<FJsonObject>();
+    SummaryObject->SetNumberField(TEXT("fileCount"), Items.Num());
+    SummaryObject->SetNumberField(TEXT("succeeded"), SucceededCount);
+    SummaryObject->SetNumberField(TEXT("failed"), FailedCount);
+    SummaryObject->SetNumberField(TEXT("skipped"), SkippedCount);
+    SummaryObject->SetNumberField(TEXT("inputBytes"), double(InputBytes));
+    SummaryObject->SetNumberField(TEXT("outputBytes"), double(OutputBytes));
+    SummaryObject->SetNumberField(TEXT("searchMs"), SearchSeconds * 1000.0);
+    SummaryObject->SetNumberField(TEXT("pipelineMs"), PipelineSeconds * 1000.0);
+    SummaryObject->SetNumberField(TEXT("loadMs"), LoadSeconds * 1000.0);
+    SummaryObject->SetNumberField(TEXT("exportMs"), ExportSeconds * 1000.0);
+    SummaryObject->SetNumberField(TEXT("filesPerSecond"), PipelineSeconds > 0 ? double(SucceededCount) / PipelineSeconds : 0.0);
+    SummaryObject->SetNumberField(TEXT("inputMegabytesPerSecond"), PipelineSeconds > 0 ? double(InputBytes) / BytesPerMegabyte / PipelineSeconds : 0.0);
+    SummaryObject->SetBoolField(TEXT("asyncLoadingThread"), bIsAsyncLoadingThreaded);
+    SummaryObject->SetNumberField(TEXT("prefetchedBytes"), double(PrefetchedBytes));
+    SummaryObject->SetNumberField(TEXT("peakInFlight"), PeakInFlightCount);
+    SummaryObject->SetNumberField(TEXT("peakInFlightMB"), double(PeakInFlightBytes) / BytesPerMegabyte);
+    SummaryObject->SetNumberField(TEXT("processPeakUsedPhysicalMB"), double(FPlatformMemory::GetStats().PeakUsedPhysical) / BytesPerMegabyte);
+
+    Report->SetObjectField(TEXT("summary"), SummaryObject);
+    Report->SetArrayField(TEXT("files"), Array_FileValues);
+
+    TArray<TSharedPtr<FJsonValue>> Array_MetricValues;
+    FFileConvertersMetrics::Get().GetJsonValues(Array_MetricValues);
+
+    Report->SetArrayField(TEXT("phaseMetrics"), Array_MetricValues);
+
+    return Report;
+}
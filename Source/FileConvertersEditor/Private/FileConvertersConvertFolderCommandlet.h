@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/AsyncFileHandle.h"
+#include "Commandlets/Commandlet.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include "FileConvertersConvertFolderCommandlet.generated.h"
+
+class FJsonObject;
+class UPackage;
+class UWorld;
+
+/*
+*	Converts assets of a content folder to GLB files. Needs neither a viewport nor a play world, so it runs on headless build machines.
+*	Assets are found with plugin's folder walker. Loads of next assets are requested with LoadPackageAsync while an earlier one is exported, bounded by item count and package bytes in flight.
+*	Without async loading thread, requested loads only advance between exports. Package files of next items are then read ahead with async file reads while exporting, so loads find them in OS file cache.
+*	Levels are initialized in a world context of their own and exported with all actors, static and skeletal meshes are exported alone. Other asset types are skipped.
+*
+*	UnrealEditor-Cmd <Project> -run=FileConvertersConvertFolder -Input=<folder> -Output=<folder> [-Report=<json>] [-Extensions=umap,uasset] [-Pattern=<name>]
+*	[-MaxInFlight=4] [-MaxInFlightMB=2048] [-Quantize]
+*
+*	Input is a folder under a mounted content root, either a disk path or a long package path like /Game/Models. Output keeps folder structure of input.
+*	Report has timings and sizes of every file and totals for nightly tracking. Returns 0 if no asset failed.
+*/
+UCLASS()
+class UFileConvertersConvertFolderCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UFileConvertersConvertFolderCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	enum class EItemState : uint8
+	{
+		Pending,
+		Loading,
+		Loaded,
+		Succeeded,
+		Failed,
+		Skipped,
+	};
+
+	struct FItem
+	{
+		FString FilePath;
+		FString PackageName;
+		FString OutputPath;
+		FString AssetClass;
+
+		/* Package files on disk. Also the in flight memory estimate of the item. */
+		int64 InputBytes = 0;
+		int64 OutputBytes = 0;
+
+		EItemState State = EItemState::Pending;
+		FString ErrorCode;
+
+		/* Keeps loaded asset from garbage collection until it is exported. */
+		TStrongObjectPtr<UObject> Asset;
+
+		double LoadStartTime = 0;
+		double LoadSeconds = 0;
+		double ExportSeconds = 0;
+	};
+
+	/* One file read ahead in blocks. Read bytes are dropped, only one block per file is in memory. */
+	struct FPrefetch
+	{
+		TUniquePtr<IAsyncReadFileHandle> Handle;
+		IAsyncReadRequest* Request = nullptr;
+		int64 Offset = 0;
+		int64 Size = 0;
+	};
+
+	/* Matching files under InputFolder, sorted by path. Returns false if folder doesn't exist. */
+	bool FindItems(const FString& InputFolder, const FString& OutputFolder, const FString& Pattern, const TArray<FString>& Extensions, FString& ErrorCode);
+
+	/* Requests loads while limits allow. One item is always in flight, so a package above the byte limit still converts. */
+	void StartLoads();
+
+	/* Starts read ahead of items which are next to be loaded. */
+	void StartPrefetches();
+
+	/* Issues next block of every prefetch whose last block is done. Waits for all blocks if bWait is set, at the end of conversion. */
+	void PollPrefetches(bool bWait);
+
+	/* Game thread, called by async loading. */
+	void OnLoaded(int32 ItemIndex, UPackage* LoadedPackage, bool bIsLoaded);
+
+	/* Exports a loaded item and releases it. */
+	void Export(int32 ItemIndex);
+
+	bool ExportWorld(UWorld* World, const FString& ExportPath, FString& ErrorCode) const;
+
+	/* Item leaves the pipeline, its asset can be collected. */
+	void Release(FItem& Item, EItemState FinalState, const FString& ErrorCode);
+
+	TSharedRef<FJsonObject> MakeReport(const TMap<FString, FString>& Config, double SearchSeconds, double PipelineSeconds) const;
+
+	TArray<FItem> Items;
+
+	/* Loaded items in load order, exported oldest first. */
+	TArray<int32> LoadedItems;
+
+	TArray<FPrefetch> Prefetches;
+	int32 NextPrefetchItem = 0;
+	int64 PrefetchedBytes = 0;
+	bool bIsAsyncLoadingThreaded = false;
+
+	int32 NextItem = 0;
+	int32 InFlightCount = 0;
+	int64 InFlightBytes = 0;
+	int32 PeakInFlightCount = 0;
+	int64 PeakInFlightBytes = 0;
+	int32 ExportsSinceCollect = 0;
+
+	int32 MaxInFlight = 4;
+	int64 MaxInFlightBytes = 2048LL * 1024LL * 1024LL;
+	bool bEnableQuantization = false;
+};
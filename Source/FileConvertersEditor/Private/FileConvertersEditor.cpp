@@ -0,0 +1,6 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Commandlets only, module has no startup work.
+IMPLEMENT_MODULE(FDefaultModuleImpl, FileConvertersEditor)